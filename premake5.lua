@@ -4,11 +4,49 @@ PROJECT_DIR = "%{wks.location}/%{prj.name}"
 OUTPUT_DIR = "%{cfg.buildcfg}-%{cfg.system}-%{cfg.architecture}"
 BUILD_DIR = "premake-build"
 
+newoption({
+    trigger = "memory-tracking",
+    description = "Record every allocation made through operator new using cbtMemoryTracker."
+})
+
+newoption({
+    trigger = "egl",
+    description = "Support rendering headless, without a window or display, using EGL."
+})
+
+newoption({
+    trigger = "entity-64bit",
+    description = "Use 64bit entity handles, so that a scene can hold more than 65536 entities."
+})
+
+newoption({
+    trigger = "entity-index-bits",
+    value = "BITS",
+    description = "The number of bits of an entity handle which store its index. Defaults to half of the handle."
+})
+
+newoption({
+    trigger = "log-level",
+    value = "LEVEL",
+    description = "Log messages with a lower priority are compiled out.",
+    default = "VERBOSE",
+    allowed = {
+        {"VERBOSE", "Verbose"},
+        {"DEBUG", "Debug"},
+        {"INFO", "Info"},
+        {"WARN", "Warn"},
+        {"ERROR", "Error"},
+        {"CRITICAL", "Critical"},
+        {"NONE", "None"},
+    }
+})
+
 workspace("cbtEngine")
     location(WORKSPACE_DIR)
     architecture("x86_64")
     configurations({"Debug", "Release"})
     startproject("cbtGame")
+    cppdialect "C++17"
 
     filter("configurations:Debug")
         defines("CBT_DEBUG")
@@ -30,6 +68,25 @@ workspace("cbtEngine")
         defines({"CBT_PLATFORM_LINUX"})
     filter({})
 
+    filter("options:memory-tracking")
+        defines({"CBT_MEMORY_TRACKING"})
+    filter({})
+
+    filter("options:egl")
+        defines({"CBT_EGL"})
+        links({"EGL"})
+    filter({})
+
+    filter("options:entity-64bit")
+        defines({"CBT_ENTITY_64BIT"})
+    filter({})
+
+    if _OPTIONS["entity-index-bits"] then
+        defines({"CBT_ENTITY_INDEX_BITS=" .. _OPTIONS["entity-index-bits"]})
+    end
+
+    defines({"CBT_LOG_LEVEL=CBT_LOG_LEVEL_" .. _OPTIONS["log-level"]})
+
 project("cbtCore")
     location(PROJECT_DIR)
     language("C++")
@@ -83,3 +140,31 @@ project("cbtGame")
         SRC_DIR .. "/%{prj.name}",
         SRC_DIR .. "/cbtCore"
     })
+
+project("cbtBench")
+    location(PROJECT_DIR)
+    language("C++")
+    kind("ConsoleApp")
+
+    targetdir(BUILD_DIR .. "/bin/" .. OUTPUT_DIR .. "/%{prj.name}")
+    objdir(BUILD_DIR .. "/bin-int/" .. OUTPUT_DIR .. "/%{prj.name}")
+
+    files({
+        SRC_DIR .. "/%{prj.name}/**.h",
+        SRC_DIR .. "/%{prj.name}/**.c",
+        SRC_DIR .. "/%{prj.name}/**.hpp",
+        SRC_DIR .. "/%{prj.name}/**.cpp",
+    })
+
+    links({
+        "GL",
+        "GLEW",
+        "SDL2",
+        "SDL2_image",
+        "cbtCore",
+    })
+
+    includedirs({
+        SRC_DIR .. "/%{prj.name}",
+        SRC_DIR .. "/cbtCore"
+    })
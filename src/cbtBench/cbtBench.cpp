@@ -0,0 +1,238 @@
+// Include cbtBench
+#include "cbtBench.h"
+
+// Include STD
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+static cbtStr s_AssetDirectory = "./../assets/";
+/// The name of the benchmark currently being run, reported with its failed checks.
+static cbtStr s_CurrentBenchmark;
+/// The number of checks of the current benchmark which have failed. Only the first is reported, since checks are usually repeated every iteration.
+static cbtU32 s_CurrentFailedCheckCount = 0;
+static cbtU32 s_FailedCheckCount = 0;
+
+/**
+    \brief Get the current time in nanoseconds.
+
+    \return The current time in nanoseconds.
+*/
+static cbtU64 GetTimestamp()
+{
+    return static_cast<cbtU64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+    \brief Convert a number of nanoseconds to a string with 1 decimal place.
+
+    \param _nanoseconds The number of nanoseconds.
+
+    \return The number as a string.
+*/
+static cbtStr NanosecondsToString(cbtF64 _nanoseconds)
+{
+    cbtS8 buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%.1f", _nanoseconds);
+    return buffer;
+}
+
+/**
+    \brief Escape a string so that it can be written between quotes in a JSON file.
+
+    \param _string The string to escape.
+
+    \return The escaped string.
+*/
+static cbtStr EscapeJSON(const cbtStr& _string)
+{
+    cbtStr escaped;
+    for (cbtU32 i = 0; i < _string.size(); ++i)
+    {
+        if (_string[i] == '"' || _string[i] == '\\')
+        { escaped += '\\'; }
+        escaped += _string[i];
+    }
+    return escaped;
+}
+
+std::vector<cbtBenchmark>& cbtBench::GetBenchmarks()
+{
+    static std::vector<cbtBenchmark> benchmarks;
+    return benchmarks;
+}
+
+void cbtBench::Register(const cbtBenchmark& _benchmark)
+{
+    GetBenchmarks().push_back(_benchmark);
+}
+
+cbtBool cbtBench::Check(cbtBool _condition, const cbtS8* _message)
+{
+    if (!_condition)
+    {
+        if (s_CurrentFailedCheckCount++ == 0)
+        { std::cerr << s_CurrentBenchmark << ": check failed (" << _message << ")" << std::endl; }
+        ++s_FailedCheckCount;
+    }
+    return _condition;
+}
+
+cbtU32 cbtBench::GetFailedCheckCount()
+{
+    return s_FailedCheckCount;
+}
+
+const cbtStr& cbtBench::GetAssetDirectory()
+{
+    return s_AssetDirectory;
+}
+
+void cbtBench::SetAssetDirectory(const cbtStr& _directory)
+{
+    s_AssetDirectory = _directory;
+    if (!s_AssetDirectory.empty() && s_AssetDirectory.back() != '/')
+    { s_AssetDirectory += '/'; }
+}
+
+cbtBenchResult cbtBench::RunBenchmark(const cbtBenchmark& _benchmark, cbtF64 _minTime)
+{
+    cbtBenchResult result;
+    result.m_Name = _benchmark.m_Name;
+    result.m_ItemCount = _benchmark.m_ItemCount;
+
+    if (_benchmark.m_Begin)
+    { _benchmark.m_Begin(); }
+
+    // Time a sample of _batch iterations, excluding setup and teardown.
+    const cbtBool batched = !_benchmark.m_Setup && !_benchmark.m_Teardown;
+    auto sample = [&_benchmark](cbtU64 _batch) -> cbtU64
+    {
+        if (_benchmark.m_Setup)
+        { _benchmark.m_Setup(); }
+        cbtU64 begin = GetTimestamp();
+        for (cbtU64 i = 0; i < _batch; ++i)
+        { _benchmark.m_Run(); }
+        cbtU64 end = GetTimestamp();
+        if (_benchmark.m_Teardown)
+        { _benchmark.m_Teardown(); }
+        return end - begin;
+    };
+
+    // Warm up, and find a batch size which makes each sample long enough to time accurately.
+    cbtU64 batch = 1;
+    cbtU64 warmupTime = sample(batch);
+    while (batched && warmupTime < MIN_BATCH_NS)
+    {
+        batch *= 2;
+        warmupTime = sample(batch);
+    }
+
+    const cbtU64 minTime = static_cast<cbtU64>(_minTime * 1000000000.0);
+    const cbtU64 maxTime = minTime * 10;
+    std::vector<cbtF64> samples;
+    cbtU64 totalTime = 0;
+    while (samples.size() < MAX_SAMPLES)
+    {
+        cbtU64 sampleTime = sample(batch);
+        samples.push_back(static_cast<cbtF64>(sampleTime) / static_cast<cbtF64>(batch));
+        totalTime += sampleTime;
+        result.m_Iterations += batch;
+
+        if ((samples.size() >= MIN_SAMPLES && totalTime >= minTime) || totalTime >= maxTime)
+        { break; }
+    }
+
+    if (_benchmark.m_End)
+    { _benchmark.m_End(); }
+
+    std::sort(samples.begin(), samples.end());
+    cbtF64 sum = 0.0;
+    for (cbtU32 i = 0; i < samples.size(); ++i)
+    { sum += samples[i]; }
+
+    // Use the nearest-rank method for percentiles.
+    auto percentile = [&samples](cbtF64 _percent) -> cbtF64
+    {
+        cbtU32 rank = static_cast<cbtU32>(_percent / 100.0 * static_cast<cbtF64>(samples.size()) + 0.5);
+        return samples[std::clamp<cbtU32>(rank, 1, (cbtU32)samples.size()) - 1];
+    };
+
+    result.m_Samples = (cbtU32)samples.size();
+    result.m_MedianNS = percentile(50.0);
+    result.m_P95NS = percentile(95.0);
+    result.m_MinNS = samples.front();
+    result.m_MeanNS = sum / static_cast<cbtF64>(samples.size());
+    return result;
+}
+
+std::vector<cbtBenchResult> cbtBench::RunAll(const cbtStr& _filter, cbtF64 _minTime)
+{
+    std::vector<cbtBenchResult> results;
+    const std::vector<cbtBenchmark>& benchmarks = GetBenchmarks();
+    for (cbtU32 i = 0; i < benchmarks.size(); ++i)
+    {
+        const cbtBenchmark& benchmark = benchmarks[i];
+        if (!_filter.empty() && benchmark.m_Name.find(_filter) == cbtStr::npos)
+        { continue; }
+
+        // Progress is written to stderr so that stdout only contains the JSON.
+        if (!benchmark.m_SkipReason.empty())
+        {
+            cbtBenchResult result;
+            result.m_Name = benchmark.m_Name;
+            result.m_ItemCount = benchmark.m_ItemCount;
+            result.m_SkipReason = benchmark.m_SkipReason;
+            results.push_back(result);
+            std::cerr << benchmark.m_Name << ": skipped (" << benchmark.m_SkipReason << ")" << std::endl;
+            continue;
+        }
+
+        s_CurrentBenchmark = benchmark.m_Name;
+        s_CurrentFailedCheckCount = 0;
+        cbtBenchResult result = RunBenchmark(benchmark, _minTime);
+        results.push_back(result);
+        std::cerr << result.m_Name << ": median " << NanosecondsToString(result.m_MedianNS) << "ns, p95 "
+                  << NanosecondsToString(result.m_P95NS) << "ns, " << result.m_Iterations << " iterations" << std::endl;
+    }
+    return results;
+}
+
+cbtStr cbtBench::ToJSON(const std::vector<cbtBenchResult>& _results)
+{
+    cbtStr json = "{\n";
+    json += "    \"suite\": \"cbtBench\",\n";
+    json += "    \"benchmarks\": [";
+    for (cbtU32 i = 0; i < _results.size(); ++i)
+    {
+        const cbtBenchResult& result = _results[i];
+        json += (i == 0) ? "\n" : ",\n";
+        json += "        {\n";
+        json += "            \"name\": \"" + EscapeJSON(result.m_Name) + "\",\n";
+        json += "            \"items_per_iteration\": " + CBT_TO_STRING(result.m_ItemCount) + ",\n";
+        if (!result.m_SkipReason.empty())
+        {
+            json += "            \"skipped\": true,\n";
+            json += "            \"reason\": \"" + EscapeJSON(result.m_SkipReason) + "\"\n";
+        }
+        else
+        {
+            cbtF64 itemsPerSecond = (result.m_MedianNS > 0.0) ?
+                                    static_cast<cbtF64>(result.m_ItemCount) * 1000000000.0 / result.m_MedianNS : 0.0;
+            json += "            \"skipped\": false,\n";
+            json += "            \"iterations\": " + CBT_TO_STRING(result.m_Iterations) + ",\n";
+            json += "            \"samples\": " + CBT_TO_STRING(result.m_Samples) + ",\n";
+            json += "            \"median_ns\": " + NanosecondsToString(result.m_MedianNS) + ",\n";
+            json += "            \"p95_ns\": " + NanosecondsToString(result.m_P95NS) + ",\n";
+            json += "            \"min_ns\": " + NanosecondsToString(result.m_MinNS) + ",\n";
+            json += "            \"mean_ns\": " + NanosecondsToString(result.m_MeanNS) + ",\n";
+            json += "            \"items_per_second\": " + NanosecondsToString(itemsPerSecond) + "\n";
+        }
+        json += "        }";
+    }
+    json += _results.empty() ? "]\n" : "\n    ]\n";
+    json += "}\n";
+    return json;
+}
\ No newline at end of file
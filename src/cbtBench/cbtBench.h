@@ -0,0 +1,174 @@
+#pragma once
+
+// Include CBT
+#include "cbtMacros.h"
+
+// Include STD
+#include <functional>
+#include <vector>
+
+USING_NS_CBT;
+
+/**
+    \brief
+        A benchmark. m_Run is timed repeatedly, and the other functions are not timed.
+        If m_Setup or m_Teardown is set, they are called around every iteration of m_Run, and each sample is a single iteration.
+        Otherwise, iterations are batched so that each sample is long enough to be timed accurately.
+*/
+struct cbtBenchmark
+{
+    /// The name of the benchmark, in the form "Group/Case".
+    cbtStr m_Name;
+    /// The number of items processed per iteration, used to report throughput.
+    cbtU64 m_ItemCount = 1;
+    /// If not empty, the benchmark is not run, and this is reported as the reason.
+    cbtStr m_SkipReason;
+
+    /// Called once before the benchmark is sampled.
+    std::function<void(void)> m_Begin;
+    /// Called before every iteration.
+    std::function<void(void)> m_Setup;
+    /// The code being benchmarked.
+    std::function<void(void)> m_Run;
+    /// Called after every iteration.
+    std::function<void(void)> m_Teardown;
+    /// Called once after the benchmark has been sampled.
+    std::function<void(void)> m_End;
+};
+
+/// The timings of a benchmark. All times are per iteration, in nanoseconds.
+struct cbtBenchResult
+{
+    cbtStr m_Name;
+    cbtStr m_SkipReason;
+    cbtU64 m_ItemCount = 1;
+    /// The total number of timed iterations.
+    cbtU64 m_Iterations = 0;
+    /// The number of samples the statistics are computed from.
+    cbtU32 m_Samples = 0;
+    cbtF64 m_MedianNS = 0.0;
+    cbtF64 m_P95NS = 0.0;
+    cbtF64 m_MinNS = 0.0;
+    cbtF64 m_MeanNS = 0.0;
+};
+
+/**
+    \brief Runs the registered benchmarks and reports their timings as JSON.
+*/
+class cbtBench
+{
+public:
+    /// The minimum number of samples taken of each benchmark.
+    static constexpr cbtU32 MIN_SAMPLES = 20;
+    /// The maximum number of samples taken of each benchmark.
+    static constexpr cbtU32 MAX_SAMPLES = 10000;
+    /// The minimum duration of a batched sample, in nanoseconds.
+    static constexpr cbtU64 MIN_BATCH_NS = 1000000;
+
+private:
+    /**
+        \brief Private Constructor. All functions should be static. No objects of this class should be created.
+    */
+    cbtBench()
+    {
+    }
+
+    /**
+        \brief Private Destructor. All functions should be static. No objects of this class should be created.
+    */
+    ~cbtBench()
+    {
+    }
+
+    static std::vector<cbtBenchmark>& GetBenchmarks();
+
+    static cbtBenchResult RunBenchmark(const cbtBenchmark& _benchmark, cbtF64 _minTime);
+
+public:
+    /**
+        \brief Register a benchmark to be run by RunAll().
+
+        \param _benchmark The benchmark.
+    */
+    static void Register(const cbtBenchmark& _benchmark);
+
+    /**
+        \brief
+            Run every registered benchmark whose name contains _filter.
+            Each benchmark is sampled until it has been sampled MIN_SAMPLES times and for at least _minTime seconds,
+            or until it has been sampled for 10 times _minTime seconds.
+
+        \param _filter Only benchmarks whose names contain this are run. Every benchmark is run if empty.
+        \param _minTime The minimum time to sample each benchmark for, in seconds.
+
+        \return The results of the benchmarks, in the order they were registered.
+    */
+    static std::vector<cbtBenchResult> RunAll(const cbtStr& _filter, cbtF64 _minTime);
+
+    /**
+        \brief Convert the results of RunAll() to JSON.
+
+        \param _results The results.
+
+        \return The results as a JSON string.
+    */
+    static cbtStr ToJSON(const std::vector<cbtBenchResult>& _results);
+
+    /**
+        \brief
+            Check a result computed by a benchmark, reporting the check if it fails.
+            A benchmark which computes the wrong result is not measuring the right thing, so cbtBench exits with a non-zero status if any check fails.
+
+        \param _condition True if the result is correct.
+        \param _message A description of the check.
+
+        \return _condition, so that a benchmark can stop checking a result once a check has failed.
+    */
+    static cbtBool Check(cbtBool _condition, const cbtS8* _message);
+
+    /**
+        \brief Get the number of checks which have failed.
+
+        \return The number of checks which have failed.
+    */
+    static cbtU32 GetFailedCheckCount();
+
+    /**
+        \brief Get the directory the benchmarks load assets from, ending with a '/'.
+
+        \return The directory the benchmarks load assets from.
+    */
+    static const cbtStr& GetAssetDirectory();
+
+    /**
+        \brief Set the directory the benchmarks load assets from. Defaults to "./../assets/".
+
+        \param _directory The directory the benchmarks load assets from.
+    */
+    static void SetAssetDirectory(const cbtStr& _directory);
+
+    /**
+        \brief Prevent the compiler from optimising away the computation of a value.
+
+        \param _value The value.
+    */
+    template<typename T>
+    inline static void DoNotOptimise(const T& _value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(_value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &_value;
+#endif
+    }
+
+    // Benchmark Registration
+    static void RegisterCoreBenchmarks();
+
+    static void RegisterECSBenchmarks();
+
+    static void RegisterMathBenchmarks();
+
+    static void RegisterRendererBenchmarks();
+};
\ No newline at end of file
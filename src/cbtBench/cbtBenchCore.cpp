@@ -0,0 +1,64 @@
+// Include cbtBench
+#include "cbtBench.h"
+
+// Include CBT
+#include "Core/CommandQueue/cbtCommandQueue.h"
+#include "Core/General/cbtRef.h"
+
+/// The number of commands queued, or objects created, per iteration.
+static const cbtU32 s_BatchSize = 10000;
+
+/// The command queue used by the command queue benchmark.
+static cbtCommandQueue* s_CommandQueue = nullptr;
+
+/**
+    \brief The smallest possible managed object, to benchmark the overhead of the release pool.
+*/
+class cbtBenchManaged : public cbtManaged
+{
+protected:
+    virtual ~cbtBenchManaged()
+    {
+    }
+
+public:
+    cbtBenchManaged()
+    {
+    }
+};
+
+void cbtBench::RegisterCoreBenchmarks()
+{
+    // Queuing commands, then executing them. This is how the asset loader hands work to the main thread.
+    cbtBenchmark commandQueue;
+    commandQueue.m_Name = "Core/CommandQueue/" + CBT_TO_STRING(s_BatchSize);
+    commandQueue.m_ItemCount = s_BatchSize;
+    // The command queue is too large to be created on the stack.
+    commandQueue.m_Begin = []() { s_CommandQueue = cbtNew cbtCommandQueue(); };
+    commandQueue.m_Run = []()
+    {
+        cbtU32 counter = 0;
+        for (cbtU32 i = 0; i < s_BatchSize; ++i)
+        { s_CommandQueue->QueueCommand([&counter]() { ++counter; }); }
+        s_CommandQueue->ExecuteCommmands();
+        cbtBench::DoNotOptimise(counter);
+    };
+    commandQueue.m_End = []()
+    {
+        delete s_CommandQueue;
+        s_CommandQueue = nullptr;
+    };
+    cbtBench::Register(commandQueue);
+
+    // Creating managed objects, which are added to the release pool, then clearing the pool to delete them.
+    cbtBenchmark releasePool;
+    releasePool.m_Name = "Core/ReleasePoolChurn/" + CBT_TO_STRING(s_BatchSize);
+    releasePool.m_ItemCount = s_BatchSize;
+    releasePool.m_Run = []()
+    {
+        for (cbtU32 i = 0; i < s_BatchSize; ++i)
+        { cbtNew cbtBenchManaged(); }
+        cbtManaged::ClearReleasePool();
+    };
+    cbtBench::Register(releasePool);
+}
\ No newline at end of file
@@ -0,0 +1,464 @@
+// Include cbtBench
+#include "cbtBench.h"
+
+// Include CBT
+#include "Game/Scene/cbtScene.h"
+#include "Game/Scene/cbtEntityCommandBuffer.h"
+#include "Game/Component/Transform/cbtTransform.h"
+
+/**
+    \brief A small component, to benchmark component groups with more than one type.
+*/
+class cbtBenchVelocity : public cbtComponent
+{
+public:
+    cbtVector3F m_Velocity;
+
+    cbtBenchVelocity()
+            :m_Velocity(1.0f, 0.0f, 0.0f)
+    {
+    }
+
+protected:
+    virtual ~cbtBenchVelocity()
+    {
+    }
+};
+
+NS_CBT_BEGIN
+
+    CBT_DEFINE_FLAGS(cbtBenchVelocity, CBT_COMPONENT_FLAG_NONE);
+
+NS_CBT_END
+
+/// The entity counts to benchmark. Counts beyond the capacity of cbtEntityPool are reported as skipped.
+static const cbtU32 s_EntityCounts[] = { 1000, 10000, 100000, 1000000 };
+/// The number of transforms in each chain of the transform hierarchy benchmark.
+static const cbtU32 s_HierarchyDepth = 8;
+
+/// The number of command buffers the entity command buffer benchmark records into, as if by that many threads.
+static const cbtU32 s_CommandBufferCount = 4;
+
+/// The scene used by the benchmark currently being run.
+static cbtScene* s_Scene = nullptr;
+/// The entities in s_Scene.
+static std::vector<cbtECS> s_Entities;
+
+static cbtEntityCommandBuffer s_CommandBuffers[s_CommandBufferCount];
+/// The entities created by each command buffer to replace the entities it removed.
+static std::vector<cbtDeferredEntity> s_ReplacementEntities[s_CommandBufferCount];
+/// The entities created by each command buffer which have no components once it has been played back.
+static std::vector<cbtDeferredEntity> s_BareEntities[s_CommandBufferCount];
+
+/**
+    \brief Get the maximum number of entities a scene can hold, which is limited by the number of bits in the index of a cbtECS.
+
+    \return The maximum number of entities a scene can hold.
+*/
+static cbtU64 GetEntityCapacity()
+{
+    return CBT_MAX_ENTITY_COUNT;
+}
+
+static void CreateScene()
+{
+    s_Scene = cbtNew cbtScene();
+    s_Scene->Retain();
+    cbtManaged::ClearReleasePool();
+}
+
+static void DestroyScene()
+{
+    s_Entities.clear();
+    s_Scene->Release();
+    s_Scene = nullptr;
+    cbtManaged::ClearReleasePool();
+}
+
+/**
+    \brief Create entities with a cbtTransform, and every other one with a cbtBenchVelocity, in s_Scene.
+
+    \param _entityCount The number of entities to create.
+*/
+static void PopulateScene(cbtU32 _entityCount)
+{
+    s_Entities.resize(_entityCount);
+    for (cbtU32 i = 0; i < _entityCount; ++i)
+    {
+        s_Entities[i] = s_Scene->AddEntity();
+        s_Scene->AddComponent<cbtTransform>(s_Entities[i])->SetLocalPosition(cbtVector3F((cbtF32)i, 0.0f, 0.0f));
+        if ((i & 1) == 0)
+        { s_Scene->AddComponent<cbtBenchVelocity>(s_Entities[i]); }
+    }
+}
+
+/**
+    \brief Create the same entities and components as PopulateScene, using the bulk creation functions of cbtScene.
+
+    \param _entityCount The number of entities to create.
+*/
+static void PopulateSceneBulk(cbtU32 _entityCount)
+{
+    s_Entities.resize(_entityCount);
+    s_Scene->AddEntities(_entityCount, s_Entities.data());
+    s_Scene->AddComponents<cbtTransform>(s_Entities.data(), _entityCount, [](cbtTransform* _transform, cbtU32 _index)
+    {
+        _transform->SetLocalPosition(cbtVector3F((cbtF32)_index, 0.0f, 0.0f));
+    });
+    std::vector<cbtECS> evenEntities;
+    evenEntities.reserve((_entityCount + 1) / 2);
+    for (cbtU32 i = 0; i < _entityCount; i += 2)
+    { evenEntities.push_back(s_Entities[i]); }
+    s_Scene->AddComponents<cbtBenchVelocity>(evenEntities.data(), (cbtU32)evenEntities.size());
+}
+
+/**
+    \brief Get the x position of an entity's transform, which PopulateScene sets to the index of the entity.
+
+    \param _transform The transform.
+
+    \return The x position of the transform.
+*/
+static cbtU32 GetTransformIndex(const cbtTransform* _transform)
+{
+    return (cbtU32)_transform->GetLocalPosition().m_X;
+}
+
+/**
+    \brief
+        Check that the transforms of s_Scene were sorted from the last entity to the first, and its velocities sorted as its transforms.
+        Every entity must still find its own components, and a component group of both types must join the same entities in the sorted order.
+*/
+static void CheckSortedScene()
+{
+    const cbtU32 entityCount = (cbtU32)s_Entities.size();
+    if (!cbtBench::Check(s_Scene->GetComponentCount<cbtTransform>() == entityCount, "every entity has a transform") ||
+        !cbtBench::Check(s_Scene->GetComponentCount<cbtBenchVelocity>() == (entityCount + 1) / 2, "every other entity has a velocity"))
+    { return; }
+
+    cbtTransform** transforms = s_Scene->GetComponentArray<cbtTransform>();
+    for (cbtU32 i = 0; i < entityCount; ++i)
+    {
+        if (!cbtBench::Check(GetTransformIndex(transforms[i]) == entityCount - 1 - i, "transforms are in sorted order"))
+        { return; }
+    }
+
+    for (cbtU32 i = 0; i < entityCount; ++i)
+    {
+        const cbtTransform* transform = s_Scene->GetComponent<cbtTransform>(s_Entities[i]);
+        if (!cbtBench::Check(transform->GetEntity() == s_Entities[i] && GetTransformIndex(transform) == i, "GetComponent finds an entity's transform after sorting"))
+        { return; }
+        if ((i & 1) == 0 &&
+            !cbtBench::Check(s_Scene->GetComponent<cbtBenchVelocity>(s_Entities[i])->GetEntity() == s_Entities[i], "GetComponent finds an entity's velocity after sorting"))
+        { return; }
+    }
+
+    cbtComponentGroup<cbtBenchVelocity, cbtTransform> componentGroup;
+    s_Scene->GetComponentGroup(componentGroup);
+    if (!cbtBench::Check(componentGroup.GetArraySize() == (entityCount + 1) / 2, "the component group has every entity with a velocity"))
+    { return; }
+    cbtBenchVelocity** groupVelocities = componentGroup.GetArray<cbtBenchVelocity>();
+    cbtTransform** groupTransforms = componentGroup.GetArray<cbtTransform>();
+    // The even entities, from the last to the first.
+    cbtU32 expectedIndex = (entityCount - 1) & ~1u;
+    for (cbtU32 i = 0; i < componentGroup.GetArraySize(); ++i, expectedIndex -= 2)
+    {
+        if (!cbtBench::Check(groupVelocities[i]->GetEntity() == groupTransforms[i]->GetEntity(), "the component group joins the components of the same entity") ||
+            !cbtBench::Check(GetTransformIndex(groupTransforms[i]) == expectedIndex, "the component group is in sorted order"))
+        { return; }
+    }
+}
+
+/**
+    \brief
+        Record changes to every entity of s_Scene into s_CommandBuffers, then play them back.
+        The entities are split between the buffers in groups of 4. Of each group:
+        the 1st entity is removed and replaced by a new entity, which a velocity is added to twice;
+        the 2nd entity is given a velocity by two buffers, and the 3rd has its velocity removed by two buffers, so one of each pair is dropped;
+        the 4th entity has a velocity it does not have removed, and a new entity is created which has its transform removed, and another which is removed before a velocity is added to it.
+        The component changes to removed entities must be skipped.
+*/
+static void RecordAndPlaybackCommands()
+{
+    for (cbtU32 i = 0; i < s_CommandBufferCount; ++i)
+    {
+        s_ReplacementEntities[i].clear();
+        s_BareEntities[i].clear();
+    }
+
+    for (cbtU32 i = 0; i < s_Entities.size(); ++i)
+    {
+        cbtU32 bufferIndex = (i / 4) % s_CommandBufferCount;
+        cbtEntityCommandBuffer& buffer = s_CommandBuffers[bufferIndex];
+        cbtEntityCommandBuffer& nextBuffer = s_CommandBuffers[(bufferIndex + 1) % s_CommandBufferCount];
+        cbtECS entity = s_Entities[i];
+        switch (i % 4)
+        {
+            case 0:
+            {
+                buffer.RemoveEntity(entity);
+                buffer.AddComponent<cbtBenchVelocity>(entity);
+                cbtDeferredEntity replacement = buffer.AddEntity();
+                buffer.AddComponent<cbtTransform>(replacement);
+                buffer.AddComponent<cbtBenchVelocity>(replacement);
+                buffer.AddComponent<cbtBenchVelocity>(replacement);
+                s_ReplacementEntities[bufferIndex].push_back(replacement);
+                break;
+            }
+            case 1:
+                buffer.AddComponent<cbtBenchVelocity>(entity);
+                nextBuffer.AddComponent<cbtBenchVelocity>(entity);
+                break;
+            case 2:
+                buffer.RemoveComponent<cbtBenchVelocity>(entity);
+                nextBuffer.RemoveComponent<cbtBenchVelocity>(entity);
+                break;
+            default:
+            {
+                buffer.RemoveComponent<cbtBenchVelocity>(entity);
+                cbtDeferredEntity bare = buffer.AddEntity();
+                buffer.AddComponent<cbtTransform>(bare);
+                buffer.RemoveComponent<cbtTransform>(bare);
+                s_BareEntities[bufferIndex].push_back(bare);
+                cbtDeferredEntity removed = buffer.AddEntity();
+                buffer.RemoveEntity(removed);
+                buffer.AddComponent<cbtBenchVelocity>(removed);
+                break;
+            }
+        }
+    }
+
+    cbtEntityCommandBuffer* buffers[s_CommandBufferCount];
+    for (cbtU32 i = 0; i < s_CommandBufferCount; ++i)
+    { buffers[i] = &s_CommandBuffers[i]; }
+    cbtEntityCommandBuffer::Playback(*s_Scene, buffers, s_CommandBufferCount);
+}
+
+/**
+    \brief Check that s_Scene has the entities and components RecordAndPlaybackCommands should have left it with.
+*/
+static void CheckCommandBufferPlayback()
+{
+    // The number of entities in each position of the groups of 4.
+    const cbtU32 entityCount = (cbtU32)s_Entities.size();
+    const cbtU32 removedCount = (entityCount + 3) / 4;
+    const cbtU32 addedVelocityCount = (entityCount + 2) / 4;
+    const cbtU32 bareCount = entityCount / 4;
+    if (!cbtBench::Check(s_Scene->GetEntityCount() == entityCount + bareCount, "the scene has the expected number of entities") ||
+        !cbtBench::Check(s_Scene->GetComponentCount<cbtTransform>() == entityCount, "the scene has the expected number of transforms") ||
+        !cbtBench::Check(s_Scene->GetComponentCount<cbtBenchVelocity>() == removedCount + addedVelocityCount, "the scene has the expected number of velocities"))
+    { return; }
+
+    for (cbtU32 i = 0; i < entityCount; ++i)
+    {
+        cbtECS entity = s_Entities[i];
+        cbtBool correct = false;
+        switch (i % 4)
+        {
+            case 0:
+                correct = !s_Scene->HasEntity(entity);
+                break;
+            case 1:
+                correct = s_Scene->HasEntity(entity) && s_Scene->HasComponent<cbtBenchVelocity>(entity);
+                break;
+            default:
+                correct = s_Scene->HasEntity(entity) && s_Scene->HasComponent<cbtTransform>(entity) && !s_Scene->HasComponent<cbtBenchVelocity>(entity);
+                break;
+        }
+        if (!cbtBench::Check(correct, "an existing entity has the expected components"))
+        { return; }
+    }
+
+    for (cbtU32 i = 0; i < s_CommandBufferCount; ++i)
+    {
+        for (cbtDeferredEntity replacement : s_ReplacementEntities[i])
+        {
+            cbtECS entity = s_CommandBuffers[i].GetCreatedEntity(replacement);
+            if (!cbtBench::Check(s_Scene->HasEntity(entity) && s_Scene->HasComponent<cbtTransform>(entity) && s_Scene->HasComponent<cbtBenchVelocity>(entity),
+                                 "a created entity has the expected components"))
+            { return; }
+        }
+        for (cbtDeferredEntity bare : s_BareEntities[i])
+        {
+            cbtECS entity = s_CommandBuffers[i].GetCreatedEntity(bare);
+            if (!cbtBench::Check(s_Scene->HasEntity(entity) && !s_Scene->HasComponent<cbtTransform>(entity), "a created entity has its transform removed"))
+            { return; }
+        }
+    }
+}
+
+/**
+    \brief Register a benchmark, or a skipped benchmark if the scene cannot hold _entityCount entities.
+
+    \param _benchmark The benchmark.
+    \param _entityCount The number of entities the benchmark creates.
+*/
+static void RegisterSceneBenchmark(cbtBenchmark _benchmark, cbtU32 _entityCount)
+{
+    if (_entityCount > GetEntityCapacity())
+    {
+        _benchmark.m_SkipReason = "cbtEntityPool can hold at most " + CBT_TO_STRING(GetEntityCapacity()) + " entities";
+        _benchmark.m_Begin = nullptr;
+        _benchmark.m_Setup = nullptr;
+        _benchmark.m_Run = nullptr;
+        _benchmark.m_Teardown = nullptr;
+        _benchmark.m_End = nullptr;
+    }
+    cbtBench::Register(_benchmark);
+}
+
+void cbtBench::RegisterECSBenchmarks()
+{
+    for (cbtU32 entityCount : s_EntityCounts)
+    {
+        cbtStr suffix = "/" + CBT_TO_STRING(entityCount);
+
+        // Creating entities and their components, including the growth of the entity pool and sparse sets.
+        cbtBenchmark create;
+        create.m_Name = "ECS/CreateEntities" + suffix;
+        create.m_ItemCount = entityCount;
+        create.m_Setup = CreateScene;
+        create.m_Run = [entityCount]() { PopulateScene(entityCount); };
+        create.m_Teardown = DestroyScene;
+        RegisterSceneBenchmark(create, entityCount);
+
+        // The same, using AddEntities & AddComponents.
+        cbtBenchmark createBulk;
+        createBulk.m_Name = "ECS/CreateEntitiesBulk" + suffix;
+        createBulk.m_ItemCount = entityCount;
+        createBulk.m_Setup = CreateScene;
+        createBulk.m_Run = [entityCount]() { PopulateSceneBulk(entityCount); };
+        createBulk.m_Teardown = DestroyScene;
+        RegisterSceneBenchmark(createBulk, entityCount);
+
+        // Removing every entity, and the components attached to them.
+        cbtBenchmark remove;
+        remove.m_Name = "ECS/RemoveEntities" + suffix;
+        remove.m_ItemCount = entityCount;
+        remove.m_Setup = [entityCount]()
+        {
+            CreateScene();
+            PopulateScene(entityCount);
+            cbtManaged::ClearReleasePool();
+        };
+        remove.m_Run = []()
+        {
+            for (cbtU32 i = 0; i < s_Entities.size(); ++i)
+            { s_Scene->RemoveEntity(s_Entities[i]); }
+        };
+        remove.m_Teardown = DestroyScene;
+        RegisterSceneBenchmark(remove, entityCount);
+
+        // The same, using RemoveEntities.
+        cbtBenchmark removeBulk;
+        removeBulk.m_Name = "ECS/RemoveEntitiesBulk" + suffix;
+        removeBulk.m_ItemCount = entityCount;
+        removeBulk.m_Setup = remove.m_Setup;
+        removeBulk.m_Run = []() { s_Scene->RemoveEntities(s_Entities.data(), (cbtU32)s_Entities.size()); };
+        removeBulk.m_Teardown = DestroyScene;
+        RegisterSceneBenchmark(removeBulk, entityCount);
+
+        // Building a component group of the half of the entities which have both components.
+        cbtBenchmark group;
+        group.m_Name = "ECS/GetComponentGroup" + suffix;
+        group.m_ItemCount = entityCount;
+        group.m_Begin = [entityCount]()
+        {
+            CreateScene();
+            PopulateScene(entityCount);
+            cbtManaged::ClearReleasePool();
+        };
+        group.m_Run = []()
+        {
+            cbtComponentGroup<cbtBenchVelocity, cbtTransform> componentGroup;
+            s_Scene->GetComponentGroup(componentGroup);
+            cbtBench::DoNotOptimise(componentGroup.GetArraySize());
+        };
+        group.m_End = DestroyScene;
+        RegisterSceneBenchmark(group, entityCount);
+
+        // Finding the 1 in 20 transforms which changed, as systems which only process changes do every frame.
+        cbtBenchmark changed;
+        changed.m_Name = "ECS/ForEachChangedComponent" + suffix;
+        changed.m_ItemCount = entityCount;
+        changed.m_Begin = [entityCount]()
+        {
+            CreateScene();
+            PopulateScene(entityCount);
+            cbtManaged::ClearReleasePool();
+        };
+        changed.m_Run = []()
+        {
+            cbtU32 seenVersion = cbtComponent::AdvanceChangeVersion();
+            cbtTransform** transforms = s_Scene->GetComponentArray<cbtTransform>();
+            cbtU32 transformCount = s_Scene->GetComponentCount<cbtTransform>();
+            for (cbtU32 i = 0; i < transformCount; i += 20)
+            { transforms[i]->LocalTranslate(cbtVector3F(0.0f, 0.001f, 0.0f)); }
+            cbtU32 changedCount = 0;
+            s_Scene->ForEachChangedComponent<cbtTransform>(seenVersion, [&changedCount](cbtTransform*) { ++changedCount; });
+            cbtBench::DoNotOptimise(changedCount);
+        };
+        changed.m_End = DestroyScene;
+        RegisterSceneBenchmark(changed, entityCount);
+
+        // Moving the root of every chain of transforms, then computing the global model matrix of every transform.
+        cbtBenchmark hierarchy;
+        hierarchy.m_Name = "ECS/TransformHierarchy" + suffix;
+        hierarchy.m_ItemCount = entityCount;
+        hierarchy.m_Begin = [entityCount]()
+        {
+            CreateScene();
+            PopulateScene(entityCount);
+            for (cbtU32 i = 0; i < entityCount; ++i)
+            {
+                if ((i % s_HierarchyDepth) != 0)
+                { s_Scene->GetComponent<cbtTransform>(s_Entities[i])->SetParent(s_Scene->GetComponent<cbtTransform>(s_Entities[i - 1])); }
+            }
+            cbtManaged::ClearReleasePool();
+        };
+        hierarchy.m_Run = []()
+        {
+            cbtTransform** transforms = s_Scene->GetComponentArray<cbtTransform>();
+            cbtU32 transformCount = s_Scene->GetComponentCount<cbtTransform>();
+            for (cbtU32 i = 0; i < transformCount; ++i)
+            {
+                if (transforms[i]->GetParent() == nullptr)
+                { transforms[i]->SetLocalPosition(transforms[i]->GetLocalPosition() + cbtVector3F(0.0f, 0.001f, 0.0f)); }
+            }
+            for (cbtU32 i = 0; i < transformCount; ++i)
+            { cbtBench::DoNotOptimise(transforms[i]->GetGlobalModelMatrix()); }
+        };
+        hierarchy.m_End = DestroyScene;
+        RegisterSceneBenchmark(hierarchy, entityCount);
+
+        // Reversing the order of the transforms, then reordering the velocities to match, so the two can be iterated over together linearly.
+        cbtBenchmark sort;
+        sort.m_Name = "ECS/SortComponents" + suffix;
+        sort.m_ItemCount = entityCount;
+        sort.m_Setup = remove.m_Setup;
+        sort.m_Run = []()
+        {
+            s_Scene->SortComponents<cbtTransform>([](const cbtTransform* _a, const cbtTransform* _b) { return GetTransformIndex(_a) > GetTransformIndex(_b); });
+            s_Scene->SortComponentsAs<cbtBenchVelocity, cbtTransform>();
+        };
+        sort.m_Teardown = []()
+        {
+            CheckSortedScene();
+            DestroyScene();
+        };
+        RegisterSceneBenchmark(sort, entityCount);
+
+        // Recording creations and removals of entities & components into several command buffers, then playing them back.
+        cbtBenchmark commandBuffer;
+        commandBuffer.m_Name = "ECS/EntityCommandBuffer" + suffix;
+        commandBuffer.m_ItemCount = entityCount;
+        commandBuffer.m_Setup = remove.m_Setup;
+        commandBuffer.m_Run = RecordAndPlaybackCommands;
+        commandBuffer.m_Teardown = []()
+        {
+            CheckCommandBufferPlayback();
+            DestroyScene();
+        };
+        RegisterSceneBenchmark(commandBuffer, entityCount);
+    }
+}
\ No newline at end of file
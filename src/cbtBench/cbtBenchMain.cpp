@@ -0,0 +1,62 @@
+/*! \file cbtBenchMain.cpp
+    \brief
+        The entry point of cbtBench, which benchmarks the engine without creating a window or graphics context.
+        Usage: cbtBench [--filter <substring>] [--min-time <seconds>] [--assets <directory>] [--out <file>]
+        The results are written to stdout as JSON, and to <file> if --out is given.
+        Exits with a non-zero status if a benchmark computed the wrong result.
+*/
+
+// Include cbtBench
+#include "cbtBench.h"
+
+// Include CBT
+#include "Core/FileUtil/cbtFileUtil.h"
+#include "Core/General/cbtRef.h"
+
+// Include STD
+#include <cstdlib>
+#include <iostream>
+
+int main(int argc, char** argv)
+{
+    cbtStr filter;
+    cbtStr outFile;
+    cbtF64 minTime = 0.5;
+    for (cbtS32 i = 1; i < argc; ++i)
+    {
+        cbtStr arg = argv[i];
+        cbtBool hasValue = (i + 1) < argc;
+        if (arg == "--filter" && hasValue)
+        { filter = argv[++i]; }
+        else if (arg == "--out" && hasValue)
+        { outFile = argv[++i]; }
+        else if (arg == "--min-time" && hasValue)
+        { minTime = std::atof(argv[++i]); }
+        else if (arg == "--assets" && hasValue)
+        { cbtBench::SetAssetDirectory(argv[++i]); }
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--filter <substring>] [--min-time <seconds>] [--assets <directory>] [--out <file>]" << std::endl;
+            return 1;
+        }
+    }
+
+    cbtBench::RegisterCoreBenchmarks();
+    cbtBench::RegisterECSBenchmarks();
+    cbtBench::RegisterMathBenchmarks();
+    cbtBench::RegisterRendererBenchmarks();
+
+    cbtStr json = cbtBench::ToJSON(cbtBench::RunAll(filter, minTime));
+    std::cout << json;
+    if (!outFile.empty())
+    { cbtFileUtil::StringToFile(outFile, json); }
+
+    cbtManaged::ClearReleasePool();
+
+    if (cbtBench::GetFailedCheckCount() != 0)
+    {
+        std::cerr << cbtBench::GetFailedCheckCount() << " checks failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+// Include cbtBench
+#include "cbtBench.h"
+
+// Include CBT
+#include "Core/Math/cbtMatrixUtil.h"
+
+/// The number of matrices operated on per iteration. They are different, so the compiler cannot hoist the work out of the loop.
+static const cbtU32 s_MatrixCount = 64;
+
+/// The matrices operated on.
+static cbtMatrix4F s_Matrices[s_MatrixCount];
+
+void cbtBench::RegisterMathBenchmarks()
+{
+    // Create invertible matrices which are similar to the model and projection matrices used by the renderer.
+    for (cbtU32 i = 0; i < s_MatrixCount; ++i)
+    {
+        cbtF32 offset = (cbtF32)i;
+        s_Matrices[i] = cbtMatrixUtil::GetTranslationMatrix(cbtVector3F(offset, -offset, offset * 0.5f)) *
+                        cbtMatrixUtil::GetScaleMatrix(cbtVector3F(1.0f + offset, 2.0f, 0.5f + offset)) *
+                        cbtMatrixUtil::GetPerspectiveMatrix(16.0f / 9.0f, 30.0f + offset * 0.1f, 0.1f, 100.0f);
+    }
+
+    cbtBenchmark inverse;
+    inverse.m_Name = "Math/Matrix4Inverse";
+    inverse.m_ItemCount = s_MatrixCount;
+    inverse.m_Run = []()
+    {
+        for (cbtU32 i = 0; i < s_MatrixCount; ++i)
+        { cbtBench::DoNotOptimise(cbtMatrixUtil::GetInverseMatrix(s_Matrices[i])); }
+    };
+    cbtBench::Register(inverse);
+
+    cbtBenchmark multiply;
+    multiply.m_Name = "Math/Matrix4Multiply";
+    multiply.m_ItemCount = s_MatrixCount;
+    multiply.m_Run = []()
+    {
+        for (cbtU32 i = 0; i < s_MatrixCount; ++i)
+        { cbtBench::DoNotOptimise(s_Matrices[i] * s_Matrices[(i + 1) % s_MatrixCount]); }
+    };
+    cbtBench::Register(multiply);
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+// Include cbtBench
+#include "cbtBench.h"
+
+// Include CBT
+#include "Core/Math/cbtMatrixUtil.h"
+#include "Rendering/Renderer/cbtRenderer.h"
+#include "Rendering/Mesh/cbtMeshBuilder.h"
+
+// Include STD
+#include <fstream>
+#include <random>
+
+/// The object counts to benchmark.
+static const cbtU32 s_ObjectCounts[] = { 1000, 10000, 100000, 1000000 };
+
+/// The model matrices of the objects to cull.
+static std::vector<cbtMatrix4F> s_ModelMatrices;
+/// The distances and indices to sort.
+static std::vector<cbtF32> s_Distances;
+static std::vector<cbtF32> s_SortDistances;
+static std::vector<cbtU32> s_SortIndices;
+
+/**
+    \brief Get the view projection matrix of a camera at (0, 0, -50), looking down the Z axis.
+
+    \return The view projection matrix.
+*/
+static cbtMatrix4F GetViewProjectionMatrix()
+{
+    cbtMatrix4F viewMatrix = cbtMatrixUtil::GetViewMatrix(cbtVector3F::FORWARDS, cbtVector3F::UP, cbtVector3F(0.0f, 0.0f, -50.0f));
+    cbtMatrix4F projectionMatrix = cbtMatrixUtil::GetPerspectiveMatrix(16.0f / 9.0f, 45.0f, 0.1f, 100.0f);
+    return projectionMatrix * viewMatrix;
+}
+
+void cbtBench::RegisterRendererBenchmarks()
+{
+    for (cbtU32 objectCount : s_ObjectCounts)
+    {
+        cbtStr suffix = "/" + CBT_TO_STRING(objectCount);
+
+        // Culling objects scattered around the camera, roughly a third of which are visible.
+        cbtBenchmark culling;
+        culling.m_Name = "Renderer/InViewFrustum" + suffix;
+        culling.m_ItemCount = objectCount;
+        culling.m_Begin = [objectCount]()
+        {
+            std::mt19937 random(objectCount);
+            std::uniform_real_distribution<cbtF32> position(-100.0f, 100.0f);
+            s_ModelMatrices.resize(objectCount);
+            for (cbtU32 i = 0; i < objectCount; ++i)
+            { s_ModelMatrices[i] = cbtMatrixUtil::GetTranslationMatrix(cbtVector3F(position(random), position(random), position(random))); }
+        };
+        culling.m_Run = []()
+        {
+            static const cbtBoundingBox boundingBox(-0.5f, -0.5f, -0.5f, 0.5f, 0.5f, 0.5f);
+            cbtMatrix4F viewProjectionMatrix = GetViewProjectionMatrix();
+            cbtU32 visibleCount = 0;
+            for (cbtU32 i = 0; i < s_ModelMatrices.size(); ++i)
+            { visibleCount += cbtRenderer::InViewFrustum(viewProjectionMatrix, s_ModelMatrices[i], boundingBox) ? 1 : 0; }
+            cbtBench::DoNotOptimise(visibleCount);
+        };
+        culling.m_End = []() { std::vector<cbtMatrix4F>().swap(s_ModelMatrices); };
+        cbtBench::Register(culling);
+
+        // Sorting transparent objects by their distance to the camera.
+        cbtBenchmark sort;
+        sort.m_Name = "Renderer/DistanceMergeSort" + suffix;
+        sort.m_ItemCount = objectCount;
+        sort.m_Begin = [objectCount]()
+        {
+            std::mt19937 random(objectCount);
+            std::uniform_real_distribution<cbtF32> distance(0.0f, 100.0f);
+            s_Distances.resize(objectCount);
+            for (cbtU32 i = 0; i < objectCount; ++i)
+            { s_Distances[i] = distance(random); }
+        };
+        sort.m_Setup = []()
+        {
+            s_SortDistances = s_Distances;
+            s_SortIndices.resize(s_Distances.size());
+            for (cbtU32 i = 0; i < s_SortIndices.size(); ++i)
+            { s_SortIndices[i] = i; }
+        };
+        sort.m_Run = []() { cbtRenderer::DistanceMergeSort(s_SortDistances.data(), s_SortIndices.data(), (cbtU32)s_SortIndices.size()); };
+        sort.m_Teardown = []() { cbtBench::DoNotOptimise(s_SortIndices.front()); };
+        sort.m_End = []()
+        {
+            std::vector<cbtF32>().swap(s_Distances);
+            std::vector<cbtF32>().swap(s_SortDistances);
+            std::vector<cbtU32>().swap(s_SortIndices);
+        };
+        cbtBench::Register(sort);
+    }
+
+    // Parsing a large OBJ file, excluding the upload to the GPU.
+    cbtBenchmark parse;
+    parse.m_Name = "Renderer/ParseOBJ/Dragon";
+    cbtStr filePath = cbtBench::GetAssetDirectory() + "models/Demo/Dragon.obj";
+    if (!std::ifstream(filePath).good())
+    { parse.m_SkipReason = "Unable to open " + filePath; }
+    parse.m_Run = [filePath]()
+    {
+        std::vector<cbtVertex> vertices;
+        std::vector<cbtU32> indices;
+        cbtMeshBuilder::ParseOBJ(filePath, vertices, indices);
+        cbtBench::DoNotOptimise(indices.size());
+    };
+    cbtBench::Register(parse);
+}
\ No newline at end of file
@@ -1,6 +1,19 @@
 // Include CBT
 #include "cbtApplication.h"
 #include "Core/General/cbtRef.h"
+#include "Core/Memory/cbtSlabAllocator.h"
+#include "Core/Memory/cbtMemoryTracker.h"
+#include "Core/FileUtil/cbtFileUtil.h"
+#include "Rendering/Asset/cbtAssetLoader.h"
+#include "Game/Component/Transform/cbtTransform.h"
+
+// Include STD
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
 
 // SDL
 #include <SDL2/SDL.h>
@@ -12,22 +25,59 @@ NS_CBT_BEGIN
         Init();
         PostInit();
 
+        // A headless run should render the same frames every time, so wait for the scene's assets before the first frame.
+        if (m_Headless.m_Enabled)
+        { cbtAssetLoader::GetInstance()->Flush(); }
+
         // Game Loop
+        cbtProfiler::SetThreadName("Main");
         cbtU64 currentFrameTime = SDL_GetPerformanceCounter();
         cbtU64 lastFrameTime = 0;
-        while (!m_Quit)
+        cbtF32 frameStatsLogTimer = 0.0f;
+        for (cbtU32 frame = 0; !m_Quit; ++frame)
         {
             lastFrameTime = currentFrameTime;
             currentFrameTime = SDL_GetPerformanceCounter();
-            m_DeltaTime = static_cast<cbtF32>((currentFrameTime - lastFrameTime)) /
-                    static_cast<cbtF32>(SDL_GetPerformanceFrequency());
+            cbtF32 elapsedTime = static_cast<cbtF32>((currentFrameTime - lastFrameTime)) /
+                                 static_cast<cbtF32>(SDL_GetPerformanceFrequency());
+            // A headless run uses a fixed delta time, which is a whole number of fixed updates, so that every run simulates the same frames.
+            m_DeltaTime = m_Headless.m_Enabled ? m_Headless.m_DeltaTime : std::min(elapsedTime, MAX_FRAME_DELTA);
+            // A replay uses the recorded delta times, so that it simulates exactly the same frames as the recorded session.
+            m_DeltaTime = cbtInputEngine::GetInstance()->BeginFrame(m_DeltaTime);
             m_TimePassed += m_DeltaTime;
 
-            CBT_LOG_INFO(CBT_LOG_CATEGORY_APPLICATION, "FPS: %d", static_cast<cbtS32>(1.0f / m_DeltaTime));
+            // Log the frame rate once a second, rather than every frame.
+            m_FrameStats.AddFrame(elapsedTime * 1000.0f);
+            frameStatsLogTimer += elapsedTime;
+            if (frameStatsLogTimer >= 1.0f)
+            {
+                frameStatsLogTimer = 0.0f;
+                CBT_LOG_INFO(CBT_LOG_CATEGORY_APPLICATION, "FPS: %.1f, Frame Time (ms) Average: %.2f, Min: %.2f, Max: %.2f, P99: %.2f",
+                             m_FrameStats.GetFramesPerSecond(), m_FrameStats.GetAverage(), m_FrameStats.GetMin(),
+                             m_FrameStats.GetMax(), m_FrameStats.GetPercentile(99.0f));
+            }
+
+            // Changes are stamped with the frame they were made in.
+            cbtComponent::AdvanceChangeVersion();
 
             PreUpdate();
+            UpdateFixed();
             Update();
             PostUpdate();
+
+            cbtProfiler::EndFrame();
+
+            if (cbtInputEngine::GetInstance()->IsReplayFinished())
+            { Quit(); }
+
+            if (m_Headless.m_Enabled)
+            {
+                cbtF64 frameTime = static_cast<cbtF64>(SDL_GetPerformanceCounter() - currentFrameTime) * 1000.0 /
+                                   static_cast<cbtF64>(SDL_GetPerformanceFrequency());
+                RecordHeadlessFrame(frame, frameTime);
+            }
+            else if (m_TargetFrameRate > 0.0f)
+            { WaitForNextFrame(currentFrameTime); }
         }
 
         PreExit();
@@ -39,21 +89,165 @@ NS_CBT_BEGIN
         cbtGameEngine::GetInstance()->Init();
         cbtWindowProperties winProp;
         winProp.m_Title = cbtApplication::GetInstance()->GetName();
-        winProp.m_Flags |= CBT_WINDOW_BORDERLESS;
+        if (m_Headless.m_Enabled)
+        {
+            winProp.m_Width = m_Headless.m_Width;
+            winProp.m_Height = m_Headless.m_Height;
+            winProp.m_Flags |= CBT_WINDOW_HEADLESS;
+        }
+        else
+        { winProp.m_Flags |= CBT_WINDOW_BORDERLESS; }
         cbtRenderEngine::GetInstance()->Init(winProp);
         cbtInputEngine::GetInstance()->Init();
+
+        if (!m_InputReplayPath.empty())
+        { cbtInputEngine::GetInstance()->StartReplay(m_InputReplayPath); }
+        else if (!m_InputRecordPath.empty())
+        { cbtInputEngine::GetInstance()->StartRecording(); }
     }
 
     void cbtApplication::Update()
     {
-        cbtGameEngine::GetInstance()->Update();
-        cbtRenderEngine::GetInstance()->Update();
-        cbtInputEngine::GetInstance()->Update();
+        // Deliver the window events queued since the last frame, such as resizes, before anything is rendered.
+        CBT_REGION(UPDATE_EVENTS)
+            cbtRenderEngine::GetInstance()->GetWindow()->GetEventDispatcher()->DispatchQueuedEvents();
+        CBT_END_REGION(UPDATE_EVENTS)
+
+        // A scene which is replaced this frame is released when the release pool is cleared.
+        const cbtScene* previousScene = cbtGameEngine::GetInstance()->GetSceneManager()->GetActiveScene();
+        CBT_REGION(UPDATE_GAME)
+            CBT_MEMORY_TAG("Game");
+            cbtGameEngine::GetInstance()->Update();
+        CBT_END_REGION(UPDATE_GAME)
+        cbtBool sceneChanged = (cbtGameEngine::GetInstance()->GetSceneManager()->GetActiveScene() != previousScene);
+
+        CBT_REGION(UPDATE_RENDER)
+            CBT_MEMORY_TAG("Render");
+            // Render the transforms between the last two fixed updates, then restore them for the next fixed update.
+            if (m_InterpolateTransforms)
+            { InterpolateTransforms(); }
+            cbtRenderEngine::GetInstance()->Update();
+            if (m_InterpolateTransforms)
+            { RestoreTransforms(); }
+        CBT_END_REGION(UPDATE_RENDER)
+
+        CBT_REGION(UPDATE_INPUT)
+            CBT_MEMORY_TAG("Input");
+            cbtInputEngine::GetInstance()->Update();
+        CBT_END_REGION(UPDATE_INPUT)
+
         cbtManaged::ClearReleasePool();
+        // Unload the assets which only the previous scene was using, now that it has been released.
+        if (sceneChanged)
+        { cbtRenderEngine::GetInstance()->EvictUnusedAssets(); }
+        CBT_MEMORY_END_FRAME();
+    }
+
+    void cbtApplication::UpdateFixed()
+    {
+        CBT_REGION(UPDATE_FIXED)
+            CBT_MEMORY_TAG("Game");
+
+            // Without a fixed delta time, simulate the whole frame in a single update, and render it as it is.
+            if (m_FixedDeltaTime <= 0.0f)
+            {
+                if (m_InterpolateTransforms)
+                { SaveTransformStates(); }
+                FixedUpdate();
+                m_InterpolationAlpha = 1.0f;
+                return;
+            }
+
+            m_FixedTimeAccumulator += m_DeltaTime;
+            cbtU32 fixedUpdateCount = 0;
+            while (m_FixedTimeAccumulator >= m_FixedDeltaTime && fixedUpdateCount < m_MaxFixedUpdatesPerFrame)
+            {
+                if (m_InterpolateTransforms)
+                { SaveTransformStates(); }
+                FixedUpdate();
+                m_FixedTimeAccumulator -= m_FixedDeltaTime;
+                ++fixedUpdateCount;
+            }
+
+            // If the simulation cannot keep up, drop the time it is behind by rather than trying to catch up on the next frame.
+            if (m_FixedTimeAccumulator >= m_FixedDeltaTime)
+            { m_FixedTimeAccumulator = std::fmod(m_FixedTimeAccumulator, m_FixedDeltaTime); }
+
+            m_InterpolationAlpha = m_FixedTimeAccumulator / m_FixedDeltaTime;
+        CBT_END_REGION(UPDATE_FIXED)
+    }
+
+    void cbtApplication::SaveTransformStates()
+    {
+        // There is nothing to save before Init.
+        cbtSceneManager* sceneManager = cbtGameEngine::GetInstance()->GetSceneManager();
+        cbtScene* activeScene = (sceneManager != nullptr) ? sceneManager->GetActiveScene() : nullptr;
+        if (activeScene == nullptr)
+        { return; }
+
+        cbtTransform** transforms = activeScene->GetComponentArray<cbtTransform>();
+        cbtU32 transformCount = activeScene->GetComponentCount<cbtTransform>();
+        for (cbtU32 i = 0; i < transformCount; ++i)
+        { transforms[i]->SavePreviousState(); }
+        // Changes made earlier in this frame count as made after the save, which only means a few transforms are interpolated needlessly.
+        m_SavedStateVersion = cbtComponent::GetCurrentChangeVersion() - 1;
+    }
+
+    void cbtApplication::InterpolateTransforms()
+    {
+        m_InterpolatedTransforms.clear();
+        m_CurrentTransformStates.clear();
+        cbtScene* activeScene = cbtGameEngine::GetInstance()->GetSceneManager()->GetActiveScene();
+        if (activeScene == nullptr)
+        { return; }
+
+        // Transforms which have not changed since their state was saved are already where they would be interpolated to.
+        cbtTransform** transforms = activeScene->GetComponentArray<cbtTransform>();
+        cbtU32 transformCount = activeScene->GetComponentCount<cbtTransform>();
+        for (cbtU32 i = 0; i < transformCount; ++i)
+        {
+            if (!transforms[i]->HasChangedSince(m_SavedStateVersion))
+            { continue; }
+            m_InterpolatedTransforms.push_back(transforms[i]);
+            m_CurrentTransformStates.push_back(transforms[i]->GetLocalState());
+            transforms[i]->SetRenderedLocalState({}, transforms[i]->GetInterpolatedLocalState(m_InterpolationAlpha));
+        }
+    }
+
+    void cbtApplication::RestoreTransforms()
+    {
+        for (cbtU32 i = 0; i < m_InterpolatedTransforms.size(); ++i)
+        { m_InterpolatedTransforms[i]->SetRenderedLocalState({}, m_CurrentTransformStates[i]); }
+        m_InterpolatedTransforms.clear();
+        m_CurrentTransformStates.clear();
+    }
+
+    void cbtApplication::WaitForNextFrame(cbtU64 _frameStart) const
+    {
+        const cbtF64 frequency = static_cast<cbtF64>(SDL_GetPerformanceFrequency());
+        const cbtF64 targetTime = 1.0 / static_cast<cbtF64>(m_TargetFrameRate);
+        auto getRemainingTime = [_frameStart, frequency, targetTime]() -> cbtF64
+        {
+            return targetTime - static_cast<cbtF64>(SDL_GetPerformanceCounter() - _frameStart) / frequency;
+        };
+
+        // Sleeping can overshoot by a millisecond or more, so only sleep until shortly before the frame ends.
+        cbtF64 remainingTime = getRemainingTime();
+        if (remainingTime > FRAME_SPIN_MARGIN)
+        { std::this_thread::sleep_for(std::chrono::duration<cbtF64>(remainingTime - FRAME_SPIN_MARGIN)); }
+
+        while (getRemainingTime() > 0.0)
+        { std::this_thread::yield(); }
     }
 
     void cbtApplication::Exit()
     {
+        if (m_Headless.m_Enabled)
+        { ExportHeadlessFrameTimes(); }
+
+        if (cbtInputEngine::GetInstance()->GetInputMode() == CBT_INPUT_MODE_RECORD)
+        { cbtInputEngine::GetInstance()->StopRecording(m_InputRecordPath); }
+
         cbtGameEngine::GetInstance()->Exit();
         cbtGameEngine::Destroy();
         cbtRenderEngine::GetInstance()->Exit();
@@ -62,6 +256,123 @@ NS_CBT_BEGIN
         cbtInputEngine::Destroy();
 
         cbtManaged::ClearReleasePool();
+
+        // Anything still in use at this point has leaked.
+        cbtSlabAllocatorRegistry::LogStats();
+        CBT_MEMORY_DUMP();
+
+        if (cbtProfiler::IsEnabled())
+        {
+            cbtProfiler::LogStats();
+            cbtProfiler::ExportChromeTrace("./profile.json");
+        }
+
+        cbtDebug::Flush();
+    }
+
+    void cbtApplication::ParseArguments(cbtS32 _argc, cbtS8** _argv)
+    {
+        for (cbtS32 i = 1; i < _argc; ++i)
+        {
+            cbtStr arg = _argv[i];
+            cbtBool hasValue = (i + 1) < _argc;
+            if (arg == "--headless")
+            { m_Headless.m_Enabled = true; }
+            else if (arg == "--frames" && hasValue)
+            { m_Headless.m_FrameCount = (cbtU32)std::strtoul(_argv[++i], nullptr, 10); }
+            else if (arg == "--warmup" && hasValue)
+            { m_Headless.m_WarmupFrameCount = (cbtU32)std::strtoul(_argv[++i], nullptr, 10); }
+            else if (arg == "--width" && hasValue)
+            { m_Headless.m_Width = (cbtU32)std::strtoul(_argv[++i], nullptr, 10); }
+            else if (arg == "--height" && hasValue)
+            { m_Headless.m_Height = (cbtU32)std::strtoul(_argv[++i], nullptr, 10); }
+            else if (arg == "--capture-every" && hasValue)
+            { m_Headless.m_CaptureInterval = (cbtU32)std::strtoul(_argv[++i], nullptr, 10); }
+            else if (arg == "--capture-dir" && hasValue)
+            { m_Headless.m_CaptureDirectory = _argv[++i]; }
+            else if (arg == "--frame-times" && hasValue)
+            { m_Headless.m_FrameTimesPath = _argv[++i]; }
+            else if (arg == "--target-fps" && hasValue)
+            { SetTargetFrameRate(std::strtof(_argv[++i], nullptr)); }
+            else if (arg == "--fixed-hz" && hasValue)
+            {
+                cbtF32 fixedRate = std::strtof(_argv[++i], nullptr);
+                SetFixedDeltaTime((fixedRate > 0.0f) ? 1.0f / fixedRate : 0.0f);
+            }
+            else if (arg == "--interpolate")
+            { SetTransformInterpolationEnabled(true); }
+            else if (arg == "--record" && hasValue)
+            { m_InputRecordPath = _argv[++i]; }
+            else if (arg == "--replay" && hasValue)
+            { m_InputReplayPath = _argv[++i]; }
+            else
+            { CBT_LOG_WARN(CBT_LOG_CATEGORY_APPLICATION, "Unknown Argument: %s", arg.c_str()); }
+        }
+
+        if (!m_Headless.m_CaptureDirectory.empty() && m_Headless.m_CaptureDirectory.back() != '/')
+        { m_Headless.m_CaptureDirectory += '/'; }
+    }
+
+    void cbtApplication::RecordHeadlessFrame(cbtU32 _frame, cbtF64 _frameTime)
+    {
+        if (_frame < m_Headless.m_WarmupFrameCount)
+        { return; }
+
+        cbtU32 recordedFrame = _frame - m_Headless.m_WarmupFrameCount;
+        m_HeadlessFrameTimes.push_back(_frameTime);
+
+        // Capture after the frame has been timed, so that reading it back does not count towards its time.
+        if (m_Headless.m_CaptureInterval != 0 && (recordedFrame % m_Headless.m_CaptureInterval) == 0)
+        {
+            const cbtWindowProperties& winProp = cbtRenderEngine::GetInstance()->GetWindow()->GetProperties();
+            std::vector<cbtByte> pixels;
+            cbtRenderAPI::ReadPixels(0, 0, (cbtS32)winProp.m_Width, (cbtS32)winProp.m_Height, pixels);
+
+            cbtS8 fileName[32];
+            std::snprintf(fileName, sizeof(fileName), "frame_%05u.png", recordedFrame);
+            cbtFileUtil::CreateDirectories(m_Headless.m_CaptureDirectory);
+            cbtFileUtil::PixelsToPNG(m_Headless.m_CaptureDirectory + fileName, pixels.data(), winProp.m_Width, winProp.m_Height);
+        }
+
+        if (m_HeadlessFrameTimes.size() >= m_Headless.m_FrameCount)
+        { Quit(); }
+    }
+
+    void cbtApplication::ExportHeadlessFrameTimes() const
+    {
+        std::vector<cbtF64> sortedFrameTimes = m_HeadlessFrameTimes;
+        std::sort(sortedFrameTimes.begin(), sortedFrameTimes.end());
+        cbtF64 totalTime = 0.0;
+        for (cbtU32 i = 0; i < sortedFrameTimes.size(); ++i)
+        { totalTime += sortedFrameTimes[i]; }
+
+        // Use the nearest-rank method for percentiles.
+        auto percentile = [&sortedFrameTimes](cbtF64 _percent) -> cbtF64
+        {
+            if (sortedFrameTimes.empty())
+            { return 0.0; }
+            cbtU32 rank = static_cast<cbtU32>(_percent / 100.0 * static_cast<cbtF64>(sortedFrameTimes.size()) + 0.5);
+            return sortedFrameTimes[std::clamp<cbtU32>(rank, 1, (cbtU32)sortedFrameTimes.size()) - 1];
+        };
+
+        const cbtWindowProperties& winProp = cbtRenderEngine::GetInstance()->GetWindow()->GetProperties();
+        cbtStr json = "{\n";
+        json += "    \"application\": \"" + m_Name + "\",\n";
+        json += "    \"width\": " + CBT_TO_STRING(winProp.m_Width) + ",\n";
+        json += "    \"height\": " + CBT_TO_STRING(winProp.m_Height) + ",\n";
+        json += "    \"warmup_frames\": " + CBT_TO_STRING(m_Headless.m_WarmupFrameCount) + ",\n";
+        json += "    \"frames\": " + CBT_TO_STRING(sortedFrameTimes.size()) + ",\n";
+        json += "    \"mean_ms\": " + CBT_TO_STRING(sortedFrameTimes.empty() ? 0.0 : totalTime / static_cast<cbtF64>(sortedFrameTimes.size())) + ",\n";
+        json += "    \"median_ms\": " + CBT_TO_STRING(percentile(50.0)) + ",\n";
+        json += "    \"p95_ms\": " + CBT_TO_STRING(percentile(95.0)) + ",\n";
+        json += "    \"p99_ms\": " + CBT_TO_STRING(percentile(99.0)) + ",\n";
+        json += "    \"max_ms\": " + CBT_TO_STRING(sortedFrameTimes.empty() ? 0.0 : sortedFrameTimes.back()) + ",\n";
+        json += "    \"frame_times_ms\": [";
+        for (cbtU32 i = 0; i < m_HeadlessFrameTimes.size(); ++i)
+        { json += ((i == 0) ? "" : ", ") + CBT_TO_STRING(m_HeadlessFrameTimes[i]); }
+        json += "]\n";
+        json += "}\n";
+        cbtFileUtil::StringToFile(m_Headless.m_FrameTimesPath, json);
     }
 
 NS_CBT_END
\ No newline at end of file
@@ -7,7 +7,14 @@
 #include "Core/General/cbtSingleton.h"
 #include "Game/GameEngine/cbtGameEngine.h"
 #include "Rendering/RenderEngine/cbtRenderEngine.h"
+#include "Game/Component/Transform/cbtTransform.h"
 #include "Input/InputEngine/cbtInputEngine.h"
+#include "cbtHeadlessProperties.h"
+#include "cbtFrameStats.h"
+
+// Include STD
+#include <algorithm>
+#include <vector>
 
 NS_CBT_BEGIN
 
@@ -22,16 +29,23 @@ NS_CBT_BEGIN
         3. PostInit - This is a virtual interface function for the derived class. Any game specific systems should be initialised here. RegisterScene and PushScene to CBTSceneManager to get the game started.
 
         4. PreUpdate - This is a virtual interface function for the derived class. It is called before every frame Update.
-        5. Update - This function updates the core systems. It is called every frame.
-        6. PostUpdate - This is a virtual interface function for the derived class. It is called every frame after Update.
+        5. FixedUpdate - This is a virtual interface function for the derived class. It is called zero or more times every frame, each time advancing the simulation by GetFixedDeltaTime().
+        6. Update - This function updates the core systems. It is called every frame. If enabled, cbtTransforms are rendered interpolated between the last two fixed updates.
+        7. PostUpdate - This is a virtual interface function for the derived class. It is called every frame after Update.
 
-        7. PreExit - This is a virtual interface function for the derived class. Any game specific systems should be destroyed here.
-        8. Exit - This is where the core systems needed for the game to run (Rendering, Audio, Input, Physics etc.) are destroyed.
+        8. PreExit - This is a virtual interface function for the derived class. Any game specific systems should be destroyed here.
+        9. Exit - This is where the core systems needed for the game to run (Rendering, Audio, Input, Physics etc.) are destroyed.
 */
     class cbtApplication : public cbtSingleton<cbtApplication>
     {
         friend class cbtSingleton<cbtApplication>;
 
+    public:
+        /// The longest frame the simulation catches up on, in seconds. Longer frames, such as after a breakpoint, are clamped to this.
+        static constexpr cbtF32 MAX_FRAME_DELTA = 0.25f;
+        /// How long before the end of a frame to stop sleeping and start spinning when limiting the frame rate, in seconds.
+        static constexpr cbtF64 FRAME_SPIN_MARGIN = 0.002;
+
     protected:
         /// The name of the application.
         cbtStr m_Name;
@@ -43,6 +57,36 @@ NS_CBT_BEGIN
         /// The duration that has passed since the application started.
         cbtF32 m_TimePassed = 0.0f;
 
+        /// The duration each fixed update advances the simulation by. If 0, FixedUpdate is called once per frame with m_DeltaTime instead.
+        cbtF32 m_FixedDeltaTime = 1.0f / 60.0f;
+        /// The maximum number of fixed updates per frame. The simulation slows down instead of spiralling if it cannot keep up.
+        cbtU32 m_MaxFixedUpdatesPerFrame = 5;
+        /// The time which has passed but has not been simulated by a fixed update yet.
+        cbtF32 m_FixedTimeAccumulator = 0.0f;
+        /// How far between the previous fixed update (0) and the latest one (1) the current frame is rendered.
+        cbtF32 m_InterpolationAlpha = 1.0f;
+        /// If true, cbtTransforms are rendered interpolated between the last two fixed updates. Only useful if the game moves them in FixedUpdate.
+        cbtBool m_InterpolateTransforms = false;
+        /// The change version which ended before the transform states were last saved. Transforms which have not changed since then need no interpolation.
+        cbtU32 m_SavedStateVersion = 0;
+        /// The transforms moved to their interpolated state for rendering this frame. Kept between frames to reuse its memory.
+        std::vector<cbtTransform*> m_InterpolatedTransforms;
+        /// The states to restore m_InterpolatedTransforms to after rendering. Kept between frames to reuse its memory.
+        std::vector<cbtTransformState> m_CurrentTransformStates;
+        /// The frame rate to limit the game loop to. If 0, the frame rate is not limited.
+        cbtF32 m_TargetFrameRate = 0.0f;
+        /// The times taken by the most recent frames.
+        cbtFrameStats m_FrameStats;
+
+        /// The properties of a headless run.
+        cbtHeadlessProperties m_Headless;
+        /// The time taken by each recorded frame of a headless run, in milliseconds.
+        std::vector<cbtF64> m_HeadlessFrameTimes;
+        /// The file input is recorded to. If empty, input is not recorded.
+        cbtStr m_InputRecordPath;
+        /// The file input is replayed from. If empty, input comes from the devices.
+        cbtStr m_InputReplayPath;
+
     protected:
         /**
             \brief Constructs a new cbtApplication with given name.
@@ -82,6 +126,48 @@ NS_CBT_BEGIN
         */
         static cbtApplication* CreateInstance();
 
+        /**
+            \brief Record a frame of a headless run, capture it if needed, and quit once every frame has been recorded.
+
+            \param _frame The index of the frame, including warm-up frames.
+            \param _frameTime The time taken by the frame, in milliseconds.
+        */
+        void RecordHeadlessFrame(cbtU32 _frame, cbtF64 _frameTime);
+
+        /**
+            \brief Write the frame times of a headless run to m_Headless.m_FrameTimesPath.
+        */
+        void ExportHeadlessFrameTimes() const;
+
+        /**
+            \brief Advance the simulation by as many fixed updates as have accumulated, and compute m_InterpolationAlpha.
+        */
+        void UpdateFixed();
+
+        /**
+            \brief Remember the current state of every cbtTransform in the active scene, to interpolate from after the next fixed update.
+        */
+        void SaveTransformStates();
+
+        /**
+            \brief Move every cbtTransform in the active scene which has changed since its state was saved to its interpolated state, remembering its current state.
+        */
+        void InterpolateTransforms();
+
+        /**
+            \brief Restore the cbtTransforms moved by InterpolateTransforms() to their current state, for the next fixed update.
+        */
+        void RestoreTransforms();
+
+        /**
+            \brief
+                Wait until a frame which started at _frameStart has taken 1 / m_TargetFrameRate seconds.
+                Sleeps for most of the wait and spins for the remainder, as sleeping is not precise enough on its own.
+
+            \param _frameStart The performance counter at the start of the frame.
+        */
+        void WaitForNextFrame(cbtU64 _frameStart) const;
+
     public:
         /**
             \brief Returns the duration taken for the current frame.
@@ -113,6 +199,107 @@ NS_CBT_BEGIN
             return m_Name;
         }
 
+        inline const cbtHeadlessProperties& GetHeadlessProperties() const
+        {
+            return m_Headless;
+        }
+
+        /**
+            \brief Returns the duration each fixed update advances the simulation by. Use this instead of GetDeltaTime() in FixedUpdate.
+
+            \return Returns the duration each fixed update advances the simulation by.
+        */
+        inline cbtF32 GetFixedDeltaTime() const
+        {
+            return (m_FixedDeltaTime > 0.0f) ? m_FixedDeltaTime : m_DeltaTime;
+        }
+
+        /**
+            \brief Set the duration each fixed update advances the simulation by. Set to 0 to call FixedUpdate once per frame with a variable duration.
+
+            \param _fixedDeltaTime The duration each fixed update advances the simulation by, in seconds.
+        */
+        inline void SetFixedDeltaTime(cbtF32 _fixedDeltaTime)
+        {
+            m_FixedDeltaTime = std::max(_fixedDeltaTime, 0.0f);
+            m_FixedTimeAccumulator = 0.0f;
+        }
+
+        inline cbtU32 GetMaxFixedUpdatesPerFrame() const
+        {
+            return m_MaxFixedUpdatesPerFrame;
+        }
+
+        inline void SetMaxFixedUpdatesPerFrame(cbtU32 _maxFixedUpdates)
+        {
+            m_MaxFixedUpdatesPerFrame = std::max<cbtU32>(_maxFixedUpdates, 1);
+        }
+
+        /**
+            \brief Returns how far between the previous fixed update (0) and the latest one (1) the current frame is rendered.
+
+            \return Returns how far between the previous fixed update and the latest one the current frame is rendered.
+        */
+        inline cbtF32 GetInterpolationAlpha() const
+        {
+            return m_InterpolationAlpha;
+        }
+
+        inline cbtBool IsTransformInterpolationEnabled() const
+        {
+            return m_InterpolateTransforms;
+        }
+
+        /**
+            \brief
+                Render cbtTransforms interpolated between the last two fixed updates, so that motion is smooth when the frame rate differs from the fixed update rate.
+                Disabled by default. Only enable it if the game moves its transforms in FixedUpdate, since transforms moved in Update would be rendered behind where they are.
+
+            \param _interpolateTransforms Should cbtTransforms be rendered interpolated.
+        */
+        inline void SetTransformInterpolationEnabled(cbtBool _interpolateTransforms)
+        {
+            // Start interpolating from the current states, rather than from whenever they were last saved.
+            if (_interpolateTransforms && !m_InterpolateTransforms)
+            { SaveTransformStates(); }
+            m_InterpolateTransforms = _interpolateTransforms;
+        }
+
+        inline cbtF32 GetTargetFrameRate() const
+        {
+            return m_TargetFrameRate;
+        }
+
+        /**
+            \brief Limit the frame rate of the game loop. Ignored by headless runs.
+
+            \param _targetFrameRate The frame rate to limit the game loop to. Set to 0 to not limit the frame rate.
+        */
+        inline void SetTargetFrameRate(cbtF32 _targetFrameRate)
+        {
+            m_TargetFrameRate = std::max(_targetFrameRate, 0.0f);
+        }
+
+        inline const cbtFrameStats& GetFrameStats() const
+        {
+            return m_FrameStats;
+        }
+
+        /**
+            \brief
+                Parse the command line arguments of the application. Must be called before Run().
+                --headless renders offscreen without a window, and quits after --frames frames (default 300), following --warmup frames (default 10).
+                --width and --height set the resolution. --capture-every N writes every Nth frame to --capture-dir as a PNG.
+                --frame-times sets the file the frame times are written to.
+                --target-fps limits the frame rate, and --fixed-hz sets the rate of fixed updates (0 for a variable rate).
+                --interpolate renders cbtTransforms interpolated between fixed updates.
+                --record writes the input and delta time of every frame to a file, and --replay plays a recorded file back, quitting when it ends.
+
+            \param _argc The number of arguments.
+            \param _argv The arguments, starting with the name of the executable.
+        */
+        void ParseArguments(cbtS32 _argc, cbtS8** _argv);
+
         /**
             \brief Sets the m_Quit flag to true which will cause the game loop to break and quit the application.
         */
@@ -141,6 +328,13 @@ NS_CBT_BEGIN
          */
         virtual void PreUpdate() = 0;
 
+        /**
+            \brief This is a virtual interface function for the derived class. It is called zero or more times every frame, each time advancing the simulation by GetFixedDeltaTime().
+        */
+        virtual void FixedUpdate()
+        {
+        }
+
         /**
             \brief This function updates the core systems. It is called every frame.
         */
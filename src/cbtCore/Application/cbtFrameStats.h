@@ -0,0 +1,102 @@
+#pragma once
+
+// Include CBT
+#include "cbtMacros.h"
+
+// Include STD
+#include <algorithm>
+#include <array>
+
+NS_CBT_BEGIN
+
+    /**
+        \brief A rolling window of the times taken by the most recent frames, used to report stable frame rate statistics.
+    */
+    class cbtFrameStats
+    {
+    public:
+        /// The number of frames the statistics are computed over.
+        static constexpr cbtU32 WINDOW_SIZE = 120;
+
+    private:
+        /// The times taken by the most recent frames, in milliseconds.
+        std::array<cbtF32, WINDOW_SIZE> m_FrameTimes;
+        /// The index the next frame time is written to.
+        cbtU32 m_NextIndex = 0;
+        /// The number of frame times in m_FrameTimes, up to WINDOW_SIZE.
+        cbtU32 m_FrameCount = 0;
+        /// The sum of the frame times in m_FrameTimes.
+        cbtF64 m_TotalTime = 0.0;
+
+    public:
+        cbtFrameStats()
+        {
+            m_FrameTimes.fill(0.0f);
+        }
+
+        ~cbtFrameStats()
+        {
+        }
+
+        /**
+            \brief Add the time taken by a frame, replacing the oldest frame time once the window is full.
+
+            \param _frameTime The time taken by the frame, in milliseconds.
+        */
+        void AddFrame(cbtF32 _frameTime)
+        {
+            m_TotalTime += static_cast<cbtF64>(_frameTime) - static_cast<cbtF64>(m_FrameTimes[m_NextIndex]);
+            m_FrameTimes[m_NextIndex] = _frameTime;
+            m_NextIndex = (m_NextIndex + 1) % WINDOW_SIZE;
+            m_FrameCount = std::min(m_FrameCount + 1, WINDOW_SIZE);
+        }
+
+        inline cbtU32 GetFrameCount() const { return m_FrameCount; }
+
+        inline cbtF32 GetAverage() const
+        {
+            return (m_FrameCount == 0) ? 0.0f : static_cast<cbtF32>(m_TotalTime / static_cast<cbtF64>(m_FrameCount));
+        }
+
+        inline cbtF32 GetMin() const
+        {
+            return (m_FrameCount == 0) ? 0.0f : *std::min_element(m_FrameTimes.begin(), m_FrameTimes.begin() + m_FrameCount);
+        }
+
+        inline cbtF32 GetMax() const
+        {
+            return (m_FrameCount == 0) ? 0.0f : *std::max_element(m_FrameTimes.begin(), m_FrameTimes.begin() + m_FrameCount);
+        }
+
+        /**
+            \brief Get a percentile of the frame times in the window, using the nearest-rank method.
+
+            \param _percent The percentile, from 0 to 100.
+
+            \return The frame time at the percentile, in milliseconds.
+        */
+        cbtF32 GetPercentile(cbtF32 _percent) const
+        {
+            if (m_FrameCount == 0)
+            { return 0.0f; }
+
+            std::array<cbtF32, WINDOW_SIZE> sortedFrameTimes = m_FrameTimes;
+            cbtU32 rank = static_cast<cbtU32>(_percent / 100.0f * static_cast<cbtF32>(m_FrameCount) + 0.5f);
+            rank = std::clamp<cbtU32>(rank, 1, m_FrameCount) - 1;
+            std::nth_element(sortedFrameTimes.begin(), sortedFrameTimes.begin() + rank, sortedFrameTimes.begin() + m_FrameCount);
+            return sortedFrameTimes[rank];
+        }
+
+        /**
+            \brief Get the average frame rate over the window.
+
+            \return The average number of frames per second.
+        */
+        inline cbtF32 GetFramesPerSecond() const
+        {
+            cbtF32 average = GetAverage();
+            return (average > 0.0f) ? 1000.0f / average : 0.0f;
+        }
+    };
+
+NS_CBT_END
\ No newline at end of file
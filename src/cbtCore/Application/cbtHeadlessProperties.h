@@ -0,0 +1,33 @@
+#pragma once
+
+// Include CBT
+#include "cbtMacros.h"
+
+NS_CBT_BEGIN
+
+    /**
+        \brief
+            The properties of a headless run, which renders offscreen for a fixed number of frames then quits, for automated performance and regression runs.
+            Frame times are written to m_FrameTimesPath as JSON, and every m_CaptureInterval frames is written to m_CaptureDirectory as a PNG.
+            Set from the command line by cbtApplication::ParseArguments.
+    */
+    struct cbtHeadlessProperties
+    {
+    public:
+        /// Should the application run headless. If false, the other properties are ignored.
+        cbtBool m_Enabled = false;
+        cbtU32 m_Width = 1280;
+        cbtU32 m_Height = 720;
+        /// The number of frames to record before quitting.
+        cbtU32 m_FrameCount = 300;
+        /// The number of frames to render before recording, so that shaders are linked and caches are warm.
+        cbtU32 m_WarmupFrameCount = 10;
+        /// Capture every m_CaptureInterval-th recorded frame, starting with the first. Nothing is captured if 0.
+        cbtU32 m_CaptureInterval = 0;
+        cbtStr m_CaptureDirectory = "./captures/";
+        cbtStr m_FrameTimesPath = "./frame_times.json";
+        /// The duration of every frame as seen by the game, so that runs are reproducible regardless of how long frames take to render.
+        cbtF32 m_DeltaTime = 1.0f / 60.0f;
+    };
+
+NS_CBT_END
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include "Debug/cbtDebug.h"
 
 // Include STD
+#include <cstring>
+#include <functional>
 #include <mutex>
 
 NS_CBT_BEGIN
@@ -4,22 +4,44 @@
 #include "cbtMacros.h"
 #include "Core/General/cbtFamily.h"
 #include "cbtEventListener.h"
+#include "cbtEventQueue.h"
 
 // Include STD
-#include <unordered_map>
-#include <unordered_set>
+#include <algorithm>
 #include <vector>
 
 NS_CBT_BEGIN
 
 /**
-    \brief An cbtEventDispatcher is used to dispatch cbtEvent(s) to cbtEventListener(s) that are subscribed to this dispatcher. This uses the publisher-subscriber pattern.
+    \brief
+        An cbtEventDispatcher is used to dispatch cbtEvent(s) to cbtEventListener(s) that are subscribed to this dispatcher. This uses the publisher-subscriber pattern.
+        Events are dispatched immediately with DispatchEvent, or queued with QueueEvent and dispatched together when DispatchQueuedEvents is called.
 */
     class cbtEventDispatcher
     {
     private:
-        /// The cbtEventListener(s) added to this cbtEventDispatcher is sorted by the cbtEvent type they are subscribed to.
-        std::unordered_map<cbtS32, std::unordered_set<cbtEventListener*>> m_Listeners;
+        /// The cbtEventListener(s) added to this cbtEventDispatcher, indexed by the cbtFamily<cbtEvent> ID of the cbtEvent type they are subscribed to.
+        std::vector<std::vector<cbtEventListener*>> m_Listeners;
+        /// The cbtEvent(s) waiting to be dispatched by DispatchQueuedEvents.
+        cbtEventQueue m_Queue;
+
+        /**
+            \brief
+                Dispatches an cbtEvent to the cbtEventListener(s) subscribed to an event type, until one of them handles it.
+                Listeners may be added during dispatch, but a listener removed during dispatch may cause the next listener to miss the event.
+
+            \param _typeID The cbtFamily<cbtEvent> ID of the event type.
+            \param _event The cbtEvent to dispatch.
+        */
+        void DispatchEvent(cbtS32 _typeID, cbtEvent* _event)
+        {
+            for (cbtU32 i = 0; _typeID < (cbtS32)m_Listeners.size() && i < m_Listeners[_typeID].size(); ++i)
+            {
+                if (_event->IsHandled())
+                { break; }
+                m_Listeners[_typeID][i]->InvokeCallback(_event);
+            }
+        }
 
     public:
         /**
@@ -39,35 +61,45 @@ NS_CBT_BEGIN
             RemoveAllListeners();
         }
 
-        /*
-            \brief Dispatches an cbtEvent of type T. Only cbtEventListener(s) subscribed to cbtEvent(s) of type T will receive the event.
+        /**
+            \brief Dispatches an cbtEvent of type T immediately. Only cbtEventListener(s) subscribed to cbtEvent(s) of type T will receive the event.
 
-            \param _event The cbtEvent to dispatch.
-            \param _deleteAfterDispatch If set to true, the event will be deleted after dispatching. This means that the ownership of the event is given to the dispatcher. The default value is set to true.
+            \param _event The cbtEvent to dispatch. It may be of a type derived from T, and is still owned by the caller, so it can be created on the stack.
 
             \return Returns true if the cbtEvent is successfully dispatched.
         */
         template<typename T>
-        CBT_ENABLE_IF_DERIVED_1(cbtBool, cbtEvent, T)
-        DispatchEvent(cbtEvent* _event, cbtBool _deleteAfterDispatch = true)
+        CBT_ENABLE_IF_DERIVED_1(cbtBool, cbtEvent, T) DispatchEvent(T& _event)
         {
-            std::unordered_map<cbtS32, std::unordered_set<cbtEventListener*>>::iterator iter = m_Listeners.find(
-                    cbtFamily<cbtEvent>::GetID<T>());
-            if (iter == m_Listeners.end())
-            { return true; }
+            DispatchEvent(cbtFamily<cbtEvent>::GetID<T>(), &_event);
+            return true;
+        }
 
-            for (std::unordered_set<cbtEventListener*>::iterator i = iter->second.begin();
-                 i != iter->second.end(); ++i)
-            {
-                if (_event->IsHandled())
-                { break; }
-                (*i)->InvokeCallback(_event);
-            }
+        /**
+            \brief
+                Queues a copy of an cbtEvent to be dispatched as an cbtEvent of type T when DispatchQueuedEvents is called.
+                Only cbtEventListener(s) subscribed to cbtEvent(s) of type T will receive the event.
 
-            if (_deleteAfterDispatch)
-            { delete _event; }
+            \param _event The cbtEvent to queue. It may be of a type derived from T.
+        */
+        template<typename T, typename E>
+        CBT_ENABLE_IF_DERIVED_2(void, cbtEvent, T, E) QueueEvent(const E& _event)
+        {
+            static_assert(std::is_base_of<T, E>::value, "A queued event must be of type T, or derived from T.");
+            m_Queue.Push<E>(cbtFamily<cbtEvent>::GetID<T>(), _event);
+        }
 
-            return true;
+        /**
+            \brief Dispatches every queued cbtEvent in the order they were queued, including events queued by the listeners while dispatching, then clears the queue.
+        */
+        void DispatchQueuedEvents()
+        {
+            for (cbtU32 i = 0; i < m_Queue.GetSize(); ++i)
+            {
+                const cbtEventQueue::cbtQueuedEvent queuedEvent = m_Queue.GetEvent(i);
+                DispatchEvent(queuedEvent.m_TypeID, queuedEvent.m_Event);
+            }
+            m_Queue.Clear();
         }
 
         /**
@@ -80,27 +112,17 @@ NS_CBT_BEGIN
         template<typename T>
         CBT_ENABLE_IF_DERIVED_1(cbtBool, cbtEvent, T) AddListener(cbtEventListener* _listener)
         {
-            std::unordered_map<cbtS32, std::unordered_set<cbtEventListener*>>::iterator iter = m_Listeners.find(
-                    cbtFamily<cbtEvent>::GetID<T>());
-            if (iter == m_Listeners.end())
-            {
-                // Add the listener.
-                std::unordered_set<cbtEventListener*> listenerList;
-                listenerList.insert(_listener);
-                m_Listeners.insert(
-                        std::pair<cbtS32, std::unordered_set<cbtEventListener*>>(cbtFamily<cbtEvent>::GetID<T>(),
-                                listenerList));
-            }
-            else
-            {
-                // Return false if _listener has already been added for an event of type T.
-                if (iter->second.find(_listener) != iter->second.end())
-                { return false; }
+            cbtS32 typeID = cbtFamily<cbtEvent>::GetID<T>();
+            if (typeID >= (cbtS32)m_Listeners.size())
+            { m_Listeners.resize(typeID + 1); }
 
-                // Add the listener.
-                iter->second.insert(_listener);
-            }
+            // Return false if _listener has already been added for an event of type T.
+            std::vector<cbtEventListener*>& listeners = m_Listeners[typeID];
+            if (std::find(listeners.begin(), listeners.end(), _listener) != listeners.end())
+            { return false; }
 
+            // Add the listener.
+            listeners.push_back(_listener);
             return true;
         }
 
@@ -114,19 +136,17 @@ NS_CBT_BEGIN
         template<typename T>
         CBT_ENABLE_IF_DERIVED_1(cbtBool, cbtEvent, T) RemoveListener(cbtEventListener* _listener)
         {
-            std::unordered_map<cbtS32, std::unordered_set<cbtEventListener*>>::iterator iter = m_Listeners.find(
-                    cbtFamily<cbtEvent>::GetID<T>());
-
             // Check that the listener has been added.
-            if (iter == m_Listeners.end())
+            cbtS32 typeID = cbtFamily<cbtEvent>::GetID<T>();
+            if (typeID >= (cbtS32)m_Listeners.size())
             { return false; }
-            if (iter->second.find(_listener) == iter->second.end())
+            std::vector<cbtEventListener*>& listeners = m_Listeners[typeID];
+            std::vector<cbtEventListener*>::iterator iter = std::find(listeners.begin(), listeners.end(), _listener);
+            if (iter == listeners.end())
             { return false; }
 
-            iter->second.erase(_listener);
-            if (iter->second.size() == 0)
-            { m_Listeners.erase(iter); }
-
+            // Keep the order listeners were added in, which is the order they receive events in.
+            listeners.erase(iter);
             return true;
         }
 
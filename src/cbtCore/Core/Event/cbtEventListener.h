@@ -3,9 +3,6 @@
 // Include CBT
 #include "cbtEvent.h"
 
-// Include STD
-#include <functional>
-
 NS_CBT_BEGIN
 
 /**
@@ -13,9 +10,15 @@ NS_CBT_BEGIN
 */
     class cbtEventListener
     {
+    public:
+        /// A function which receives a cbtEvent, and the user data given to SetCallback.
+        typedef void (* Callback)(cbtEvent* _event, void* _userData);
+
     private:
         /// When a cbtEvent is received, the function assigned to m_Callback is invoked. The event will be passed to the function as a parameter.
-        std::function<void(cbtEvent*)> m_Callback = nullptr;
+        Callback m_Callback = nullptr;
+        /// Passed to m_Callback, usually the object whose member function should receive the event.
+        void* m_UserData = nullptr;
 
     public:
         /**
@@ -35,17 +38,33 @@ NS_CBT_BEGIN
         }
 
         /**
-            \brief Sets a function to be called when an cbtEvent is received.
-                   Use CBT_CALLBACK_0, CBT_CALLBACK_1, CBT_CALLBACK_2 etc. to set a non-static member function as a callback.
-                   Learn more about CBT_CALLBACK in CBTMacros.h.
+            \brief Sets a function to be called when an cbtEvent is received. Lambdas without captures may be used.
 
             \param _callback The callback function to invoke when an cbtEvent is received.
-
-            \sa CBTMacros.h
+            \param _userData Passed to _callback with every event.
         */
-        void SetCallback(const std::function<void(cbtEvent*)>& _callback)
+        void SetCallback(Callback _callback, void* _userData = nullptr)
         {
             m_Callback = _callback;
+            m_UserData = _userData;
+        }
+
+        /**
+            \brief
+                Sets a non-static member function to be called when an cbtEvent is received.
+
+                Example:\n
+                \code{.cpp}
+                m_EventListener.SetCallback<cbtRenderer, &cbtRenderer::OnEvent>(this);
+                \endcode
+
+            \param _object The object to call Function on.
+        */
+        template<typename T, void (T::*Function)(cbtEvent*)>
+        void SetCallback(T* _object)
+        {
+            m_Callback = [](cbtEvent* _event, void* _userData) { (static_cast<T*>(_userData)->*Function)(_event); };
+            m_UserData = _object;
         }
 
         /**
@@ -53,10 +72,10 @@ NS_CBT_BEGIN
 
             \param _event The cbtEvent that is received.
         */
-        void InvokeCallback(cbtEvent* _event)
+        inline void InvokeCallback(cbtEvent* _event)
         {
             if (m_Callback != nullptr)
-            { m_Callback(_event); }
+            { m_Callback(_event, m_UserData); }
         }
     };
 
@@ -0,0 +1,128 @@
+#pragma once
+
+// Include CBT
+#include "cbtMacros.h"
+#include "cbtEvent.h"
+
+// Include STD
+#include <new>
+#include <vector>
+
+NS_CBT_BEGIN
+
+/**
+    \brief
+        Stores copies of cbtEvent(s) until they are dispatched. The events are placed in fixed size blocks of memory which are reused after Clear,
+        so once the queue has grown to fit a frame's events, queueing an event does not allocate.
+*/
+    class cbtEventQueue
+    {
+    public:
+        /// The size of each block of memory events are placed in. No event may be larger than this.
+        static constexpr cbtU32 BLOCK_SIZE = 4096;
+
+        /// A queued event, and the type of cbtEvent it is dispatched as.
+        struct cbtQueuedEvent
+        {
+            cbtS32 m_TypeID;
+            cbtEvent* m_Event;
+        };
+
+    private:
+        /// The blocks of memory events are placed in. Blocks are never freed until the queue is destroyed.
+        std::vector<cbtByte*> m_Blocks;
+        /// The block the next event is placed in.
+        cbtU32 m_BlockIndex = 0;
+        /// The offset in the current block the next event is placed at.
+        cbtU32 m_BlockOffset = 0;
+        /// The queued events, in the order they were queued.
+        std::vector<cbtQueuedEvent> m_Events;
+
+        /**
+            \brief Reserve memory for an event.
+
+            \param _size The size of the event.
+            \param _alignment The alignment of the event.
+
+            \return The memory to place the event in.
+        */
+        void* Allocate(cbtU32 _size, cbtU32 _alignment)
+        {
+            cbtU32 offset = (m_BlockOffset + _alignment - 1) & ~(_alignment - 1);
+            if (m_BlockIndex < m_Blocks.size() && offset + _size > BLOCK_SIZE)
+            {
+                ++m_BlockIndex;
+                offset = 0;
+            }
+            if (m_BlockIndex == m_Blocks.size())
+            { m_Blocks.push_back(cbtNew cbtByte[BLOCK_SIZE]); }
+
+            m_BlockOffset = offset + _size;
+            return m_Blocks[m_BlockIndex] + offset;
+        }
+
+    public:
+        /**
+            \brief Default Constructor.
+
+            \return A cbtEventQueue.
+        */
+        cbtEventQueue()
+        {
+        }
+
+        cbtEventQueue(const cbtEventQueue&) = delete;
+        cbtEventQueue& operator=(const cbtEventQueue&) = delete;
+
+        /**
+            \brief Destructor. Queued events are destroyed without being dispatched.
+        */
+        ~cbtEventQueue()
+        {
+            Clear();
+            for (cbtU32 i = 0; i < m_Blocks.size(); ++i)
+            { delete[] m_Blocks[i]; }
+        }
+
+        /**
+            \brief Copy an event into the queue.
+
+            \param _typeID The cbtFamily<cbtEvent> ID of the type of cbtEvent the event is dispatched as.
+            \param _event The event to copy.
+        */
+        template<typename T>
+        CBT_ENABLE_IF_DERIVED_1(void, cbtEvent, T) Push(cbtS32 _typeID, const T& _event)
+        {
+            static_assert(sizeof(T) <= BLOCK_SIZE, "Events must fit in a block of the event queue.");
+            static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Events must not be over-aligned.");
+            T* event = new (Allocate(sizeof(T), alignof(T))) T(_event);
+            m_Events.push_back({ _typeID, event });
+        }
+
+        inline cbtU32 GetSize() const { return (cbtU32)m_Events.size(); }
+
+        inline cbtBool IsEmpty() const { return m_Events.empty(); }
+
+        /**
+            \brief Get a queued event. Events may be queued while the queue is being iterated over, but the reference is then invalidated.
+
+            \param _index The index of the event, in the order the events were queued.
+
+            \return The queued event.
+        */
+        inline const cbtQueuedEvent& GetEvent(cbtU32 _index) const { return m_Events[_index]; }
+
+        /**
+            \brief Destroy every queued event, keeping the memory they used for the next events.
+        */
+        void Clear()
+        {
+            for (cbtU32 i = 0; i < m_Events.size(); ++i)
+            { m_Events[i].m_Event->~cbtEvent(); }
+            m_Events.clear();
+            m_BlockIndex = 0;
+            m_BlockOffset = 0;
+        }
+    };
+
+NS_CBT_END
\ No newline at end of file
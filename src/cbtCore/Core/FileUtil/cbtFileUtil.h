@@ -3,6 +3,9 @@
 // Include CBT
 #include "cbtMacros.h"
 
+// Include STD
+#include <vector>
+
 NS_CBT_BEGIN
 
 /**
@@ -46,6 +49,59 @@ NS_CBT_BEGIN
             \sa FileToString(const cbtStr& _filePath)
         */
         static void StringToFile(const cbtStr& _filePath, const cbtStr& _string);
+
+        /**
+            \brief Opens a file and reads its raw bytes. Unlike FileToString, the contents may contain null bytes.
+
+            \param _filePath The file path of the file to open and read.
+            \param _bytes The contents of the file.
+
+            \return Returns true if the file was read. Otherwise, returns false. A missing file is not treated as an error.
+
+            \sa BytesToFile(const cbtStr& _filePath, const cbtByte* _bytes, size_t _size)
+        */
+        static cbtBool FileToBytes(const cbtStr& _filePath, std::vector<cbtByte>& _bytes);
+
+        /**
+            \brief Opens a file and writes raw bytes to it. If the file does not exist, it is created.
+
+            \param _filePath The file path of the file to open and write.
+            \param _bytes The bytes to write.
+            \param _size The number of bytes to write.
+
+            \return Returns true if every byte was written. Otherwise, returns false.
+
+            \sa FileToBytes(const cbtStr& _filePath, std::vector<cbtByte>& _bytes)
+        */
+        static cbtBool BytesToFile(const cbtStr& _filePath, const cbtByte* _bytes, size_t _size);
+
+        /**
+            \brief Deletes a file if it exists.
+
+            \param _filePath The file path of the file to delete.
+        */
+        static void RemoveFile(const cbtStr& _filePath);
+
+        /**
+            \brief Creates a directory, along with any missing parent directories.
+
+            \param _directoryPath The path of the directory to create.
+
+            \return Returns true if the directory exists after the call. Otherwise, returns false.
+        */
+        static cbtBool CreateDirectories(const cbtStr& _directoryPath);
+
+        /**
+            \brief Writes an image to a PNG file. If the file does not exist, it is created.
+
+            \param _filePath The file path of the PNG file to write.
+            \param _pixels The pixels of the image, 4 bytes per pixel in RGBA order, starting from the bottom row like OpenGL.
+            \param _width The width of the image in pixels.
+            \param _height The height of the image in pixels.
+
+            \return Returns true if the file was written. Otherwise, returns false.
+        */
+        static cbtBool PixelsToPNG(const cbtStr& _filePath, const cbtByte* _pixels, cbtU32 _width, cbtU32 _height);
     };
 
 NS_CBT_END
\ No newline at end of file
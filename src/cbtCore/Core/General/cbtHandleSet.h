@@ -2,6 +2,7 @@
 
 // Include CBT
 #include "cbtMacros.h"
+#include "Debug/cbtDebug.h"
 
 // Include STD
 #include <vector>
@@ -11,11 +12,12 @@ NS_CBT_BEGIN
 /**
     \brief
         Generates unique handles of type T.
-        Half of the handle will store it's index, and the other half will store it's version.
-        For example, a 32bit handle will have it's left 16bits store its version number, and the right 16bits store its index.
+        The low INDEX_BITSIZE bits of the handle store its index, and the rest store its version.
+        By default, half of the handle stores its index. For example, a 32bit handle will have its left 16bits store its version number, and the right 16bits store its index.
         [32bit Handle] = [16bit Version] & [16bit Index]
+        A larger index allows more handles, and a larger version allows an index to be reused more times before an old handle becomes valid again.
 */
-    template<typename T>
+    template<typename T, cbtU32 INDEX_BITSIZE = (CBT_BITSIZE(T) >> 1)>
     class cbtHandleSet
     {
     protected:
@@ -26,16 +28,21 @@ NS_CBT_BEGIN
         /// \brief Number of handles that can be recycled.
         CBT_ENABLE_IF_UINT(T, T) m_Recycle;
 
+        static_assert(INDEX_BITSIZE > 0 && INDEX_BITSIZE < CBT_BITSIZE(T), "A handle needs bits for both its index and its version.");
+
         /// \brief The bitsize of T.
-        static const cbtU32 BITSIZE = CBT_BITSIZE(T);
-        /// \brief Half the bitsize of T.
-        static const cbtU32 HALF_BITSIZE = (CBT_BITSIZE(T) >> 1);
+        static constexpr cbtU32 BITSIZE = CBT_BITSIZE(T);
+        /// \brief The bitsize of the version of a handle.
+        static constexpr cbtU32 VERSION_BITSIZE = BITSIZE - INDEX_BITSIZE;
         /// \brief A mask to extract the index of a handle.
-        static const T INDEX_MASK = (1 << HALF_BITSIZE) - 1;
+        static constexpr T INDEX_MASK = ((T)1 << INDEX_BITSIZE) - 1;
         /// \brief mask to extract the version of the handle.
-        static const T VERSION_MASK = ~INDEX_MASK;
+        static constexpr T VERSION_MASK = ~INDEX_MASK;
 
     public:
+        /// \brief The maximum number of handles which can be valid at the same time.
+        static constexpr cbtU64 MAX_HANDLE_COUNT = (cbtU64)INDEX_MASK + 1;
+
         /**
             \brief Constructor
 
@@ -63,9 +70,9 @@ NS_CBT_BEGIN
 
             \sa GetVersion, GetIndex
         */
-        static T GetHandle(cbtU32 _version, cbtU32 _index)
+        static T GetHandle(T _version, T _index)
         {
-            return (_version << HALF_BITSIZE) | (_index & INDEX_MASK);
+            return (T)(_version << INDEX_BITSIZE) | (_index & INDEX_MASK);
         }
 
         /**
@@ -79,7 +86,7 @@ NS_CBT_BEGIN
         */
         static T GetVersion(T _handle)
         {
-            return _handle >> HALF_BITSIZE;
+            return _handle >> INDEX_BITSIZE;
         }
 
         /**
@@ -124,6 +131,7 @@ NS_CBT_BEGIN
         {
             if (m_Recycle == 0)
             {
+                CBT_ASSERT(m_Handles.size() < MAX_HANDLE_COUNT);
                 T handle = GetHandle(0, (T)m_Handles.size());
                 m_Handles.push_back(handle);
                 return handle;
@@ -152,11 +160,22 @@ NS_CBT_BEGIN
 
             T index = GetIndex(_handle);
             T version = GetVersion(_handle) + 1;
-            m_Handles[index] = (version << 16) | m_NextIndex;
+            m_Handles[index] = GetHandle(version, m_NextIndex);
             m_NextIndex = index;
             ++m_Recycle;
         }
 
+        /**
+            \brief Reserve space so that the next _count calls to Add do not reallocate.
+
+            \param _count The number of handles which will be added.
+        */
+        void Reserve(cbtU32 _count)
+        {
+            if (_count > m_Recycle)
+            { m_Handles.reserve(m_Handles.size() + (_count - m_Recycle)); }
+        }
+
         /**
             \brief Get the number of valid handles.
 
@@ -0,0 +1,285 @@
+#pragma once
+
+// Include CBT
+#include "cbtMacros.h"
+#include "Core/General/cbtRef.h"
+#include "Core/General/cbtStringID.h"
+
+// Include STD
+#include <vector>
+
+NS_CBT_BEGIN
+
+    /**
+        \brief
+            A template class which stores items of type T using a cbtStrID as the key.
+            It is a variant of cbtLibrary which does not hash or compare whole strings on lookup. The items are stored in an
+            open addressing flat map with linear probing, so a lookup is usually a single cache line and never allocates.
+            Items can still be added and retrieved using their name, which is hashed into a cbtStrID.
+    */
+    template<typename T>
+    class cbtIDLibrary
+    {
+    protected:
+        /// A slot in the flat map. An empty slot has an ID of CBT_INVALID_STR_ID.
+        struct Slot
+        {
+            cbtStrID m_ID = CBT_INVALID_STR_ID;
+            T* m_Item = nullptr;
+        };
+
+        /// The minimum number of slots. Must be a power of 2.
+        static constexpr cbtU32 MIN_CAPACITY = 16;
+
+        /// The slots of the flat map. The number of slots is always a power of 2, and at most half of them are used.
+        std::vector<Slot> m_Slots;
+        /// The number of items in the cbtIDLibrary.
+        cbtU32 m_Count = 0;
+
+        inline cbtU32 GetMask() const
+        {
+            return (cbtU32)m_Slots.size() - 1;
+        }
+
+        /**
+            \brief Find the slot containing an item, or the empty slot it would be inserted into.
+
+            \param _id The cbtStrID of the item.
+
+            \return The index of the slot.
+        */
+        cbtU32 FindSlot(cbtStrID _id) const
+        {
+            cbtU32 mask = GetMask();
+            cbtU32 index = (cbtU32)_id & mask;
+            while (m_Slots[index].m_ID != CBT_INVALID_STR_ID && m_Slots[index].m_ID != _id)
+            { index = (index + 1) & mask; }
+            return index;
+        }
+
+        /**
+            \brief Resize the flat map and reinsert every item.
+
+            \param _capacity The new number of slots. Must be a power of 2.
+        */
+        void Rehash(cbtU32 _capacity)
+        {
+            std::vector<Slot> oldSlots(_capacity);
+            oldSlots.swap(m_Slots);
+            for (cbtU32 i = 0; i < oldSlots.size(); ++i)
+            {
+                if (oldSlots[i].m_ID != CBT_INVALID_STR_ID)
+                { m_Slots[FindSlot(oldSlots[i].m_ID)] = oldSlots[i]; }
+            }
+        }
+
+    public:
+        /**
+            \brief Constructor
+
+            \return A cbtIDLibrary
+        */
+        cbtIDLibrary()
+                :m_Slots(MIN_CAPACITY)
+        {
+        }
+
+        /**
+            \brief Destructor
+        */
+        virtual ~cbtIDLibrary()
+        {
+            RemoveAllItems();
+        }
+
+        inline cbtU32 GetCount() const
+        {
+            return m_Count;
+        }
+
+        /**
+            \brief Checks if an item of a given cbtStrID exists.
+
+            \param _id The cbtStrID of the item.
+
+            \return Returns true if the cbtIDLibrary contains an item of cbtStrID _id. Otherwise, returns false.
+        */
+        inline cbtBool HasItem(cbtStrID _id) const
+        {
+            return m_Slots[FindSlot(_id)].m_ID != CBT_INVALID_STR_ID;
+        }
+
+        /**
+            \brief Checks if an item of a given name exists.
+
+            \param _name The name of the item.
+
+            \return Returns true if the cbtIDLibrary contains an item of name _name. Otherwise, returns false.
+        */
+        inline cbtBool HasItem(const cbtStr& _name) const
+        {
+            return HasItem(cbtHashString(_name));
+        }
+
+        /**
+            \brief Get the item of a given cbtStrID.
+
+            \param _id The cbtStrID of the item.
+
+            \return The item of cbtStrID _id. If there is no such item, returns nullptr.
+        */
+        const T* GetItem(cbtStrID _id) const
+        {
+            return m_Slots[FindSlot(_id)].m_Item;
+        }
+
+        /**
+            \brief Get the item of a given cbtStrID.
+
+            \param _id The cbtStrID of the item.
+
+            \return The item of cbtStrID _id. If there is no such item, returns nullptr.
+        */
+        T* GetItem(cbtStrID _id)
+        {
+            return m_Slots[FindSlot(_id)].m_Item;
+        }
+
+        /**
+            \brief Get the item of a given cbtStrID.
+
+            \param _id The cbtStrID of the item.
+
+            \return The item of cbtStrID _id, cast to U. If there is no such item, returns nullptr.
+        */
+        template<class U>
+        U* GetItem(cbtStrID _id)
+        {
+            return static_cast<U*>(GetItem(_id));
+        }
+
+        /**
+            \brief Get the item of a given name.
+
+            \param _name The name of the item.
+
+            \return The item of name _name. If there is no such item, returns nullptr.
+        */
+        const T* GetItem(const cbtStr& _name) const
+        {
+            return GetItem(cbtHashString(_name));
+        }
+
+        /**
+            \brief Get the item of a given name.
+
+            \param _name The name of the item.
+
+            \return The item of name _name. If there is no such item, returns nullptr.
+        */
+        T* GetItem(const cbtStr& _name)
+        {
+            return GetItem(cbtHashString(_name));
+        }
+
+        /**
+            \brief Add an item using its name as the key.
+
+            \param _item The item to add.
+        */
+        void AddItem(T* _item)
+        {
+            AddItem(_item->GetNameID(), _item);
+        }
+
+        /**
+            \brief Add an item using a given name as the key. The name is interned.
+
+            \param _name The key of the item.
+            \param _item The item to add.
+        */
+        void AddItem(const cbtStr& _name, T* _item)
+        {
+            AddItem(cbtStringTable::Intern(_name), _item);
+        }
+
+        /**
+            \brief Add an item using a given cbtStrID as the key.
+
+            \param _id The key of the item.
+            \param _item The item to add.
+        */
+        void AddItem(cbtStrID _id, T* _item)
+        {
+            CBT_ASSERT(_id != CBT_INVALID_STR_ID);
+            CBT_ASSERT(!HasItem(_id));
+
+            // Keep the load factor at or below 0.5 so that probe sequences stay short.
+            if ((m_Count + 1) * 2 > m_Slots.size())
+            { Rehash((cbtU32)m_Slots.size() * 2); }
+
+            _item->Retain();
+            Slot& slot = m_Slots[FindSlot(_id)];
+            slot.m_ID = _id;
+            slot.m_Item = _item;
+            ++m_Count;
+        }
+
+        /**
+            \brief Remove the item of a given cbtStrID.
+
+            \param _id The cbtStrID of the item.
+        */
+        void RemoveItem(cbtStrID _id)
+        {
+            CBT_ASSERT(HasItem(_id));
+
+            cbtU32 mask = GetMask();
+            cbtU32 hole = FindSlot(_id);
+            m_Slots[hole].m_Item->AutoRelease();
+
+            /* Backward shift deletion. Move later items in the probe sequence into the hole if their home slot is not
+            cyclically between the hole and their current slot, so that no tombstones are needed. */
+            for (cbtU32 index = (hole + 1) & mask; m_Slots[index].m_ID != CBT_INVALID_STR_ID; index = (index + 1) & mask)
+            {
+                cbtU32 home = (cbtU32)m_Slots[index].m_ID & mask;
+                cbtBool homeBetween = (hole <= index) ? (hole < home && home <= index) : (hole < home || home <= index);
+                if (!homeBetween)
+                {
+                    m_Slots[hole] = m_Slots[index];
+                    hole = index;
+                }
+            }
+
+            m_Slots[hole] = Slot();
+            --m_Count;
+        }
+
+        /**
+            \brief Remove the item of a given name.
+
+            \param _name The name of the item.
+        */
+        void RemoveItem(const cbtStr& _name)
+        {
+            RemoveItem(cbtHashString(_name));
+        }
+
+        /**
+            \brief Remove all items in the cbtIDLibrary.
+        */
+        void RemoveAllItems()
+        {
+            std::vector<Slot> clearPool(MIN_CAPACITY);
+            clearPool.swap(m_Slots);
+            m_Count = 0;
+
+            for (cbtU32 i = 0; i < clearPool.size(); ++i)
+            {
+                if (clearPool[i].m_ID != CBT_INVALID_STR_ID)
+                { clearPool[i].m_Item->AutoRelease(); }
+            }
+        }
+    };
+
+NS_CBT_END
\ No newline at end of file
@@ -87,7 +87,7 @@ public:
     */
     const T* GetItem(const cbtStr& _name) const
     {
-        typename std::unordered_map<cbtStr, T*>::iterator iter = m_Items.find(_name);
+        typename std::unordered_map<cbtStr, T*>::const_iterator iter = m_Items.find(_name);
         return iter == m_Items.end() ? nullptr : iter->second;
     }
 
@@ -134,16 +134,26 @@ public:
     }
 
     /**
-        \brief Add an item.
+        \brief Add an item using its name as the key.
 
-        \param _name The name of the item.
         \param _item The item to add.
     */
-    const void AddItem(T* _item) const
+    void AddItem(T* _item)
+    {
+        AddItem(_item->GetName(), _item);
+    }
+
+    /**
+        \brief Add an item using a given key. This allows items to be stored using something other than their name, such as their file path.
+
+        \param _name The key of the item.
+        \param _item The item to add.
+    */
+    void AddItem(const cbtStr& _name, T* _item)
     {
-        CBT_ASSERT(!HasItem(_item->GetName()));
+        CBT_ASSERT(!HasItem(_name));
         _item->Retain();
-        m_Items.insert(std::pair<cbtStr, T*>(_item->GetName(), _item));
+        m_Items.insert(std::pair<cbtStr, T*>(_name, _item));
     }
 
     /**
@@ -3,10 +3,94 @@
 
 NS_CBT_BEGIN
 
-    cbtManaged* cbtManaged::s_Buffer[MAX_POOL_SIZE * 2] = { 0 };
-    cbtU32 cbtManaged::s_ReleaseStart = 0;
-    cbtU32 cbtManaged::s_ReleaseCount = 0;
-    std::mutex cbtManaged::s_ReleaseMutex;
     std::mutex cbtManaged::s_ClearMutex;
+    thread_local cbtBool cbtManaged::s_DeferAutoRelease = false;
+#ifndef NDEBUG
+    thread_local cbtU32 cbtManaged::s_DeferredCount = 0;
+#endif
+
+    cbtManaged::ReleasePool::ReleasePool()
+    {
+        ReleasePoolRegistry& registry = GetReleasePoolRegistry();
+        std::lock_guard<std::mutex> registryLock(registry.m_Mutex);
+        registry.m_Pools.push_back(this);
+    }
+
+    cbtManaged::ReleasePool::~ReleasePool()
+    {
+        ReleasePoolRegistry& registry = GetReleasePoolRegistry();
+        std::lock_guard<std::mutex> registryLock(registry.m_Mutex);
+        std::lock_guard<std::mutex> poolLock(m_Mutex);
+        registry.m_OrphanedObjects.insert(registry.m_OrphanedObjects.end(), m_Objects.begin(), m_Objects.end());
+        for (cbtU32 i = 0; i < registry.m_Pools.size(); ++i)
+        {
+            if (registry.m_Pools[i] == this)
+            {
+                registry.m_Pools[i] = registry.m_Pools.back();
+                registry.m_Pools.pop_back();
+                break;
+            }
+        }
+    }
+
+    cbtManaged::ReleasePoolRegistry& cbtManaged::GetReleasePoolRegistry()
+    {
+        static ReleasePoolRegistry registry;
+        return registry;
+    }
+
+    cbtManaged::ReleasePool& cbtManaged::GetReleasePool()
+    {
+        thread_local ReleasePool releasePool;
+        return releasePool;
+    }
+
+    void cbtManaged::AutoRelease()
+    {
+        CBT_ASSERT(GetRefCount() > 0);
+        ReleasePool& releasePool = GetReleasePool();
+        std::lock_guard<std::mutex> poolLock(releasePool.m_Mutex);
+        releasePool.m_Objects.push_back(this);
+    }
+
+    void cbtManaged::AutoRelease(cbtManaged* const* _objects, cbtU32 _count)
+    {
+        ReleasePool& releasePool = GetReleasePool();
+        std::lock_guard<std::mutex> poolLock(releasePool.m_Mutex);
+        releasePool.m_Objects.insert(releasePool.m_Objects.end(), _objects, _objects + _count);
+    }
+
+    void cbtManaged::ClearReleasePool()
+    {
+        std::lock_guard<std::mutex> clearLock(s_ClearMutex);
+        ReleasePoolRegistry& registry = GetReleasePoolRegistry();
+        std::vector<cbtManaged*> releaseList;
+
+        // There is a chance that the deletion of objects will trigger more objects to be released for deletion.
+        // Therefore this will loop till there is nothing left to release.
+        while (true)
+        {
+            // Take the objects out of every pool first, so that no pool is locked while objects are being deleted.
+            {
+                std::lock_guard<std::mutex> registryLock(registry.m_Mutex);
+                releaseList.swap(registry.m_OrphanedObjects);
+                for (cbtU32 i = 0; i < registry.m_Pools.size(); ++i)
+                {
+                    std::lock_guard<std::mutex> poolLock(registry.m_Pools[i]->m_Mutex);
+                    std::vector<cbtManaged*>& objects = registry.m_Pools[i]->m_Objects;
+                    releaseList.insert(releaseList.end(), objects.begin(), objects.end());
+                    // Clearing keeps the pool's capacity, so it stops allocating once it has grown to fit a frame.
+                    objects.clear();
+                }
+            }
+
+            // If there is nothing to release, stop the loop.
+            if (releaseList.empty())
+            { break; }
+            for (cbtU32 i = 0; i < releaseList.size(); ++i)
+            { releaseList[i]->Release(); }
+            releaseList.clear();
+        }
+    }
 
 NS_CBT_END
\ No newline at end of file
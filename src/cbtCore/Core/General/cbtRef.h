@@ -7,6 +7,7 @@
 // Include STD
 #include <vector>
 #include <mutex>
+#include <atomic>
 
 NS_CBT_BEGIN
 
@@ -17,28 +18,67 @@ NS_CBT_BEGIN
         The starting value of the reference counter upon creation is 1, but AutoRelease() is called immediately.
         Use Retain() to prevent deletion of the object.
         When using CBTManaged, do not call it's destructor. Use Retain() and Release() to manage the deletion of the object.
-        You can also delay the deletion of the object using AutoRelease(). When AutoRelease() is called, the object reference count
-        of the object is decreased, but it will only be checked for deletion when ClearReleasePool() is called.
+        You can also delay the deletion of the object using AutoRelease(). When AutoRelease() is called, the object is added to
+        the calling thread's release pool, and its reference count is only decreased when ClearReleasePool() is called.
+        The reference count is atomic, and each thread has its own release pool, so neither needs a global lock.
  */
     class cbtManaged
     {
     private:
-        /// The maximum size of the auto release pool.
-        static constexpr cbtU32 MAX_POOL_SIZE = 65536;
-        /// The buffer containing the CBTMananged objects that have called AutoRelease().
-        static cbtManaged* s_Buffer[MAX_POOL_SIZE * 2];
-        /// The index in s_Buffer where the array of pointers of CBTManaged pointer to be checked for deletion starts.
-        static cbtU32 s_ReleaseStart;
-        /// The number of CBTManaged objects to be checked for deletion.
-        static cbtU32 s_ReleaseCount;
-
-        /// Mutex for checking and deleting CBTManaged objects.
-        static std::mutex s_ReleaseMutex;
-        /// Mutex for checking and deleting CBTManaged objects.
+        /**
+            \brief
+                A growable release pool owned by a single thread. It is registered when the thread first calls AutoRelease().
+                When the thread exits, any objects left in its pool are handed over to be released by the next ClearReleasePool().
+        */
+        struct ReleasePool
+        {
+            /// Mutex for m_Objects. It is only contended while ClearReleasePool() is draining the pool.
+            std::mutex m_Mutex;
+            /// The objects which have called AutoRelease() on this thread.
+            std::vector<cbtManaged*> m_Objects;
+
+            ReleasePool();
+
+            ~ReleasePool();
+        };
+
+        /// The release pools of every thread, and the objects left behind by threads which have exited.
+        struct ReleasePoolRegistry
+        {
+            /// Mutex for m_Pools and m_OrphanedObjects.
+            std::mutex m_Mutex;
+            /// The release pools of every thread.
+            std::vector<ReleasePool*> m_Pools;
+            /// The objects left in the release pools of threads which have exited.
+            std::vector<cbtManaged*> m_OrphanedObjects;
+        };
+
+        /// Mutex for ClearReleasePool(), so that only one thread drains the release pools at a time.
         static std::mutex s_ClearMutex;
 
+        /// If true, objects created on this thread do not call AutoRelease() in their constructor. \sa DeferAutoReleaseScope
+        static thread_local cbtBool s_DeferAutoRelease;
+#ifndef NDEBUG
+        /// The number of objects created on this thread while s_DeferAutoRelease was true, so that DeferAutoReleaseScope can check what was created in it.
+        static thread_local cbtU32 s_DeferredCount;
+#endif
+
         /// The reference count of this object. The starting value of m_RefCount upon creation is 1.
-        cbtS32 m_RefCount = 1;
+        std::atomic<cbtS32> m_RefCount { 1 };
+
+        /**
+            \brief Get the registry of release pools. It is a function local static so that it exists before any thread's pool.
+
+            \return The registry of release pools.
+        */
+        static ReleasePoolRegistry& GetReleasePoolRegistry();
+
+        /**
+            \brief Get the calling thread's release pool.
+
+            \return The calling thread's release pool.
+        */
+        static ReleasePool& GetReleasePool();
 
     protected:
         /**
@@ -48,7 +88,12 @@ NS_CBT_BEGIN
         */
         cbtManaged()
         {
-            AutoRelease();
+            if (!s_DeferAutoRelease)
+            { AutoRelease(); }
+#ifndef NDEBUG
+            else
+            { ++s_DeferredCount; }
+#endif
         }
 
         /**
@@ -66,7 +111,7 @@ NS_CBT_BEGIN
         */
         void Retain()
         {
-            ++m_RefCount;
+            m_RefCount.fetch_add(1, std::memory_order_relaxed);
         }
 
         /**
@@ -76,61 +121,90 @@ NS_CBT_BEGIN
         */
         void Release()
         {
-            CBT_ASSERT(m_RefCount > 0);
-            --m_RefCount;
-            if (m_RefCount == 0)
+            cbtS32 refCount = m_RefCount.fetch_sub(1, std::memory_order_acq_rel);
+            CBT_ASSERT(refCount > 0);
+            if (refCount == 1)
             {
                 delete this;
             }
         }
 
         /**
-            \brief Decrease the reference count by 1. Add it to the release pool where it will be checked for deletion upon calling ClearReleasePool().
+            \brief Add it to the calling thread's release pool. Its reference count will be decreased by 1 upon calling ClearReleasePool().
 
             \sa Retain, Release
         */
-        void AutoRelease()
-        {
-            CBT_ASSERT(m_RefCount > 0);
-            std::lock_guard<std::mutex> releaseLock(s_ReleaseMutex);
-            s_Buffer[s_ReleaseStart + s_ReleaseCount] = this;
-            ++s_ReleaseCount;
-        }
+        void AutoRelease();
+
+        /**
+            \brief Add several objects to the calling thread's release pool at once, locking it only once.
+
+            \param _objects The objects.
+            \param _count The number of objects.
+
+            \sa AutoRelease()
+        */
+        static void AutoRelease(cbtManaged* const* _objects, cbtU32 _count);
 
         /**
-            \brief Checks all the objects that have been added to the release pool. If their reference count is 0, delete them.
+            \brief
+                Stops objects created on the calling thread calling AutoRelease() in their constructor until it goes out of scope, then restores the previous setting.
+                While it is in scope, whoever creates an object must auto-release it, so that a batch of new objects can be passed to AutoRelease(_objects, _count) together.
+                Only create objects whose constructors do not create other cbtManaged objects while it is in scope, or those will never be released.
         */
-        static void ClearReleasePool()
+        class DeferAutoReleaseScope
         {
-            // There is a chance that the deletion of objects will trigger more objects to be released for deletion.
-            // Therefore this will loop till there is nothing left to delete.
-            while (true)
+        private:
+            const cbtBool m_PreviousDefer;
+#ifndef NDEBUG
+            const cbtU32 m_StartCount;
+#endif
+
+        public:
+            DeferAutoReleaseScope()
+                    :m_PreviousDefer(s_DeferAutoRelease)
+#ifndef NDEBUG
+                    , m_StartCount(s_DeferredCount)
+#endif
             {
-                std::lock_guard<std::mutex> clearLock(s_ClearMutex);
-                std::unique_lock<std::mutex> releaseLock(s_ReleaseMutex);
-
-                // We do this swap in case at any point during the deletion of Refs, more are added to the release pool.
-                cbtU32 clearCount = s_ReleaseCount;
-                cbtU32 clearStart = s_ReleaseStart;
-
-                s_ReleaseStart = (s_ReleaseStart + MAX_POOL_SIZE) % (MAX_POOL_SIZE * 2);
-                s_ReleaseCount = 0;
-
-                releaseLock.unlock();
-
-                // If there is nothing to clear, stop the loop.
-                if (clearCount == 0)
-                { break; }
-                for (cbtU32 i = 0; i < clearCount; ++i)
-                {
-                    if (s_Buffer[clearStart + i]->m_RefCount <= 0)
-                    {
-                        s_Buffer[clearStart + i]->Release();
-                        s_Buffer[clearStart + i] = nullptr;
-                    }
-                }
+                s_DeferAutoRelease = true;
             }
+
+            ~DeferAutoReleaseScope()
+            {
+                s_DeferAutoRelease = m_PreviousDefer;
+            }
+
+            DeferAutoReleaseScope(const DeferAutoReleaseScope&) = delete;
+            DeferAutoReleaseScope& operator=(const DeferAutoReleaseScope&) = delete;
+
+#ifndef NDEBUG
+            /**
+                \brief Get the number of objects created on the calling thread since this scope began. Only available in debug builds, to check that nothing unexpected was created.
+
+                \return The number of objects created since this scope began.
+            */
+            inline cbtU32 GetCreatedCount() const
+            {
+                return s_DeferredCount - m_StartCount;
+            }
+#endif
+        };
+
+        /**
+            \brief Get the reference count. This includes references which are pending in a release pool.
+
+            \return The reference count.
+        */
+        inline cbtS32 GetRefCount() const
+        {
+            return m_RefCount.load(std::memory_order_relaxed);
         }
+
+        /**
+            \brief Releases all the objects that have been added to the release pools of every thread. If their reference count reaches 0, they are deleted.
+        */
+        static void ClearReleasePool();
     };
 
 /**
@@ -161,6 +235,19 @@ NS_CBT_BEGIN
             { m_Managed->Retain(); }
         }
 
+        /**
+            \brief Move Constructor. Take over _other's reference without changing the reference count.
+
+            \param _other The CBTRef to move from. It no longer points to anything afterwards.
+
+            \return A CBTRef pointing to the object _other was pointing to.
+        */
+        cbtRef(cbtRef&& _other) noexcept
+                :m_Managed(_other.m_Managed)
+        {
+            _other.m_Managed = nullptr;
+        }
+
         /**
             \brief Constructor
 
@@ -241,6 +328,26 @@ NS_CBT_BEGIN
             return { *this };
         }
 
+        /**
+            \brief Take over _other's reference without changing the new pointed object's reference count.
+            The current pointed object's reference count is decreased by 1.
+
+            \param _other The CBTRef to move from. It no longer points to anything afterwards.
+
+            \return The current CBTRef object.
+        */
+        cbtRef<T>& operator=(cbtRef&& _other) noexcept
+        {
+            if (this != &_other)
+            {
+                if (m_Managed)
+                { m_Managed->AutoRelease(); }
+                m_Managed = _other.m_Managed;
+                _other.m_Managed = nullptr;
+            }
+            return { *this };
+        }
+
         /**
             \brief Point to a new CBTManaged object.
             The new pointed object's reference count is increased by 1.
@@ -308,7 +415,7 @@ NS_CBT_BEGIN
         */
         cbtBool operator==(const void* _managed) const
         {
-            return m_Managed == static_cast<T*>(_managed);
+            return m_Managed == static_cast<const T*>(_managed);
         }
 
         /**
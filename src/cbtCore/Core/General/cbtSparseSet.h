@@ -4,6 +4,7 @@
 #include "Debug/cbtDebug.h"
 
 // Include STD
+#include <algorithm>
 #include <vector>
 #include <utility>
 #include <cstring>
@@ -30,8 +31,11 @@ NS_CBT_BEGIN
            The elements of the sparse array is the items in the sparse array. It must be in the same order as the Dense Index Array
            so that the item can be retrieved correctly.
 
-        Since the sparse array may be quite large, we page it instead. This means that instead of a large 1D array, we have a 2D array of size PAGE_COUNT by PARAGRAPH_COUNT.
-        If a page does not need to store any indices, we can delete it to save memory. Each element of a "page" is referred to as a "paragraph".
+        Since the sparse array may be quite large, we page it instead. This means that instead of a large 1D array, we have a 2D array of up to PAGE_COUNT by PARAGRAPH_COUNT.
+        The array of pages only grows as far as the highest page in use, so PAGE_COUNT can be large.
+        If a page does not need to store any indices, it is put in a free list to be reused, rather than deleted and allocated again. Each element of a "page" is referred to as a "paragraph".
+
+        The order of the dense arrays can be changed with Sort and SortAs, so that items used together can be iterated over in the same order.
 */
     template<class T, cbtU32 PAGE_COUNT, cbtU32 PARAGRAPH_COUNT>
     class cbtSparseSet
@@ -41,9 +45,58 @@ NS_CBT_BEGIN
         /// Dense Index Array
         std::vector<cbtS32> m_Dense;
         /// Sparse Array
-        cbtS32* m_Sparse[PAGE_COUNT] = { 0 };
-        /// An array containing the number of paragraphs in each page. Helps us keep track of when a page is empty so we can delete it to save memory.
-        cbtS32 m_ParagraphCounter[PAGE_COUNT] = { 0 };
+        std::vector<cbtS32*> m_Sparse;
+        /// An array containing the number of paragraphs in each page. Helps us keep track of when a page is empty so we can reuse it.
+        std::vector<cbtS32> m_ParagraphCounter;
+        /// Pages which are no longer used, kept to be reused by the next page that is needed.
+        std::vector<cbtS32*> m_FreePages;
+
+        /**
+            \brief Get a page with every paragraph set to -1, reusing a free page if there is one.
+
+            \return The page.
+        */
+        cbtS32* CreatePage()
+        {
+            cbtS32* page = nullptr;
+            if (m_FreePages.empty())
+            { page = cbtNew cbtS32[PARAGRAPH_COUNT]; }
+            else
+            {
+                page = m_FreePages.back();
+                m_FreePages.pop_back();
+            }
+            std::memset(page, -1, sizeof(cbtS32) * PARAGRAPH_COUNT);
+            return page;
+        }
+
+        /**
+            \brief Set the dense index stored in m_Sparse for an index.
+
+            \param _index The index.
+            \param _denseIndex The position of the index's item in the dense arrays.
+        */
+        inline void SetDenseIndex(cbtS32 _index, cbtS32 _denseIndex)
+        {
+            m_Sparse[GetPage(_index)][GetParagraph(_index)] = _denseIndex;
+        }
+
+        /**
+            \brief Swap the positions of two items in the dense arrays.
+
+            \param _denseA The position of the first item.
+            \param _denseB The position of the second item.
+        */
+        void SwapDense(cbtS32 _denseA, cbtS32 _denseB)
+        {
+            if (_denseA == _denseB)
+            { return; }
+
+            std::swap(m_Items[_denseA], m_Items[_denseB]);
+            std::swap(m_Dense[_denseA], m_Dense[_denseB]);
+            SetDenseIndex(m_Dense[_denseA], _denseA);
+            SetDenseIndex(m_Dense[_denseB], _denseB);
+        }
 
         /**
             \brief Given an index, find out which page (row) it is in.
@@ -88,23 +141,38 @@ NS_CBT_BEGIN
         ~cbtSparseSet()
         {
             Clear();
+            for (cbtU32 i = 0; i < m_FreePages.size(); ++i)
+            { delete[] m_FreePages[i]; }
         }
 
+        cbtSparseSet(const cbtSparseSet&) = delete;
+        cbtSparseSet& operator=(const cbtSparseSet&) = delete;
+
         /**
-            \brief Clear the sparse set. All items are destroyed.
+            \brief Clear the sparse set. All items are destroyed, and the pages are kept to be reused.
         */
         void Clear()
         {
             m_Items.clear();
             m_Dense.clear();
-            for (cbtU32 i = 0; i < PAGE_COUNT; ++i)
+            for (cbtU32 i = 0; i < m_Sparse.size(); ++i)
             {
                 if (m_Sparse[i])
-                { delete[] m_Sparse[i]; }
-                m_Sparse[i] = nullptr;
+                { m_FreePages.push_back(m_Sparse[i]); }
             }
+            m_Sparse.clear();
+            m_ParagraphCounter.clear();
+        }
+
+        /**
+            \brief Reserve space for a number of items, so that inserting up to that many items does not reallocate the dense arrays.
 
-            std::memset(m_ParagraphCounter, 0, sizeof(m_ParagraphCounter));
+            \param _count The number of items to reserve space for.
+        */
+        void Reserve(cbtU32 _count)
+        {
+            m_Items.reserve(_count);
+            m_Dense.reserve(_count);
         }
 
         /**
@@ -133,35 +201,62 @@ NS_CBT_BEGIN
 
             cbtS32 page = GetPage(_index);
             cbtS32 paragraph = GetParagraph(_index);
-            return m_Sparse[page] ? (m_Sparse[page][paragraph] != -1) : false;
+            return (page < (cbtS32)m_Sparse.size() && m_Sparse[page]) ? (m_Sparse[page][paragraph] != -1) : false;
         }
 
         /**
-            \brief Insert an item at the given index.
+            \brief Construct an item in place at the given index.
 
             \param _index The index to insert the item.
-            \param _item The item to insert.
+            \param _args The arguments to construct the item with.
+
+            \return The inserted item.
         */
-        void Insert(cbtS32 _index, T& _item)
+        template<typename ...Args>
+        T& Emplace(cbtS32 _index, Args&& ... _args)
         {
             CBT_ASSERT(IsValid(_index));
             CBT_ASSERT(!Has(_index));
 
             cbtS32 page = GetPage(_index);
-            cbtS32 paragraph = GetParagraph(_index);
 
             // Create the page if it does not exist.
-            if (!m_Sparse[page])
+            if (page >= (cbtS32)m_Sparse.size())
             {
-                m_Sparse[page] = cbtNew cbtS32[PARAGRAPH_COUNT];
-                std::memset(m_Sparse[page], -1, sizeof(cbtS32) * PARAGRAPH_COUNT);
+                m_Sparse.resize(page + 1, nullptr);
+                m_ParagraphCounter.resize(page + 1, 0);
             }
+            if (!m_Sparse[page])
+            { m_Sparse[page] = CreatePage(); }
 
             // Add the item to m_Items. Ensure that m_Dense is kept in sync.
-            m_Items.push_back(_item);
+            m_Items.emplace_back(std::forward<Args>(_args)...);
             m_Dense.push_back(_index);
-            m_Sparse[page][paragraph] = static_cast<cbtS32>(m_Dense.size() - 1);
+            SetDenseIndex(_index, static_cast<cbtS32>(m_Dense.size() - 1));
             ++m_ParagraphCounter[page];
+            return m_Items.back();
+        }
+
+        /**
+            \brief Insert an item at the given index.
+
+            \param _index The index to insert the item.
+            \param _item The item to insert.
+        */
+        void Insert(cbtS32 _index, const T& _item)
+        {
+            Emplace(_index, _item);
+        }
+
+        /**
+            \brief Insert an item at the given index.
+
+            \param _index The index to insert the item.
+            \param _item The item to move into the sparse set.
+        */
+        void Insert(cbtS32 _index, T&& _item)
+        {
+            Emplace(_index, std::move(_item));
         }
 
         /**
@@ -179,28 +274,86 @@ NS_CBT_BEGIN
             cbtS32 denseIndex = m_Sparse[removePage][removeParagraph];
             m_Sparse[removePage][removeParagraph] = -1;
 
-            // Overwrite the item we are removing with the last item in the dense array.
-            m_Items[denseIndex] = m_Items.back();
-            m_Dense[denseIndex] = m_Dense.back();
-            // Delete the last item since we've already moved it.
+            // Move the last item in the dense array into the hole, and update its dense index in m_Sparse.
+            cbtS32 lastIndex = static_cast<cbtS32>(m_Dense.size() - 1);
+            if (denseIndex != lastIndex)
+            {
+                m_Items[denseIndex] = std::move(m_Items[lastIndex]);
+                m_Dense[denseIndex] = m_Dense[lastIndex];
+                SetDenseIndex(m_Dense[denseIndex], denseIndex);
+            }
             m_Items.pop_back();
             m_Dense.pop_back();
 
-            // Since we've moved the last item, we need to update it's dense index in m_Sparse.
-            cbtS32 sparseIndex = m_Dense[denseIndex];
-            cbtS32 lastPage = GetPage(sparseIndex);
-            cbtS32 lastParagraph = GetParagraph(sparseIndex);
-            m_Sparse[lastPage][lastParagraph] = denseIndex;
-
-            // If a page of m_Sparse is empty, delete it.
+            // If a page of m_Sparse is empty, keep it to be reused.
             --m_ParagraphCounter[removePage];
             if (m_ParagraphCounter[removePage] == 0)
             {
-                delete[] m_Sparse[removePage];
+                m_FreePages.push_back(m_Sparse[removePage]);
                 m_Sparse[removePage] = nullptr;
             }
         }
 
+        /**
+            \brief Sort the items in place. The index of every item is unchanged, only their order in the dense arrays.
+
+            \param _compare A function which returns true if its first item should come before its second item.
+        */
+        template<typename Compare>
+        void Sort(Compare _compare)
+        {
+            // Sort the positions of the items, then move each item to its sorted position, following each cycle of the permutation.
+            std::vector<cbtS32> order(m_Items.size());
+            for (cbtU32 i = 0; i < order.size(); ++i)
+            { order[i] = (cbtS32)i; }
+            std::sort(order.begin(), order.end(), [this, &_compare](cbtS32 _a, cbtS32 _b) { return _compare(m_Items[_a], m_Items[_b]); });
+
+            for (cbtS32 i = 0; i < (cbtS32)order.size(); ++i)
+            {
+                if (order[i] == i)
+                { continue; }
+
+                T item = std::move(m_Items[i]);
+                cbtS32 index = m_Dense[i];
+                cbtS32 current = i;
+                while (order[current] != i)
+                {
+                    cbtS32 next = order[current];
+                    m_Items[current] = std::move(m_Items[next]);
+                    m_Dense[current] = m_Dense[next];
+                    order[current] = current;
+                    current = next;
+                }
+                m_Items[current] = std::move(item);
+                m_Dense[current] = index;
+                order[current] = current;
+            }
+
+            for (cbtU32 i = 0; i < m_Dense.size(); ++i)
+            { SetDenseIndex(m_Dense[i], (cbtS32)i); }
+        }
+
+        /**
+            \brief
+                Reorder the items to follow the order of the indices in another sparse set.
+                The items whose index is in _other come first, in the same order as in _other, followed by the rest.
+                Iterating over both sparse sets together is then linear in memory.
+
+            \param _other The sparse set whose order to follow.
+        */
+        template<typename U>
+        void SortAs(const cbtSparseSet<U, PAGE_COUNT, PARAGRAPH_COUNT>& _other)
+        {
+            const cbtS32* otherIndices = _other.GetIndexArray();
+            cbtS32 position = 0;
+            for (cbtU32 i = 0; i < _other.GetCount(); ++i)
+            {
+                if (!Has(otherIndices[i]))
+                { continue; }
+                SwapDense(position++, m_Sparse[GetPage(otherIndices[i])][GetParagraph(otherIndices[i])]);
+            }
+        }
+
         /**
             \brief Get the number of items currently in the sparse set.
 
@@ -211,6 +364,29 @@ NS_CBT_BEGIN
             return static_cast<cbtU32>(m_Items.size());
         }
 
+        /**
+            \brief Get the position of an index's item in the dense arrays.
+
+            \param _index The index of the item.
+
+            \return The position of the item in the array returned by GetArray.
+        */
+        inline cbtS32 GetDenseIndex(cbtS32 _index) const
+        {
+            CBT_ASSERT(Has(_index));
+            return m_Sparse[GetPage(_index)][GetParagraph(_index)];
+        }
+
+        /**
+            \brief Get a pointer to the dense index array, which holds the index of each item in the dense item array.
+
+            \return A pointer to the dense index array.
+        */
+        const cbtS32* GetIndexArray() const
+        {
+            return m_Dense.empty() ? nullptr : &m_Dense[0];
+        }
+
         /**
             \brief Get a pointer to the dense item array.
 
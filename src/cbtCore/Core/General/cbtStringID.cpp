@@ -0,0 +1,39 @@
+// Include CBT
+#include "cbtStringID.h"
+#include "Debug/cbtDebug.h"
+
+NS_CBT_BEGIN
+
+    std::unordered_map<cbtStrID, cbtStr> cbtStringTable::s_Strings;
+    std::mutex cbtStringTable::s_Mutex;
+
+    cbtStrID cbtStringTable::Intern(const cbtStr& _string)
+    {
+        cbtStrID id = cbtHashString(_string);
+        CBT_ASSERT(id != CBT_INVALID_STR_ID);
+
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        auto iter = s_Strings.find(id);
+        if (iter == s_Strings.end())
+        {
+            s_Strings.insert(std::pair<cbtStrID, cbtStr>(id, _string));
+        }
+        else if (iter->second != _string)
+        {
+            CBT_LOG_ERROR(CBT_LOG_CATEGORY_APPLICATION, "String ID collision between %s and %s!", iter->second.c_str(),
+                    _string.c_str());
+            CBT_ASSERT(false);
+        }
+        return id;
+    }
+
+    const cbtStr& cbtStringTable::GetString(cbtStrID _id)
+    {
+        static const cbtStr emptyString;
+
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        auto iter = s_Strings.find(_id);
+        return iter == s_Strings.end() ? emptyString : iter->second;
+    }
+
+NS_CBT_END
\ No newline at end of file
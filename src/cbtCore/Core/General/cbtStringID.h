@@ -0,0 +1,128 @@
+#pragma once
+
+// Include CBT
+#include "cbtMacros.h"
+
+// Include STD
+#include <type_traits>
+#include <unordered_map>
+#include <mutex>
+
+NS_CBT_BEGIN
+
+/// Represents an Invalid cbtStrID.
+#define CBT_INVALID_STR_ID 0ULL
+/// The 64-bit FNV-1a offset basis.
+#define CBT_FNV_OFFSET_BASIS 14695981039346656037ULL
+/// The 64-bit FNV-1a prime.
+#define CBT_FNV_PRIME 1099511628211ULL
+
+    /// A 64-bit hash identifying a string. Two equal strings always have the same cbtStrID, across runs and builds.
+    typedef cbtU64 cbtStrID;
+
+    /**
+        \brief Hash bytes using 64-bit FNV-1a. Unlike std::hash, the result is the same across runs and builds, so it can be stored on disk.
+
+        \param _data The bytes to hash.
+        \param _length The number of bytes to hash.
+        \param _hash The hash to continue from. This allows multiple strings to be hashed together.
+
+        \return The hash of the bytes.
+    */
+    constexpr cbtU64 cbtHashFNV1a(const cbtS8* _data, size_t _length, cbtU64 _hash = CBT_FNV_OFFSET_BASIS)
+    {
+        for (size_t i = 0; i < _length; ++i)
+        {
+            _hash ^= (cbtU8)_data[i];
+            _hash *= CBT_FNV_PRIME;
+        }
+        return _hash;
+    }
+
+    /**
+        \brief Get the cbtStrID of a null terminated string. Can be evaluated at compile time.
+
+        \param _string The string to hash.
+
+        \return The cbtStrID of _string.
+
+        \sa CBT_STR_ID
+    */
+    constexpr cbtStrID cbtHashString(const cbtS8* _string)
+    {
+        size_t length = 0;
+        while (_string[length] != '\0')
+        { ++length; }
+        return cbtHashFNV1a(_string, length);
+    }
+
+    /**
+        \brief Get the cbtStrID of a string. Does not allocate or intern the string.
+
+        \param _string The string to hash.
+
+        \return The cbtStrID of _string.
+    */
+    inline cbtStrID cbtHashString(const cbtStr& _string)
+    {
+        return cbtHashFNV1a(_string.data(), _string.size());
+    }
+
+/**
+    \brief Get the cbtStrID of a string literal at compile time.
+
+    Example:\n
+    \code{.cpp}
+    cbtMaterial* material = library->GetItem(CBT_STR_ID("Brick Wall Material"));
+    \endcode
+*/
+#define CBT_STR_ID(__STRING__) (std::integral_constant<NS_CBT::cbtStrID, NS_CBT::cbtHashString(__STRING__)>::value)
+
+    /**
+        \brief
+            A global table of interned strings. Interning a string returns its cbtStrID, and records the string so that
+            it can be looked up from its cbtStrID for debugging and logging. Collisions are detected when a string is interned.
+    */
+    class cbtStringTable
+    {
+    private:
+        /// The interned strings.
+        static std::unordered_map<cbtStrID, cbtStr> s_Strings;
+        /// Mutex for s_Strings, as resources may be named on any thread.
+        static std::mutex s_Mutex;
+
+        /**
+            \brief Private Constructor. All functions should be static. No objects of this class should be created.
+        */
+        cbtStringTable()
+        {
+        }
+
+        /**
+            \brief Private Destructor. All functions should be static. No objects of this class should be created.
+        */
+        ~cbtStringTable()
+        {
+        }
+
+    public:
+        /**
+            \brief Intern a string.
+
+            \param _string The string to intern.
+
+            \return The cbtStrID of _string.
+        */
+        static cbtStrID Intern(const cbtStr& _string);
+
+        /**
+            \brief Get an interned string from its cbtStrID.
+
+            \param _id The cbtStrID of the string.
+
+            \return The interned string. If no string with cbtStrID _id has been interned, an empty string is returned.
+        */
+        static const cbtStr& GetString(cbtStrID _id);
+    };
+
+NS_CBT_END
\ No newline at end of file
@@ -3,6 +3,7 @@
 // Include CBT
 #include "cbtMatrix.h"
 #include "cbtVector3.h"
+#include "Debug/cbtDebug.h"
 
 NS_CBT_BEGIN
 
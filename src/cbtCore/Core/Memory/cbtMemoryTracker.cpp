@@ -0,0 +1,424 @@
+// Include CBT
+#include "cbtMemoryTracker.h"
+
+#ifdef CBT_MEMORY_TRACKING
+
+#include "Debug/cbtDebug.h"
+#include "Core/FileUtil/cbtFileUtil.h"
+
+// Include STD
+#include <cstdlib>
+#include <cstdio>
+#include <new>
+#include <mutex>
+#include <unordered_map>
+#include <algorithm>
+
+NS_CBT_BEGIN
+
+    /// The header placed in front of every allocation.
+    struct cbtAllocationHeader
+    {
+        /// The size requested, excluding the header.
+        size_t m_Size;
+        /// The index of the record the allocation belongs to, or UNTRACKED.
+        cbtU32 m_RecordIndex;
+        /// Used to detect blocks which were not allocated by cbtMemoryTracker.
+        cbtU32 m_Magic;
+    };
+
+    /// The header is padded to the default new alignment, so that the block after it is still suitably aligned.
+    static constexpr size_t HEADER_SIZE = (sizeof(cbtAllocationHeader) + __STDCPP_DEFAULT_NEW_ALIGNMENT__ - 1) /
+            __STDCPP_DEFAULT_NEW_ALIGNMENT__ * __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+    static constexpr cbtU32 HEADER_MAGIC = 0xCB7A110C;
+    /// The record index of allocations made by the tracker itself.
+    static constexpr cbtU32 UNTRACKED = 0xFFFFFFFF;
+    /// The maximum depth of CBT_MEMORY_TAG on a single thread. Deeper tags are recorded under the deepest one that fits.
+    static constexpr cbtU32 MAX_TAG_DEPTH = 32;
+
+    /// The key of a cbtMemoryRecord.
+    struct cbtMemoryRecordKey
+    {
+        const cbtS8* m_Tag;
+        const cbtS8* m_File;
+        cbtS32 m_Line;
+
+        cbtBool operator==(const cbtMemoryRecordKey& _other) const
+        {
+            return m_Tag == _other.m_Tag && m_File == _other.m_File && m_Line == _other.m_Line;
+        }
+    };
+
+    struct cbtMemoryRecordKeyHash
+    {
+        size_t operator()(const cbtMemoryRecordKey& _key) const
+        {
+            size_t hash = std::hash<const void*>()(_key.m_Tag);
+            hash ^= std::hash<const void*>()(_key.m_File) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+            hash ^= std::hash<cbtS32>()(_key.m_Line) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+            return hash;
+        }
+    };
+
+    /// The state of cbtMemoryTracker.
+    struct cbtMemoryTrackerState
+    {
+        std::mutex m_Mutex;
+        std::vector<cbtMemoryRecord> m_Records;
+        std::unordered_map<cbtMemoryRecordKey, cbtU32, cbtMemoryRecordKeyHash> m_RecordIndices;
+        cbtMemoryStats m_Stats;
+        /// The number of allocations made since the last EndFrame().
+        cbtU64 m_FrameAllocations = 0;
+        /// The number of bytes allocated since the last EndFrame().
+        cbtU64 m_FrameBytes = 0;
+        /// The total number of allocations made in every ended frame.
+        cbtU64 m_EndedFrameAllocations = 0;
+        /// The total number of bytes allocated in every ended frame.
+        cbtU64 m_EndedFrameBytes = 0;
+    };
+
+    /// If true, allocations on this thread are made by the tracker itself and are not recorded.
+    static thread_local cbtBool s_Untracked = false;
+    static thread_local const cbtS8* s_Tags[MAX_TAG_DEPTH];
+    static thread_local cbtU32 s_TagDepth = 0;
+
+    /// Stops allocations on this thread from being recorded till it is destroyed.
+    class cbtUntrackedScope
+    {
+    private:
+        cbtBool m_WasUntracked;
+
+    public:
+        cbtUntrackedScope()
+                :m_WasUntracked(s_Untracked)
+        {
+            s_Untracked = true;
+        }
+
+        ~cbtUntrackedScope()
+        {
+            s_Untracked = m_WasUntracked;
+        }
+    };
+
+    /**
+        \brief
+            Get the state of cbtMemoryTracker. It is created on the first allocation, which may be before any static initialisation,
+            and is intentionally never destroyed, so that memory can still be freed during static destruction.
+
+        \return The state of cbtMemoryTracker.
+    */
+    static cbtMemoryTrackerState& GetState()
+    {
+        static cbtMemoryTrackerState* state = []()
+        {
+            cbtUntrackedScope untrackedScope;
+            return new (std::malloc(sizeof(cbtMemoryTrackerState))) cbtMemoryTrackerState();
+        }();
+        return *state;
+    }
+
+    /**
+        \brief Get the index of the record for a tag and call site, creating it if it does not exist. The state's mutex must be locked.
+
+        \return The index of the record.
+    */
+    static cbtU32 GetRecordIndex(cbtMemoryTrackerState& _state, const cbtS8* _tag, const cbtS8* _file, cbtS32 _line)
+    {
+        cbtMemoryRecordKey key { _tag, _file, _line };
+        auto iter = _state.m_RecordIndices.find(key);
+        if (iter != _state.m_RecordIndices.end())
+        { return iter->second; }
+
+        cbtUntrackedScope untrackedScope;
+        cbtMemoryRecord record;
+        record.m_Tag = _tag;
+        record.m_File = _file;
+        record.m_Line = _line;
+        _state.m_Records.push_back(record);
+        _state.m_RecordIndices.insert(std::pair<cbtMemoryRecordKey, cbtU32>(key, (cbtU32)_state.m_Records.size() - 1));
+        return (cbtU32)_state.m_Records.size() - 1;
+    }
+
+    void* cbtMemoryTracker::Allocate(size_t _size, const cbtS8* _file, cbtS32 _line)
+    {
+        cbtByte* block = static_cast<cbtByte*>(std::malloc(HEADER_SIZE + (_size ? _size : 1)));
+        if (!block)
+        { throw std::bad_alloc(); }
+
+        cbtAllocationHeader* header = reinterpret_cast<cbtAllocationHeader*>(block);
+        header->m_Size = _size;
+        header->m_RecordIndex = UNTRACKED;
+        header->m_Magic = HEADER_MAGIC;
+
+        if (!s_Untracked)
+        {
+            cbtMemoryTrackerState& state = GetState();
+            const cbtS8* tag = s_TagDepth ? s_Tags[std::min(s_TagDepth, MAX_TAG_DEPTH) - 1] : nullptr;
+
+            std::lock_guard<std::mutex> lock(state.m_Mutex);
+            header->m_RecordIndex = GetRecordIndex(state, tag, _file, _line);
+
+            cbtMemoryRecord& record = state.m_Records[header->m_RecordIndex];
+            record.m_LiveBytes += _size;
+            ++record.m_LiveCount;
+            record.m_HighWaterBytes = std::max(record.m_HighWaterBytes, record.m_LiveBytes);
+            record.m_TotalBytes += _size;
+            ++record.m_TotalCount;
+
+            state.m_Stats.m_LiveBytes += _size;
+            ++state.m_Stats.m_LiveCount;
+            state.m_Stats.m_HighWaterBytes = std::max(state.m_Stats.m_HighWaterBytes, state.m_Stats.m_LiveBytes);
+            state.m_FrameBytes += _size;
+            ++state.m_FrameAllocations;
+        }
+
+        return block + HEADER_SIZE;
+    }
+
+    void cbtMemoryTracker::Deallocate(void* _block)
+    {
+        if (!_block)
+        { return; }
+
+        cbtByte* block = static_cast<cbtByte*>(_block) - HEADER_SIZE;
+        cbtAllocationHeader* header = reinterpret_cast<cbtAllocationHeader*>(block);
+        CBT_ASSERT(header->m_Magic == HEADER_MAGIC);
+
+        if (header->m_RecordIndex != UNTRACKED)
+        {
+            cbtMemoryTrackerState& state = GetState();
+            std::lock_guard<std::mutex> lock(state.m_Mutex);
+
+            cbtMemoryRecord& record = state.m_Records[header->m_RecordIndex];
+            record.m_LiveBytes -= header->m_Size;
+            --record.m_LiveCount;
+            state.m_Stats.m_LiveBytes -= header->m_Size;
+            --state.m_Stats.m_LiveCount;
+        }
+
+        header->m_Magic = 0;
+        std::free(block);
+    }
+
+    void cbtMemoryTracker::PushTag(const cbtS8* _tag)
+    {
+        if (s_TagDepth < MAX_TAG_DEPTH)
+        { s_Tags[s_TagDepth] = _tag; }
+        ++s_TagDepth;
+    }
+
+    void cbtMemoryTracker::PopTag()
+    {
+        CBT_ASSERT(s_TagDepth > 0);
+        --s_TagDepth;
+    }
+
+    void cbtMemoryTracker::EndFrame()
+    {
+        cbtMemoryTrackerState& state = GetState();
+        std::lock_guard<std::mutex> lock(state.m_Mutex);
+
+        cbtMemoryStats& stats = state.m_Stats;
+        ++stats.m_FrameCount;
+        stats.m_LastFrameAllocations = state.m_FrameAllocations;
+        stats.m_LastFrameBytes = state.m_FrameBytes;
+        stats.m_MaxFrameAllocations = std::max(stats.m_MaxFrameAllocations, state.m_FrameAllocations);
+        state.m_EndedFrameAllocations += state.m_FrameAllocations;
+        state.m_EndedFrameBytes += state.m_FrameBytes;
+        stats.m_AverageFrameAllocations = (cbtF64)state.m_EndedFrameAllocations / (cbtF64)stats.m_FrameCount;
+        stats.m_AverageFrameBytes = (cbtF64)state.m_EndedFrameBytes / (cbtF64)stats.m_FrameCount;
+
+        state.m_FrameAllocations = 0;
+        state.m_FrameBytes = 0;
+    }
+
+    cbtMemoryStats cbtMemoryTracker::GetStats()
+    {
+        cbtMemoryTrackerState& state = GetState();
+        std::lock_guard<std::mutex> lock(state.m_Mutex);
+        return state.m_Stats;
+    }
+
+    std::vector<cbtMemoryRecord> cbtMemoryTracker::GetRecords()
+    {
+        cbtMemoryTrackerState& state = GetState();
+        // The copy must not be recorded, as the mutex is already locked.
+        cbtUntrackedScope untrackedScope;
+        std::lock_guard<std::mutex> lock(state.m_Mutex);
+        return state.m_Records;
+    }
+
+    void cbtMemoryTracker::Dump(cbtU32 _maxRecords)
+    {
+        cbtMemoryStats stats = GetStats();
+        CBT_LOG_INFO(CBT_LOG_CATEGORY_APPLICATION, "Memory: %llu bytes in %llu allocations live, high water %llu bytes.",
+                stats.m_LiveBytes, stats.m_LiveCount, stats.m_HighWaterBytes);
+        CBT_LOG_INFO(CBT_LOG_CATEGORY_APPLICATION,
+                "Memory: %llu frames, last frame %llu allocations (%llu bytes), average %.1f allocations (%.1f bytes), max %llu allocations.",
+                stats.m_FrameCount, stats.m_LastFrameAllocations, stats.m_LastFrameBytes, stats.m_AverageFrameAllocations,
+                stats.m_AverageFrameBytes, stats.m_MaxFrameAllocations);
+
+        std::vector<cbtMemoryRecord> records = GetRecords();
+        std::sort(records.begin(), records.end(), [](const cbtMemoryRecord& _a, const cbtMemoryRecord& _b)
+        { return _a.m_LiveBytes > _b.m_LiveBytes; });
+
+        for (cbtU32 i = 0; i < records.size() && i < _maxRecords; ++i)
+        {
+            CBT_LOG_INFO(CBT_LOG_CATEGORY_APPLICATION, "Memory [%s] %s:%d: %llu bytes in %llu allocations live, high water %llu bytes, %llu allocations total.",
+                    records[i].m_Tag ? records[i].m_Tag : "Untagged", records[i].m_File ? records[i].m_File : "Unknown",
+                    records[i].m_Line, records[i].m_LiveBytes, records[i].m_LiveCount, records[i].m_HighWaterBytes,
+                    records[i].m_TotalCount);
+        }
+    }
+
+    /**
+        \brief Escape a string so that it can be placed between double quotes in a CSV or JSON file.
+
+        \param _string The string to escape, or nullptr.
+        \param _default The string to use if _string is nullptr.
+        \param _json If true, escape for JSON. Otherwise, escape for CSV.
+
+        \return The escaped string, without quotes.
+    */
+    static cbtStr Escape(const cbtS8* _string, const cbtS8* _default, cbtBool _json)
+    {
+        cbtStr escaped;
+        for (const cbtS8* c = _string ? _string : _default; *c; ++c)
+        {
+            if (*c == '"')
+            { escaped += _json ? "\\\"" : "\"\""; }
+            else if (*c == '\\' && _json)
+            { escaped += "\\\\"; }
+            else
+            { escaped += *c; }
+        }
+        return escaped;
+    }
+
+    void cbtMemoryTracker::ExportCSV(const cbtStr& _filePath)
+    {
+        std::vector<cbtMemoryRecord> records = GetRecords();
+
+        cbtStr csv = "tag,file,line,live_bytes,live_count,high_water_bytes,total_bytes,total_count\n";
+        for (cbtU32 i = 0; i < records.size(); ++i)
+        {
+            csv += "\"" + Escape(records[i].m_Tag, "Untagged", false) + "\",\"" + Escape(records[i].m_File, "Unknown", false) + "\"," +
+                    std::to_string(records[i].m_Line) + "," + std::to_string(records[i].m_LiveBytes) + "," +
+                    std::to_string(records[i].m_LiveCount) + "," + std::to_string(records[i].m_HighWaterBytes) + "," +
+                    std::to_string(records[i].m_TotalBytes) + "," + std::to_string(records[i].m_TotalCount) + "\n";
+        }
+
+        cbtFileUtil::StringToFile(_filePath, csv);
+    }
+
+    void cbtMemoryTracker::ExportJSON(const cbtStr& _filePath)
+    {
+        cbtMemoryStats stats = GetStats();
+        std::vector<cbtMemoryRecord> records = GetRecords();
+
+        cbtStr json = "{\n";
+        json += "    \"live_bytes\": " + std::to_string(stats.m_LiveBytes) + ",\n";
+        json += "    \"live_count\": " + std::to_string(stats.m_LiveCount) + ",\n";
+        json += "    \"high_water_bytes\": " + std::to_string(stats.m_HighWaterBytes) + ",\n";
+        json += "    \"frame_count\": " + std::to_string(stats.m_FrameCount) + ",\n";
+        json += "    \"last_frame_allocations\": " + std::to_string(stats.m_LastFrameAllocations) + ",\n";
+        json += "    \"last_frame_bytes\": " + std::to_string(stats.m_LastFrameBytes) + ",\n";
+        json += "    \"max_frame_allocations\": " + std::to_string(stats.m_MaxFrameAllocations) + ",\n";
+        json += "    \"average_frame_allocations\": " + std::to_string(stats.m_AverageFrameAllocations) + ",\n";
+        json += "    \"average_frame_bytes\": " + std::to_string(stats.m_AverageFrameBytes) + ",\n";
+        json += "    \"records\": [\n";
+        for (cbtU32 i = 0; i < records.size(); ++i)
+        {
+            json += "        { \"tag\": \"" + Escape(records[i].m_Tag, "Untagged", true) + "\", \"file\": \"" +
+                    Escape(records[i].m_File, "Unknown", true) + "\", \"line\": " + std::to_string(records[i].m_Line) +
+                    ", \"live_bytes\": " + std::to_string(records[i].m_LiveBytes) + ", \"live_count\": " +
+                    std::to_string(records[i].m_LiveCount) + ", \"high_water_bytes\": " + std::to_string(records[i].m_HighWaterBytes) +
+                    ", \"total_bytes\": " + std::to_string(records[i].m_TotalBytes) + ", \"total_count\": " +
+                    std::to_string(records[i].m_TotalCount) + " }" + (i + 1 < records.size() ? ",\n" : "\n");
+        }
+        json += "    ]\n}\n";
+
+        cbtFileUtil::StringToFile(_filePath, json);
+    }
+
+NS_CBT_END
+
+// Replace the global allocation functions, so that allocations made without cbtNew, such as by STL containers, are also recorded.
+void* operator new(size_t _size)
+{
+    return NS_CBT::cbtMemoryTracker::Allocate(_size, nullptr, 0);
+}
+
+void* operator new[](size_t _size)
+{
+    return NS_CBT::cbtMemoryTracker::Allocate(_size, nullptr, 0);
+}
+
+void* operator new(size_t _size, const std::nothrow_t&) noexcept
+{
+    try
+    { return NS_CBT::cbtMemoryTracker::Allocate(_size, nullptr, 0); }
+    catch (...)
+    { return nullptr; }
+}
+
+void* operator new[](size_t _size, const std::nothrow_t&) noexcept
+{
+    try
+    { return NS_CBT::cbtMemoryTracker::Allocate(_size, nullptr, 0); }
+    catch (...)
+    { return nullptr; }
+}
+
+void* operator new(size_t _size, const NS_CBT::cbtAllocationSite& _site)
+{
+    return NS_CBT::cbtMemoryTracker::Allocate(_size, _site.m_File, _site.m_Line);
+}
+
+void* operator new[](size_t _size, const NS_CBT::cbtAllocationSite& _site)
+{
+    return NS_CBT::cbtMemoryTracker::Allocate(_size, _site.m_File, _site.m_Line);
+}
+
+void operator delete(void* _block) noexcept
+{
+    NS_CBT::cbtMemoryTracker::Deallocate(_block);
+}
+
+void operator delete[](void* _block) noexcept
+{
+    NS_CBT::cbtMemoryTracker::Deallocate(_block);
+}
+
+void operator delete(void* _block, size_t) noexcept
+{
+    NS_CBT::cbtMemoryTracker::Deallocate(_block);
+}
+
+void operator delete[](void* _block, size_t) noexcept
+{
+    NS_CBT::cbtMemoryTracker::Deallocate(_block);
+}
+
+void operator delete(void* _block, const std::nothrow_t&) noexcept
+{
+    NS_CBT::cbtMemoryTracker::Deallocate(_block);
+}
+
+void operator delete[](void* _block, const std::nothrow_t&) noexcept
+{
+    NS_CBT::cbtMemoryTracker::Deallocate(_block);
+}
+
+void operator delete(void* _block, const NS_CBT::cbtAllocationSite&) noexcept
+{
+    NS_CBT::cbtMemoryTracker::Deallocate(_block);
+}
+
+void operator delete[](void* _block, const NS_CBT::cbtAllocationSite&) noexcept
+{
+    NS_CBT::cbtMemoryTracker::Deallocate(_block);
+}
+
+#endif // CBT_MEMORY_TRACKING
\ No newline at end of file
@@ -0,0 +1,195 @@
+#pragma once
+
+// Include CBT
+#include "cbtMacros.h"
+
+#ifdef CBT_MEMORY_TRACKING
+
+// Include STD
+#include <vector>
+
+NS_CBT_BEGIN
+
+    /// The allocations recorded for a single tag and call site.
+    struct cbtMemoryRecord
+    {
+        /// The innermost CBT_MEMORY_TAG when the allocations were made, or nullptr if untagged.
+        const cbtS8* m_Tag = nullptr;
+        /// The file of the call site, or nullptr if the allocations were not made using cbtNew.
+        const cbtS8* m_File = nullptr;
+        /// The line of the call site.
+        cbtS32 m_Line = 0;
+        /// The number of bytes currently allocated.
+        cbtU64 m_LiveBytes = 0;
+        /// The number of allocations which have not been freed.
+        cbtU64 m_LiveCount = 0;
+        /// The highest value m_LiveBytes has reached.
+        cbtU64 m_HighWaterBytes = 0;
+        /// The total number of bytes ever allocated.
+        cbtU64 m_TotalBytes = 0;
+        /// The total number of allocations ever made.
+        cbtU64 m_TotalCount = 0;
+    };
+
+    /// The totals recorded by cbtMemoryTracker.
+    struct cbtMemoryStats
+    {
+        /// The number of bytes currently allocated.
+        cbtU64 m_LiveBytes = 0;
+        /// The number of allocations which have not been freed.
+        cbtU64 m_LiveCount = 0;
+        /// The highest value m_LiveBytes has reached.
+        cbtU64 m_HighWaterBytes = 0;
+        /// The number of frames ended using EndFrame().
+        cbtU64 m_FrameCount = 0;
+        /// The number of allocations made during the last frame.
+        cbtU64 m_LastFrameAllocations = 0;
+        /// The number of bytes allocated during the last frame.
+        cbtU64 m_LastFrameBytes = 0;
+        /// The highest number of allocations made during a single frame.
+        cbtU64 m_MaxFrameAllocations = 0;
+        /// The average number of allocations made per frame.
+        cbtF64 m_AverageFrameAllocations = 0.0;
+        /// The average number of bytes allocated per frame.
+        cbtF64 m_AverageFrameBytes = 0.0;
+    };
+
+    /**
+        \brief
+            Records every allocation made through the global operator new when CBT_MEMORY_TRACKING is defined.
+            Allocations are grouped by the innermost CBT_MEMORY_TAG on the allocating thread, and by call site when made using cbtNew.
+            Each allocation is prefixed with a small header recording its size and group, so that frees can be attributed without a lookup.
+
+        \warning Only exists if CBT_MEMORY_TRACKING is defined. Use the CBT_MEMORY_* macros, which compile to nothing otherwise.
+    */
+    class cbtMemoryTracker
+    {
+    private:
+        /**
+            \brief Private Constructor. All functions should be static. No objects of this class should be created.
+        */
+        cbtMemoryTracker()
+        {
+        }
+
+        /**
+            \brief Private Destructor. All functions should be static. No objects of this class should be created.
+        */
+        ~cbtMemoryTracker()
+        {
+        }
+
+    public:
+        /**
+            \brief Allocate and record a block of memory.
+
+            \param _size The size of the block.
+            \param _file The file of the call site, or nullptr if unknown.
+            \param _line The line of the call site.
+
+            \return The block. Throws std::bad_alloc on failure.
+        */
+        static void* Allocate(size_t _size, const cbtS8* _file, cbtS32 _line);
+
+        /**
+            \brief Free a block allocated using Allocate().
+
+            \param _block The block to free.
+        */
+        static void Deallocate(void* _block);
+
+        /**
+            \brief Push a tag which allocations on the calling thread will be recorded under till it is popped.
+
+            \param _tag The tag. Must be a string literal or otherwise outlive the tracker, as only the pointer is kept.
+        */
+        static void PushTag(const cbtS8* _tag);
+
+        /**
+            \brief Pop the tag pushed last on the calling thread.
+        */
+        static void PopTag();
+
+        /**
+            \brief Mark the end of a frame, updating the per-frame allocation statistics.
+        */
+        static void EndFrame();
+
+        /**
+            \brief Get the totals recorded across every tag and call site.
+
+            \return The totals recorded across every tag and call site.
+        */
+        static cbtMemoryStats GetStats();
+
+        /**
+            \brief Get the allocations recorded for each tag and call site.
+
+            \return The allocations recorded for each tag and call site.
+        */
+        static std::vector<cbtMemoryRecord> GetRecords();
+
+        /**
+            \brief Log the totals, and the tags and call sites with the most live bytes.
+
+            \param _maxRecords The maximum number of tags and call sites to log.
+        */
+        static void Dump(cbtU32 _maxRecords = 32);
+
+        /**
+            \brief Write a snapshot of every tag and call site to a CSV file.
+
+            \param _filePath The file path of the CSV file.
+        */
+        static void ExportCSV(const cbtStr& _filePath);
+
+        /**
+            \brief Write a snapshot of the totals and every tag and call site to a JSON file.
+
+            \param _filePath The file path of the JSON file.
+        */
+        static void ExportJSON(const cbtStr& _filePath);
+    };
+
+    /**
+        \brief Pushes a cbtMemoryTracker tag when created and pops it when destroyed.
+    */
+    class cbtMemoryTagScope
+    {
+    public:
+        cbtMemoryTagScope(const cbtS8* _tag)
+        {
+            cbtMemoryTracker::PushTag(_tag);
+        }
+
+        ~cbtMemoryTagScope()
+        {
+            cbtMemoryTracker::PopTag();
+        }
+    };
+
+NS_CBT_END
+
+#define CBT_MEMORY_TAG_CONCAT_IMPL(__A__, __B__) __A__##__B__
+#define CBT_MEMORY_TAG_CONCAT(__A__, __B__) CBT_MEMORY_TAG_CONCAT_IMPL(__A__, __B__)
+
+/// Record allocations made on this thread under __TAG__ till the end of the enclosing scope.
+#define CBT_MEMORY_TAG(__TAG__) NS_CBT::cbtMemoryTagScope CBT_MEMORY_TAG_CONCAT(cbtMemoryTagScope, __LINE__)(__TAG__)
+/// Mark the end of a frame for the per-frame allocation statistics.
+#define CBT_MEMORY_END_FRAME() NS_CBT::cbtMemoryTracker::EndFrame()
+/// Log the memory totals and the largest tags and call sites.
+#define CBT_MEMORY_DUMP() NS_CBT::cbtMemoryTracker::Dump()
+/// Write a CSV snapshot of every tag and call site.
+#define CBT_MEMORY_EXPORT_CSV(__FILE_PATH__) NS_CBT::cbtMemoryTracker::ExportCSV(__FILE_PATH__)
+/// Write a JSON snapshot of the totals and every tag and call site.
+#define CBT_MEMORY_EXPORT_JSON(__FILE_PATH__) NS_CBT::cbtMemoryTracker::ExportJSON(__FILE_PATH__)
+
+#else
+
+#define CBT_MEMORY_TAG(__TAG__)
+#define CBT_MEMORY_END_FRAME()
+#define CBT_MEMORY_DUMP()
+#define CBT_MEMORY_EXPORT_CSV(__FILE_PATH__)
+#define CBT_MEMORY_EXPORT_JSON(__FILE_PATH__)
+
+#endif // CBT_MEMORY_TRACKING
\ No newline at end of file
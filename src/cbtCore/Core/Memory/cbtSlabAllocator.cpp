@@ -0,0 +1,41 @@
+// Include CBT
+#include "cbtSlabAllocator.h"
+
+NS_CBT_BEGIN
+
+    std::mutex cbtSlabAllocatorRegistry::s_Mutex;
+    std::vector<std::function<cbtSlabAllocatorStats()>> cbtSlabAllocatorRegistry::s_Allocators;
+
+    void cbtSlabAllocatorRegistry::Register(std::function<cbtSlabAllocatorStats()> _getStats)
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        s_Allocators.push_back(_getStats);
+    }
+
+    std::vector<cbtSlabAllocatorStats> cbtSlabAllocatorRegistry::GetStats()
+    {
+        std::vector<std::function<cbtSlabAllocatorStats()>> allocators;
+        {
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            allocators = s_Allocators;
+        }
+
+        std::vector<cbtSlabAllocatorStats> stats;
+        for (cbtU32 i = 0; i < allocators.size(); ++i)
+        { stats.push_back(allocators[i]()); }
+        return stats;
+    }
+
+    void cbtSlabAllocatorRegistry::LogStats()
+    {
+        std::vector<cbtSlabAllocatorStats> stats = GetStats();
+        for (cbtU32 i = 0; i < stats.size(); ++i)
+        {
+            cbtF32 occupancy = stats[i].m_Capacity ? (100.0f * stats[i].m_LiveCount / stats[i].m_Capacity) : 0.0f;
+            CBT_LOG_INFO(CBT_LOG_CATEGORY_APPLICATION, "Slab Allocator %s: %u/%u blocks of %u bytes in use (%.1f%%), %u slabs.",
+                    stats[i].m_Name.c_str(), stats[i].m_LiveCount, stats[i].m_Capacity, (cbtU32)stats[i].m_BlockSize,
+                    occupancy, stats[i].m_SlabCount);
+        }
+    }
+
+NS_CBT_END
\ No newline at end of file
@@ -0,0 +1,413 @@
+#pragma once
+
+// Include CBT
+#include "cbtMacros.h"
+#include "Debug/cbtDebug.h"
+
+// Include STD
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <functional>
+#include <new>
+#include <type_traits>
+
+NS_CBT_BEGIN
+
+    /// The occupancy of a cbtSlabAllocator.
+    struct cbtSlabAllocatorStats
+    {
+        /// The name of the type allocated.
+        cbtStr m_Name;
+        /// The size of each block in bytes.
+        size_t m_BlockSize = 0;
+        /// The number of slabs allocated.
+        cbtU32 m_SlabCount = 0;
+        /// The total number of blocks in every slab.
+        cbtU32 m_Capacity = 0;
+        /// The number of blocks currently in use.
+        cbtU32 m_LiveCount = 0;
+    };
+
+    /**
+        \brief Keeps track of every cbtSlabAllocator which has been used, so that their occupancy can be reported.
+    */
+    class cbtSlabAllocatorRegistry
+    {
+    private:
+        /// Mutex for s_Allocators.
+        static std::mutex s_Mutex;
+        /// A function per registered allocator which returns its stats.
+        static std::vector<std::function<cbtSlabAllocatorStats()>> s_Allocators;
+
+        /**
+            \brief Private Constructor. All functions should be static. No objects of this class should be created.
+        */
+        cbtSlabAllocatorRegistry()
+        {
+        }
+
+        /**
+            \brief Private Destructor. All functions should be static. No objects of this class should be created.
+        */
+        ~cbtSlabAllocatorRegistry()
+        {
+        }
+
+    public:
+        /**
+            \brief Register an allocator.
+
+            \param _getStats A function which returns the allocator's stats.
+        */
+        static void Register(std::function<cbtSlabAllocatorStats()> _getStats);
+
+        /**
+            \brief Get the stats of every registered allocator.
+
+            \return The stats of every registered allocator.
+        */
+        static std::vector<cbtSlabAllocatorStats> GetStats();
+
+        /**
+            \brief Log the occupancy of every registered allocator.
+        */
+        static void LogStats();
+    };
+
+    /**
+        \brief
+            A fixed-size slab allocator for objects of type T.
+            Memory is allocated in slabs of many blocks, so that objects of the same type are packed together instead of being scattered across the heap,
+            and creating and destroying many objects does not go through malloc.
+            Each thread keeps its own cache of free blocks, and only locks the shared free list to move a batch of blocks in or out of its cache.
+            Slabs are never returned to the system, but freed blocks are reused.
+
+        \sa CBT_SLAB_ALLOCATED
+    */
+    template<typename T>
+    class cbtSlabAllocator
+    {
+    private:
+        /// The size of each block. A free block stores nothing, so it only needs to be large and aligned enough for T.
+        static constexpr size_t BLOCK_SIZE = (sizeof(T) + alignof(T) - 1) / alignof(T) * alignof(T);
+        /// The number of blocks per slab. Slabs are roughly 64KB, but always hold at least 64 blocks.
+        static constexpr cbtU32 BLOCKS_PER_SLAB = (65536 / BLOCK_SIZE > 64) ? (cbtU32)(65536 / BLOCK_SIZE) : 64;
+        /// The number of blocks moved between a thread's cache and the shared free list at once.
+        static constexpr cbtU32 BATCH_SIZE = 32;
+
+        static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "cbtSlabAllocator does not support over-aligned types.");
+
+        /// The state shared by every thread.
+        struct Shared
+        {
+            /// Mutex for everything in Shared except m_LiveCount.
+            std::mutex m_Mutex;
+            /// The slabs allocated.
+            std::vector<cbtByte*> m_Slabs;
+            /// The free blocks which are not in any thread's cache.
+            std::vector<void*> m_FreeBlocks;
+            /// If true, the free blocks are handed out lowest address first.
+            cbtBool m_AddressOrdered = false;
+            /// The number of blocks in use.
+            std::atomic<cbtU32> m_LiveCount { 0 };
+        };
+
+        /**
+            A thread's cache of free blocks. When the thread exits, they are returned to the shared free list.
+            The main thread's cache is destroyed before any static object, so objects freed during static destruction bypass it.
+        */
+        struct ThreadCache
+        {
+            /// The free blocks. Blocks are taken from the back.
+            std::vector<void*> m_FreeBlocks;
+
+            ~ThreadCache()
+            {
+                IsThreadCacheDestroyed() = true;
+                Shared& shared = GetShared();
+                std::lock_guard<std::mutex> sharedLock(shared.m_Mutex);
+                shared.m_FreeBlocks.insert(shared.m_FreeBlocks.end(), m_FreeBlocks.begin(), m_FreeBlocks.end());
+            }
+        };
+
+        /**
+            \brief Private Constructor. All functions should be static. No objects of this class should be created.
+        */
+        cbtSlabAllocator()
+        {
+        }
+
+        /**
+            \brief Private Destructor. All functions should be static. No objects of this class should be created.
+        */
+        ~cbtSlabAllocator()
+        {
+        }
+
+        /**
+            \brief
+                Get the shared state. It is intentionally never deleted, so that objects can still be allocated and freed during static destruction,
+                after every thread's cache has been destroyed.
+
+            \return The shared state.
+        */
+        static Shared& GetShared()
+        {
+            static Shared* shared = CreateShared();
+            return *shared;
+        }
+
+        static Shared* CreateShared()
+        {
+            cbtSlabAllocatorRegistry::Register(&cbtSlabAllocator<T>::GetStats);
+            return cbtNew Shared();
+        }
+
+        /**
+            \brief Check whether the calling thread's cache has been destroyed. The flag is trivially destructible, so it can still be read after the cache is gone.
+
+            \return A reference to the flag.
+        */
+        static cbtBool& IsThreadCacheDestroyed()
+        {
+            thread_local cbtBool destroyed = false;
+            return destroyed;
+        }
+
+        /**
+            \brief Get the calling thread's cache.
+
+            \return The calling thread's cache, or nullptr if it has already been destroyed because the thread is exiting.
+        */
+        static ThreadCache* GetThreadCache()
+        {
+            if (IsThreadCacheDestroyed())
+            { return nullptr; }
+            thread_local ThreadCache threadCache;
+            return &threadCache;
+        }
+
+        /**
+            \brief Allocate a new slab and add its blocks to the shared free list. The shared mutex must be locked.
+
+            \param _shared The shared state.
+        */
+        static void AddSlab(Shared& _shared)
+        {
+            cbtByte* slab = static_cast<cbtByte*>(::operator new(BLOCK_SIZE * BLOCKS_PER_SLAB));
+            _shared.m_Slabs.push_back(slab);
+            for (cbtU32 i = BLOCKS_PER_SLAB; i > 0; --i)
+            { _shared.m_FreeBlocks.push_back(slab + BLOCK_SIZE * (i - 1)); }
+        }
+
+        /**
+            \brief Move a batch of free blocks from the shared free list into a thread's cache, allocating a new slab if there are not enough.
+
+            \param _threadCache The thread's cache.
+        */
+        static void Refill(ThreadCache& _threadCache)
+        {
+            Shared& shared = GetShared();
+            std::lock_guard<std::mutex> sharedLock(shared.m_Mutex);
+
+            if (shared.m_FreeBlocks.empty())
+            {
+                AddSlab(shared);
+            }
+            else if (shared.m_AddressOrdered)
+            {
+                // Highest address first, so that taking from the back hands out the lowest addresses first.
+                std::sort(shared.m_FreeBlocks.begin(), shared.m_FreeBlocks.end(), std::greater<void*>());
+            }
+
+            cbtU32 batchSize = std::min<cbtU32>(BATCH_SIZE, (cbtU32)shared.m_FreeBlocks.size());
+            _threadCache.m_FreeBlocks.insert(_threadCache.m_FreeBlocks.end(), shared.m_FreeBlocks.end() - batchSize,
+                    shared.m_FreeBlocks.end());
+            shared.m_FreeBlocks.resize(shared.m_FreeBlocks.size() - batchSize);
+        }
+
+        /**
+            \brief Move a batch of free blocks from a thread's cache back to the shared free list, so that one thread freeing many objects does not hoard their memory.
+
+            \param _threadCache The thread's cache.
+        */
+        static void Drain(ThreadCache& _threadCache)
+        {
+            Shared& shared = GetShared();
+            std::lock_guard<std::mutex> sharedLock(shared.m_Mutex);
+            shared.m_FreeBlocks.insert(shared.m_FreeBlocks.end(), _threadCache.m_FreeBlocks.end() - BATCH_SIZE,
+                    _threadCache.m_FreeBlocks.end());
+            _threadCache.m_FreeBlocks.resize(_threadCache.m_FreeBlocks.size() - BATCH_SIZE);
+        }
+
+    public:
+        /**
+            \brief Allocate a block large enough for a T.
+
+            \return The block.
+        */
+        static void* Allocate()
+        {
+            Shared& shared = GetShared();
+            shared.m_LiveCount.fetch_add(1, std::memory_order_relaxed);
+
+            ThreadCache* threadCache = GetThreadCache();
+            if (!threadCache)
+            {
+                std::lock_guard<std::mutex> sharedLock(shared.m_Mutex);
+                if (shared.m_FreeBlocks.empty())
+                { AddSlab(shared); }
+                void* block = shared.m_FreeBlocks.back();
+                shared.m_FreeBlocks.pop_back();
+                return block;
+            }
+
+            if (threadCache->m_FreeBlocks.empty())
+            { Refill(*threadCache); }
+            void* block = threadCache->m_FreeBlocks.back();
+            threadCache->m_FreeBlocks.pop_back();
+            return block;
+        }
+
+        /**
+            \brief
+                Allocate several blocks at once, taking them straight from the shared free list under a single lock.
+                The blocks are freed one at a time with Deallocate(), like those returned by Allocate().
+
+            \param _blocks The array to write the blocks to. It must have space for _count blocks.
+            \param _count The number of blocks to allocate.
+        */
+        static void AllocateMany(void** _blocks, cbtU32 _count)
+        {
+            Shared& shared = GetShared();
+            shared.m_LiveCount.fetch_add(_count, std::memory_order_relaxed);
+
+            std::lock_guard<std::mutex> sharedLock(shared.m_Mutex);
+            while (shared.m_FreeBlocks.size() < _count)
+            { AddSlab(shared); }
+            if (shared.m_AddressOrdered)
+            { std::sort(shared.m_FreeBlocks.begin(), shared.m_FreeBlocks.end(), std::greater<void*>()); }
+
+            // Taken from the back, so that blocks from the same slab are handed out in address order.
+            for (cbtU32 i = 0; i < _count; ++i)
+            { _blocks[i] = shared.m_FreeBlocks[shared.m_FreeBlocks.size() - 1 - i]; }
+            shared.m_FreeBlocks.resize(shared.m_FreeBlocks.size() - _count);
+        }
+
+        /**
+            \brief Free a block returned by Allocate(). It may be freed on a different thread from the one that allocated it.
+
+            \param _block The block to free.
+        */
+        static void Deallocate(void* _block)
+        {
+            if (!_block)
+            { return; }
+
+            Shared& shared = GetShared();
+            shared.m_LiveCount.fetch_sub(1, std::memory_order_relaxed);
+
+            ThreadCache* threadCache = GetThreadCache();
+            if (!threadCache)
+            {
+                std::lock_guard<std::mutex> sharedLock(shared.m_Mutex);
+                shared.m_FreeBlocks.push_back(_block);
+                return;
+            }
+
+            threadCache->m_FreeBlocks.push_back(_block);
+            if (threadCache->m_FreeBlocks.size() >= BATCH_SIZE * 2)
+            { Drain(*threadCache); }
+        }
+
+        /**
+            \brief
+                If enabled, free blocks are handed out lowest address first.
+                Objects created after a burst of destruction, such as components added to the end of a component pool, are then laid out in memory
+                in the same order they are iterated in. This costs a sort of the shared free list each time a thread's cache is refilled.
+
+            \param _addressOrdered Should free blocks be handed out lowest address first.
+        */
+        static void SetAddressOrdered(cbtBool _addressOrdered)
+        {
+            Shared& shared = GetShared();
+            std::lock_guard<std::mutex> sharedLock(shared.m_Mutex);
+            shared.m_AddressOrdered = _addressOrdered;
+        }
+
+        /**
+            \brief Get the occupancy of this allocator.
+
+            \return The occupancy of this allocator.
+        */
+        static cbtSlabAllocatorStats GetStats()
+        {
+            Shared& shared = GetShared();
+            std::lock_guard<std::mutex> sharedLock(shared.m_Mutex);
+
+            cbtSlabAllocatorStats stats;
+            stats.m_Name = T::GetSlabAllocatorName();
+            stats.m_BlockSize = BLOCK_SIZE;
+            stats.m_SlabCount = (cbtU32)shared.m_Slabs.size();
+            stats.m_Capacity = stats.m_SlabCount * BLOCKS_PER_SLAB;
+            stats.m_LiveCount = shared.m_LiveCount.load(std::memory_order_relaxed);
+            return stats;
+        }
+    };
+
+/**
+    \brief
+        Declare this inside a class to allocate it using a cbtSlabAllocator when it is created with cbtNew.
+        Classes derived from __CLASS__ which are a different size fall back to the global operator new,
+        unless they declare CBT_SLAB_ALLOCATED themselves.
+        This leaves the class's access at public.
+
+    Example:\n
+    \code{.cpp}
+    class cbtTransform : public cbtComponent
+    {
+        CBT_SLAB_ALLOCATED(cbtTransform)
+
+    private:
+        ...
+    };
+    \endcode
+*/
+#ifdef CBT_MEMORY_TRACKING
+/// Allows cbtNew to pass its call site. Slab allocations are reported by cbtSlabAllocatorRegistry rather than cbtMemoryTracker.
+#define CBT_SLAB_ALLOCATED_SITE(__CLASS__) \
+        static void* operator new(size_t _size, const NS_CBT::cbtAllocationSite&) { return operator new(_size); }
+#else
+#define CBT_SLAB_ALLOCATED_SITE(__CLASS__)
+#endif // CBT_MEMORY_TRACKING
+
+#define CBT_SLAB_ALLOCATED(__CLASS__) \
+    public: \
+        CBT_SLAB_ALLOCATED_SITE(__CLASS__) \
+        typedef __CLASS__ cbtSlabAllocatedType; \
+        static const cbtS8* GetSlabAllocatorName() { return #__CLASS__; } \
+        static void* operator new(size_t _size) \
+        { return _size == sizeof(__CLASS__) ? NS_CBT::cbtSlabAllocator<__CLASS__>::Allocate() : ::operator new(_size); } \
+        static void operator delete(void* _block, size_t _size) \
+        { \
+            if (_size == sizeof(__CLASS__)) \
+            { NS_CBT::cbtSlabAllocator<__CLASS__>::Deallocate(_block); } \
+            else \
+            { ::operator delete(_block); } \
+        }
+
+    /// True if T is allocated by a cbtSlabAllocator<T>, because it declares CBT_SLAB_ALLOCATED itself.
+    template<typename T, typename = void>
+    struct cbtIsSlabAllocated : std::false_type
+    {
+    };
+
+    template<typename T>
+    struct cbtIsSlabAllocated<T, std::void_t<typename T::cbtSlabAllocatedType>>
+            : std::is_same<T, typename T::cbtSlabAllocatedType>
+    {
+    };
+
+NS_CBT_END
\ No newline at end of file
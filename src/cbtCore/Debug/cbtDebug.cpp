@@ -0,0 +1,301 @@
+// Include CBT
+#include "cbtDebug.h"
+
+// Include STD
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+NS_CBT_BEGIN
+
+    /// The size of each thread's ring buffer, in bytes. Must be a power of 2.
+    static constexpr cbtU32 LOG_RING_CAPACITY = 65536;
+    /// The longest message which can be copied as it is. Longer messages are truncated.
+    static constexpr cbtU32 LOG_MAX_MESSAGE_SIZE = LOG_RING_CAPACITY / 4;
+    /// How often the logging thread checks for messages when it is idle.
+    static constexpr std::chrono::milliseconds LOG_POLL_INTERVAL(5);
+
+    /**
+        \brief
+            The header of a message in a ring buffer, followed by its arguments.
+            A header with m_Size 0 marks that the rest of the ring buffer is unused, and the next message is at the start.
+    */
+    struct cbtLogRecord
+    {
+        /// The size of the record, including the header.
+        cbtU32 m_Size;
+        cbtLogCategory m_Category;
+        cbtLogPriority m_Priority;
+        const cbtS8* m_Format;
+        /// Formats the message from its arguments. If nullptr, the message follows the header as it is.
+        cbtLogFormatter m_Formatter;
+    };
+
+    /// The messages logged by a single thread. Only the owning thread writes messages, and only the logging thread reads them.
+    struct cbtLogRing
+    {
+        alignas(CBT_LOG_ARGUMENT_ALIGNMENT) cbtByte m_Buffer[LOG_RING_CAPACITY];
+        /// The total number of bytes written. Only advanced once a message is complete.
+        alignas(64) std::atomic<cbtU64> m_WriteOffset { 0 };
+        /// The total number of bytes read by the logging thread.
+        alignas(64) std::atomic<cbtU64> m_ReadOffset { 0 };
+        /// The write offset after the message reserved by BeginRecord(). Only used by the owning thread.
+        cbtU64 m_ReservedOffset = 0;
+        /// The number of messages dropped because the ring buffer was full.
+        std::atomic<cbtU64> m_DroppedCount { 0 };
+    };
+
+    /// The ring buffer of every thread which has logged a message, and the thread which writes them.
+    struct cbtLogger
+    {
+        std::mutex m_Mutex;
+        std::condition_variable m_Condition;
+        std::condition_variable m_FlushCondition;
+        /// The ring buffers are never deleted, so that the messages of a thread which has exited are still written.
+        std::vector<cbtLogRing*> m_Rings;
+        std::thread m_Thread;
+        cbtBool m_Stop = false;
+        cbtU64 m_FlushRequested = 0;
+        cbtU64 m_FlushCompleted = 0;
+
+        cbtLogger();
+        ~cbtLogger();
+
+        void Run();
+    };
+
+    /// Set once the logger has been destroyed at exit. Any message logged afterwards is written by the thread which logged it.
+    static std::atomic<cbtBool> s_LoggerDestroyed { false };
+
+    static cbtLogger& GetLogger()
+    {
+        static cbtLogger logger;
+        return logger;
+    }
+
+    /**
+        \brief Get the calling thread's ring buffer, registering it on first use.
+
+        \return The calling thread's ring buffer.
+    */
+    static cbtLogRing& GetRing()
+    {
+        thread_local cbtLogRing* ring = []()
+        {
+            cbtLogRing* newRing = cbtNew cbtLogRing();
+            if (s_LoggerDestroyed.load(std::memory_order_acquire))
+            { return newRing; }
+
+            cbtLogger& logger = GetLogger();
+            std::lock_guard<std::mutex> lock(logger.m_Mutex);
+            logger.m_Rings.push_back(newRing);
+            return newRing;
+        }();
+        return *ring;
+    }
+
+    /**
+        \brief Format a message and write it.
+
+        \param _record The message.
+    */
+    static void WriteRecord(const cbtLogRecord& _record)
+    {
+        const cbtByte* arguments = reinterpret_cast<const cbtByte*>(&_record) + cbtLogAlign(sizeof(cbtLogRecord));
+        if (_record.m_Formatter == nullptr)
+        {
+            cbtDebug::Write(_record.m_Category, _record.m_Priority, reinterpret_cast<const cbtS8*>(arguments));
+            return;
+        }
+
+        cbtS8 buffer[1024];
+        cbtS32 length = _record.m_Formatter(_record.m_Format, arguments, buffer, sizeof(buffer));
+        if (length < (cbtS32)sizeof(buffer))
+        {
+            cbtDebug::Write(_record.m_Category, _record.m_Priority, buffer);
+            return;
+        }
+
+        std::vector<cbtS8> largeBuffer(length + 1);
+        _record.m_Formatter(_record.m_Format, arguments, largeBuffer.data(), (cbtU32)largeBuffer.size());
+        cbtDebug::Write(_record.m_Category, _record.m_Priority, largeBuffer.data());
+    }
+
+    /**
+        \brief Write every message in a ring buffer.
+
+        \param _ring The ring buffer.
+
+        \return True if any message was written.
+    */
+    static cbtBool DrainRing(cbtLogRing& _ring)
+    {
+        cbtU64 readOffset = _ring.m_ReadOffset.load(std::memory_order_relaxed);
+        const cbtU64 writeOffset = _ring.m_WriteOffset.load(std::memory_order_acquire);
+        const cbtBool wroteAny = readOffset != writeOffset;
+        while (readOffset != writeOffset)
+        {
+            cbtU32 offset = (cbtU32)(readOffset & (LOG_RING_CAPACITY - 1));
+            const cbtLogRecord& record = *reinterpret_cast<const cbtLogRecord*>(&_ring.m_Buffer[offset]);
+            if (record.m_Size == 0)
+            {
+                readOffset += LOG_RING_CAPACITY - offset;
+                continue;
+            }
+
+            WriteRecord(record);
+            readOffset += record.m_Size;
+            // Free the space as soon as possible, as a thread logging an error may be waiting for it.
+            _ring.m_ReadOffset.store(readOffset, std::memory_order_release);
+        }
+        _ring.m_ReadOffset.store(readOffset, std::memory_order_release);
+
+        cbtU64 droppedCount = _ring.m_DroppedCount.exchange(0, std::memory_order_relaxed);
+        if (droppedCount != 0)
+        {
+            cbtStr message = "[LOG] " + CBT_TO_STRING(droppedCount) + " message(s) were dropped because a thread's log buffer was full.";
+            cbtDebug::Write(CBT_LOG_CATEGORY_APPLICATION, CBT_LOG_PRIORITY_WARN, message.c_str());
+        }
+        return wroteAny;
+    }
+
+    cbtLogger::cbtLogger()
+    {
+        m_Thread = std::thread(&cbtLogger::Run, this);
+    }
+
+    cbtLogger::~cbtLogger()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Stop = true;
+        }
+        m_Condition.notify_one();
+        m_Thread.join();
+        s_LoggerDestroyed.store(true, std::memory_order_release);
+    }
+
+    void cbtLogger::Run()
+    {
+        std::vector<cbtLogRing*> rings;
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        while (true)
+        {
+            // Everything logged before a flush was requested, or before stopping, is written in this pass.
+            const cbtU64 flushRequested = m_FlushRequested;
+            const cbtBool stop = m_Stop;
+            rings = m_Rings;
+            lock.unlock();
+
+            cbtBool wroteAny = false;
+            for (cbtU32 i = 0; i < rings.size(); ++i)
+            { wroteAny |= DrainRing(*rings[i]); }
+
+            lock.lock();
+            if (flushRequested > m_FlushCompleted)
+            {
+                m_FlushCompleted = flushRequested;
+                m_FlushCondition.notify_all();
+            }
+            if (stop)
+            { break; }
+            if (!wroteAny)
+            { m_Condition.wait_for(lock, LOG_POLL_INTERVAL, [this, flushRequested]() { return m_Stop || m_FlushRequested != flushRequested; }); }
+        }
+    }
+
+    cbtByte* cbtDebug::BeginRecord(cbtU32 _argumentSize, cbtLogCategory _category, cbtLogPriority _priority, const cbtS8* _format, cbtLogFormatter _formatter)
+    {
+        const cbtU32 recordSize = cbtLogAlign(sizeof(cbtLogRecord)) + cbtLogAlign(_argumentSize);
+        if (recordSize > LOG_RING_CAPACITY / 2)
+        { return nullptr; }
+
+        cbtLogRing& ring = GetRing();
+        cbtU64 writeOffset = ring.m_WriteOffset.load(std::memory_order_relaxed);
+        cbtU32 offset = (cbtU32)(writeOffset & (LOG_RING_CAPACITY - 1));
+        // A message is never split, so if it does not fit before the end of the ring buffer, the rest of it is skipped.
+        cbtU32 skipSize = (LOG_RING_CAPACITY - offset < recordSize) ? LOG_RING_CAPACITY - offset : 0;
+
+        while (LOG_RING_CAPACITY - (writeOffset - ring.m_ReadOffset.load(std::memory_order_acquire)) < skipSize + recordSize)
+        {
+            // Without a logging thread, this thread is the only one reading its ring buffer.
+            if (s_LoggerDestroyed.load(std::memory_order_acquire))
+            {
+                DrainRing(ring);
+                continue;
+            }
+
+            // Errors are rare and important, so wait for the logging thread rather than dropping them.
+            if (_priority < CBT_LOG_PRIORITY_ERROR)
+            {
+                ring.m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            GetLogger().m_Condition.notify_one();
+            std::this_thread::yield();
+        }
+
+        if (skipSize != 0)
+        {
+            reinterpret_cast<cbtLogRecord*>(&ring.m_Buffer[offset])->m_Size = 0;
+            writeOffset += skipSize;
+            offset = 0;
+        }
+
+        cbtLogRecord* record = reinterpret_cast<cbtLogRecord*>(&ring.m_Buffer[offset]);
+        record->m_Size = recordSize;
+        record->m_Category = _category;
+        record->m_Priority = _priority;
+        record->m_Format = _format;
+        record->m_Formatter = _formatter;
+        ring.m_ReservedOffset = writeOffset + recordSize;
+        return reinterpret_cast<cbtByte*>(record) + cbtLogAlign(sizeof(cbtLogRecord));
+    }
+
+    void cbtDebug::EndRecord(cbtLogPriority _priority)
+    {
+        cbtLogRing& ring = GetRing();
+        ring.m_WriteOffset.store(ring.m_ReservedOffset, std::memory_order_release);
+
+        if (s_LoggerDestroyed.load(std::memory_order_acquire))
+        {
+            DrainRing(ring);
+            return;
+        }
+
+        // Make sure errors are written before a following assert can end the program.
+        if (_priority >= CBT_LOG_PRIORITY_ERROR)
+        { Flush(); }
+    }
+
+    void cbtDebug::Log(cbtLogCategory _category, cbtLogPriority _priority, const cbtS8* _message)
+    {
+        cbtU32 length = std::min<cbtU32>((cbtU32)std::strlen(_message), LOG_MAX_MESSAGE_SIZE);
+        cbtByte* buffer = BeginRecord(length + 1, _category, _priority, nullptr, nullptr);
+        if (buffer == nullptr)
+        { return; }
+        std::memcpy(buffer, _message, length);
+        buffer[length] = '\0';
+        EndRecord(_priority);
+    }
+
+    void cbtDebug::Flush()
+    {
+        if (s_LoggerDestroyed.load(std::memory_order_acquire))
+        { return; }
+
+        cbtLogger& logger = GetLogger();
+        std::unique_lock<std::mutex> lock(logger.m_Mutex);
+        // The logging thread is writing its last messages, and will not complete another flush.
+        if (logger.m_Stop)
+        { return; }
+        const cbtU64 flushRequest = ++logger.m_FlushRequested;
+        logger.m_Condition.notify_one();
+        logger.m_FlushCondition.wait(lock, [&logger, flushRequest]() { return logger.m_FlushCompleted >= flushRequest; });
+    }
+
+NS_CBT_END
\ No newline at end of file
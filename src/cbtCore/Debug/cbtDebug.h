@@ -2,6 +2,7 @@
 
 // Include CBT
 #include "cbtMacros.h"
+#include "cbtLogArgument.h"
 
 // Include STD
 #include <cassert>
@@ -33,8 +34,27 @@ NS_CBT_BEGIN
         CBT_LOG_PRIORITY_CRITICAL,
     };
 
+/// Log Level
+#define CBT_LOG_LEVEL_VERBOSE 0
+#define CBT_LOG_LEVEL_DEBUG 1
+#define CBT_LOG_LEVEL_INFO 2
+#define CBT_LOG_LEVEL_WARN 3
+#define CBT_LOG_LEVEL_ERROR 4
+#define CBT_LOG_LEVEL_CRITICAL 5
+#define CBT_LOG_LEVEL_NONE 6
+
+/// Messages with a lower priority than CBT_LOG_LEVEL are compiled out, and their arguments are not evaluated.
+#ifndef CBT_LOG_LEVEL
+#define CBT_LOG_LEVEL CBT_LOG_LEVEL_VERBOSE
+#endif
+
 /**
-    \brief A debug utility class.
+    \brief
+        A debug utility class.
+
+        Logging is asynchronous. The calling thread copies the format pointer and the arguments of a message into its own lock-free ring buffer,
+        and a background thread formats the message and writes it to the console. Messages from the same thread are written in order.
+        If a thread's ring buffer is full, its messages are dropped and counted, except for errors, which wait for space.
 */
     class cbtDebug
     {
@@ -53,6 +73,28 @@ NS_CBT_BEGIN
         {
         }
 
+        /**
+            \brief
+                Reserve space for a message in the calling thread's ring buffer.
+                The message is not seen by the logging thread until EndRecord() is called.
+
+            \param _argumentSize The size of the message's arguments.
+            \param _category The message category.
+            \param _priority The message priority.
+            \param _format The message string in printf() format.
+            \param _formatter The function which formats the message from its arguments.
+
+            \return The space to write the arguments to, or nullptr if the message was dropped.
+        */
+        static cbtByte* BeginRecord(cbtU32 _argumentSize, cbtLogCategory _category, cbtLogPriority _priority, const cbtS8* _format, cbtLogFormatter _formatter);
+
+        /**
+            \brief Pass the message reserved by BeginRecord() to the logging thread.
+
+            \param _priority The message priority.
+        */
+        static void EndRecord(cbtLogPriority _priority);
+
         /**
             \brief Get the string description of a cbtLogCategory.
 
@@ -115,10 +157,42 @@ NS_CBT_BEGIN
 
             \param _category The message category.
             \param _priority The message priority.
-            \param _format The message string in printf() format.
-            \param ... Additional arguments.
+            \param _format The message string in printf() format. It must outlive the program, such as a string literal, as it is formatted later.
+            \param _args Additional arguments. C strings are copied. Any other argument must be trivially copyable.
+        */
+        template<typename... Args>
+        static void Log(cbtLogCategory _category, cbtLogPriority _priority, const cbtS8* _format, const Args& ... _args)
+        {
+            cbtU32 argumentSize = (0 + ... + cbtLogArgument<std::decay_t<const Args>>::GetSize(_args));
+            cbtByte* buffer = BeginRecord(argumentSize, _category, _priority, _format, &cbtFormatLogMessage<std::decay_t<const Args>...>);
+            if (buffer == nullptr)
+            { return; }
+            ((buffer = cbtLogArgument<std::decay_t<const Args>>::Encode(buffer, _args)), ...);
+            EndRecord(_priority);
+        }
+
+        /**
+            \brief Print a message to the console.
+
+            \param _category The message category.
+            \param _priority The message priority.
+            \param _message The message. It is copied, so it may be built at runtime. It is printed as it is, rather than in printf() format.
+        */
+        static void Log(cbtLogCategory _category, cbtLogPriority _priority, const cbtS8* _message);
+
+        /**
+            \brief Wait until every message logged before this call has been written. Messages with priority CBT_LOG_PRIORITY_ERROR or higher are flushed automatically.
         */
-        static void Log(cbtLogCategory _category, cbtLogPriority _priority, const cbtS8* _format, ...);
+        static void Flush();
+
+        /**
+            \brief Write a formatted message to the console immediately. Implemented by the platform, and called by the logging thread.
+
+            \param _category The message category.
+            \param _priority The message priority.
+            \param _message The formatted message.
+        */
+        static void Write(cbtLogCategory _category, cbtLogPriority _priority, const cbtS8* _message);
     };
 
 /*
@@ -136,17 +210,44 @@ NS_CBT_BEGIN
 #define CBT_LOG_CRITICAL(__LOG_CATEGORY__, __FORMAT__, ...) ::NS_CBT::cbtDebug::Log(__LOG_CATEGORY__, CBT_LOG_PRIORITY_CRITICAL, __FORMAT__, __VA_ARGS__)
 */
 
+/// A disabled log message. It is type checked, but not evaluated.
+#define CBT_LOG_DISABLED(__LOG_CATEGORY__, __PRIORITY__, __FORMAT__, ...) ((void)sizeof((::NS_CBT::cbtDebug::Log(__LOG_CATEGORY__, __PRIORITY__, __FORMAT__ __VA_OPT__(,) __VA_ARGS__), 0)))
+
+#if CBT_LOG_LEVEL <= CBT_LOG_LEVEL_VERBOSE
 /// Print a message to the console with priority CBT_LOG_PRIORITY_VERBOSE and a given category.
 #define CBT_LOG_VERBOSE(__LOG_CATEGORY__, __FORMAT__, ...) ::NS_CBT::cbtDebug::Log(__LOG_CATEGORY__, CBT_LOG_PRIORITY_VERBOSE, __FORMAT__ __VA_OPT__(,) __VA_ARGS__)
+#else
+#define CBT_LOG_VERBOSE(__LOG_CATEGORY__, __FORMAT__, ...) CBT_LOG_DISABLED(__LOG_CATEGORY__, CBT_LOG_PRIORITY_VERBOSE, __FORMAT__ __VA_OPT__(,) __VA_ARGS__)
+#endif
+#if CBT_LOG_LEVEL <= CBT_LOG_LEVEL_DEBUG
 /// Print a message to the console with priority CBT_LOG_PRIORITY_DEBUG and a given category.
 #define CBT_LOG_DEBUG(__LOG_CATEGORY__, __FORMAT__, ...) ::NS_CBT::cbtDebug::Log(__LOG_CATEGORY__, CBT_LOG_PRIORITY_DEBUG, __FORMAT__ __VA_OPT__(,) __VA_ARGS__)
+#else
+#define CBT_LOG_DEBUG(__LOG_CATEGORY__, __FORMAT__, ...) CBT_LOG_DISABLED(__LOG_CATEGORY__, CBT_LOG_PRIORITY_DEBUG, __FORMAT__ __VA_OPT__(,) __VA_ARGS__)
+#endif
+#if CBT_LOG_LEVEL <= CBT_LOG_LEVEL_INFO
 /// Print a message to the console with priority CBT_LOG_PRIORITY_INFO and a given category.
 #define CBT_LOG_INFO(__LOG_CATEGORY__, __FORMAT__, ...) ::NS_CBT::cbtDebug::Log(__LOG_CATEGORY__, CBT_LOG_PRIORITY_INFO, __FORMAT__ __VA_OPT__(,) __VA_ARGS__)
+#else
+#define CBT_LOG_INFO(__LOG_CATEGORY__, __FORMAT__, ...) CBT_LOG_DISABLED(__LOG_CATEGORY__, CBT_LOG_PRIORITY_INFO, __FORMAT__ __VA_OPT__(,) __VA_ARGS__)
+#endif
+#if CBT_LOG_LEVEL <= CBT_LOG_LEVEL_WARN
 /// Print a message to the console with priority CBT_LOG_PRIORITY_WARN and a given category.
 #define CBT_LOG_WARN(__LOG_CATEGORY__, __FORMAT__, ...) ::NS_CBT::cbtDebug::Log(__LOG_CATEGORY__, CBT_LOG_PRIORITY_WARN, __FORMAT__ __VA_OPT__(,) __VA_ARGS__)
+#else
+#define CBT_LOG_WARN(__LOG_CATEGORY__, __FORMAT__, ...) CBT_LOG_DISABLED(__LOG_CATEGORY__, CBT_LOG_PRIORITY_WARN, __FORMAT__ __VA_OPT__(,) __VA_ARGS__)
+#endif
+#if CBT_LOG_LEVEL <= CBT_LOG_LEVEL_ERROR
 /// Print a message to the console with priority CBT_LOG_PRIORITY_ERROR and a given category.
 #define CBT_LOG_ERROR(__LOG_CATEGORY__, __FORMAT__, ...) ::NS_CBT::cbtDebug::Log(__LOG_CATEGORY__, CBT_LOG_PRIORITY_ERROR, __FORMAT__ __VA_OPT__(,) __VA_ARGS__)
+#else
+#define CBT_LOG_ERROR(__LOG_CATEGORY__, __FORMAT__, ...) CBT_LOG_DISABLED(__LOG_CATEGORY__, CBT_LOG_PRIORITY_ERROR, __FORMAT__ __VA_OPT__(,) __VA_ARGS__)
+#endif
+#if CBT_LOG_LEVEL <= CBT_LOG_LEVEL_CRITICAL
 /// Print a message to the console with priority CBT_LOG_PRIORITY_CRITICAL and a given category.
 #define CBT_LOG_CRITICAL(__LOG_CATEGORY__, __FORMAT__, ...) ::NS_CBT::cbtDebug::Log(__LOG_CATEGORY__, CBT_LOG_PRIORITY_CRITICAL, __FORMAT__ __VA_OPT__(,) __VA_ARGS__)
+#else
+#define CBT_LOG_CRITICAL(__LOG_CATEGORY__, __FORMAT__, ...) CBT_LOG_DISABLED(__LOG_CATEGORY__, CBT_LOG_PRIORITY_CRITICAL, __FORMAT__ __VA_OPT__(,) __VA_ARGS__)
+#endif
 
 NS_CBT_END
\ No newline at end of file
@@ -0,0 +1,125 @@
+#pragma once
+
+// Include CBT
+#include "cbtMacros.h"
+
+// Include STD
+#include <cstdio>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+
+NS_CBT_BEGIN
+
+    /// The alignment of every argument in a log record.
+    constexpr cbtU32 CBT_LOG_ARGUMENT_ALIGNMENT = 8;
+
+    /**
+        \brief Round a size up to CBT_LOG_ARGUMENT_ALIGNMENT.
+
+        \param _size The size.
+
+        \return The aligned size.
+    */
+    constexpr cbtU32 cbtLogAlign(cbtU32 _size)
+    {
+        return (_size + CBT_LOG_ARGUMENT_ALIGNMENT - 1) & ~(CBT_LOG_ARGUMENT_ALIGNMENT - 1);
+    }
+
+    /**
+        \brief
+            Copies an argument of a log message into a log record, and reads it back on the logging thread.
+            Arguments are copied by value, so they must be trivially copyable. C strings are the exception, and have their characters copied instead.
+    */
+    template<typename T, typename Enable = void>
+    struct cbtLogArgument
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Log arguments must be trivially copyable, or C strings.");
+
+        /// The type passed to the formatter.
+        typedef T DecodedType;
+
+        static cbtU32 GetSize(const T&)
+        {
+            return cbtLogAlign(sizeof(T));
+        }
+
+        static cbtByte* Encode(cbtByte* _buffer, const T& _value)
+        {
+            std::memcpy(_buffer, &_value, sizeof(T));
+            return _buffer + cbtLogAlign(sizeof(T));
+        }
+
+        static const cbtByte* Decode(const cbtByte* _buffer, DecodedType& _value)
+        {
+            std::memcpy(&_value, _buffer, sizeof(T));
+            return _buffer + cbtLogAlign(sizeof(T));
+        }
+    };
+
+    /// C strings may be freed before the message is formatted, so their characters are copied, preceded by their length.
+    template<typename T>
+    struct cbtLogArgument<T*, std::enable_if_t<std::is_same_v<std::remove_cv_t<T>, cbtS8> ||
+                                               std::is_same_v<std::remove_cv_t<T>, cbtByte> ||
+                                               std::is_same_v<std::remove_cv_t<T>, signed char>>>
+    {
+        typedef const cbtS8* DecodedType;
+
+        /// The length stored for a null pointer.
+        static constexpr cbtU32 NULL_LENGTH = 0xFFFFFFFF;
+
+        static cbtU32 GetSize(T* _value)
+        {
+            cbtU32 length = (_value == nullptr) ? 0 : (cbtU32)std::strlen(reinterpret_cast<const cbtS8*>(_value));
+            return cbtLogAlign(sizeof(cbtU32) + length + 1);
+        }
+
+        static cbtByte* Encode(cbtByte* _buffer, T* _value)
+        {
+            cbtU32 length = (_value == nullptr) ? NULL_LENGTH : (cbtU32)std::strlen(reinterpret_cast<const cbtS8*>(_value));
+            std::memcpy(_buffer, &length, sizeof(cbtU32));
+            if (length == NULL_LENGTH)
+            { return _buffer + cbtLogAlign(sizeof(cbtU32) + 1); }
+
+            std::memcpy(_buffer + sizeof(cbtU32), _value, length);
+            _buffer[sizeof(cbtU32) + length] = '\0';
+            return _buffer + cbtLogAlign(sizeof(cbtU32) + length + 1);
+        }
+
+        static const cbtByte* Decode(const cbtByte* _buffer, DecodedType& _value)
+        {
+            cbtU32 length;
+            std::memcpy(&length, _buffer, sizeof(cbtU32));
+            if (length == NULL_LENGTH)
+            {
+                _value = nullptr;
+                return _buffer + cbtLogAlign(sizeof(cbtU32) + 1);
+            }
+
+            _value = reinterpret_cast<const cbtS8*>(_buffer + sizeof(cbtU32));
+            return _buffer + cbtLogAlign(sizeof(cbtU32) + length + 1);
+        }
+    };
+
+    /**
+        \brief Format a log message from the arguments copied into a log record.
+
+        \param _format The message string in printf() format.
+        \param _arguments The arguments, as written by cbtLogArgument::Encode.
+        \param _buffer The buffer to write the message to.
+        \param _bufferSize The size of _buffer.
+
+        \return The length of the whole message, which may be more than _bufferSize, as returned by snprintf().
+    */
+    template<typename... Args>
+    cbtS32 cbtFormatLogMessage(const cbtS8* _format, const cbtByte* _arguments, cbtS8* _buffer, cbtU32 _bufferSize)
+    {
+        std::tuple<typename cbtLogArgument<Args>::DecodedType...> values;
+        std::apply([&_arguments](auto& ... _values) { ((_arguments = cbtLogArgument<Args>::Decode(_arguments, _values)), ...); }, values);
+        return std::apply([_format, _buffer, _bufferSize](auto ... _values) { return std::snprintf(_buffer, _bufferSize, _format, _values...); }, values);
+    }
+
+    /// A pointer to cbtFormatLogMessage, instantiated for the types of a message's arguments.
+    typedef cbtS32 (* cbtLogFormatter)(const cbtS8* _format, const cbtByte* _arguments, cbtS8* _buffer, cbtU32 _bufferSize);
+
+NS_CBT_END
\ No newline at end of file
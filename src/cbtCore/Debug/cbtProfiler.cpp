@@ -0,0 +1,331 @@
+// Include CBT
+#include "cbtProfiler.h"
+#include "Debug/cbtDebug.h"
+#include "Core/FileUtil/cbtFileUtil.h"
+
+// Include STD
+#include <mutex>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdio>
+
+NS_CBT_BEGIN
+
+    static_assert((cbtProfiler::ZONE_CAPACITY & (cbtProfiler::ZONE_CAPACITY - 1)) == 0, "ZONE_CAPACITY must be a power of 2.");
+
+    /**
+        \brief
+            A zone recorded in a thread's ring buffer. The fields are written by the owning thread and may be read by an exporting thread
+            at the same time, so they are atomics. Relaxed atomics compile to plain loads and stores.
+    */
+    struct cbtProfileZone
+    {
+        std::atomic<const cbtS8*> m_Name { nullptr };
+        std::atomic<cbtU64> m_Begin { 0 };
+        std::atomic<cbtU64> m_End { 0 };
+    };
+
+    /// The zones recorded by a single thread.
+    struct cbtProfileThread
+    {
+        /// The ID of the thread in exported traces.
+        cbtU32 m_ID = 0;
+        /// The name of the thread in exported traces. Guarded by the registry's mutex.
+        cbtStr m_Name;
+        /// The number of zones ever recorded. Only the last ZONE_CAPACITY are kept.
+        std::atomic<cbtU64> m_WriteCount { 0 };
+        /// The number of zones added to the stats by EndFrame(). Guarded by the registry's mutex.
+        cbtU64 m_StatsReadCount = 0;
+        cbtProfileZone m_Zones[cbtProfiler::ZONE_CAPACITY];
+    };
+
+    /// The last STAT_WINDOW frame timings of a zone.
+    struct cbtProfileStatHistory
+    {
+        cbtF64 m_Samples[cbtProfiler::STAT_WINDOW] = {};
+        cbtU64 m_SampleCount = 0;
+    };
+
+    /// Every thread which has recorded a zone, the frame boundaries and the rolling timings.
+    struct cbtProfilerRegistry
+    {
+        std::mutex m_Mutex;
+        /// The threads are never deleted, so that their zones can still be exported after they exit.
+        std::vector<cbtProfileThread*> m_Threads;
+        /// The time each of the last FRAME_CAPACITY frames ended.
+        cbtU64 m_FrameEnds[cbtProfiler::FRAME_CAPACITY] = {};
+        /// The number of frames ever ended.
+        cbtU64 m_FrameCount = 0;
+        /// The ID of the thread which ends frames.
+        cbtU32 m_FrameThreadID = 0;
+        /// The rolling timings of each zone, keyed by domain and name.
+        std::map<std::pair<cbtProfileDomain, cbtStr>, cbtProfileStatHistory> m_Stats;
+    };
+
+    std::atomic<cbtBool> cbtProfiler::s_Enabled { false };
+
+    /**
+        \brief Get the registry. It is intentionally never deleted, so that zones can still be recorded during static destruction.
+
+        \return The registry.
+    */
+    static cbtProfilerRegistry& GetRegistry()
+    {
+        static cbtProfilerRegistry* registry = cbtNew cbtProfilerRegistry();
+        return *registry;
+    }
+
+    /**
+        \brief Get the calling thread's ring buffer, registering it on first use.
+
+        \return The calling thread's ring buffer.
+    */
+    static cbtProfileThread& GetThread()
+    {
+        thread_local cbtProfileThread* thread = []()
+        {
+            cbtProfileThread* newThread = cbtNew cbtProfileThread();
+            cbtProfilerRegistry& registry = GetRegistry();
+            std::lock_guard<std::mutex> lock(registry.m_Mutex);
+            newThread->m_ID = (cbtU32)registry.m_Threads.size();
+            newThread->m_Name = "Thread " + CBT_TO_STRING(newThread->m_ID);
+            registry.m_Threads.push_back(newThread);
+            return newThread;
+        }();
+        return *thread;
+    }
+
+    /// A zone copied out of a ring buffer for exporting.
+    struct cbtProfileZoneSnapshot
+    {
+        const cbtS8* m_Name;
+        cbtU64 m_Begin;
+        cbtU64 m_End;
+    };
+
+    /**
+        \brief
+            Copy the zones in a thread's ring buffer while the thread may still be recording.
+            Zones which might have been overwritten during the copy are discarded.
+
+        \param _thread The thread.
+        \param _from The index of the first zone to copy, if it is still in the ring buffer.
+        \param _zones The vector to append the zones to.
+
+        \return The index after the last zone copied.
+    */
+    static cbtU64 SnapshotZones(const cbtProfileThread& _thread, cbtU64 _from, std::vector<cbtProfileZoneSnapshot>& _zones)
+    {
+        const cbtU64 capacity = cbtProfiler::ZONE_CAPACITY;
+        cbtU64 end = _thread.m_WriteCount.load(std::memory_order_acquire);
+        cbtU64 begin = std::max(_from, end > capacity ? end - capacity : 0);
+
+        std::vector<cbtProfileZoneSnapshot> zones;
+        zones.reserve(end - begin);
+        for (cbtU64 i = begin; i < end; ++i)
+        {
+            const cbtProfileZone& zone = _thread.m_Zones[i & (capacity - 1)];
+            zones.push_back({ zone.m_Name.load(std::memory_order_relaxed), zone.m_Begin.load(std::memory_order_relaxed),
+                    zone.m_End.load(std::memory_order_relaxed) });
+        }
+
+        // The zone at index writeCount may be half written, and it shares a slot with index writeCount - capacity.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        cbtU64 writeCount = _thread.m_WriteCount.load(std::memory_order_relaxed);
+        cbtU64 firstValid = writeCount >= capacity ? writeCount - capacity + 1 : 0;
+        for (cbtU64 i = std::max(begin, firstValid); i < end; ++i)
+        { _zones.push_back(zones[i - begin]); }
+        return end;
+    }
+
+    /**
+        \brief Add a frame's timing of a zone to its history. The registry's mutex must be locked.
+    */
+    static void AddSampleLocked(cbtProfilerRegistry& _registry, const cbtStr& _name, cbtProfileDomain _domain, cbtF64 _milliseconds)
+    {
+        cbtProfileStatHistory& history = _registry.m_Stats[std::make_pair(_domain, _name)];
+        history.m_Samples[history.m_SampleCount % cbtProfiler::STAT_WINDOW] = _milliseconds;
+        ++history.m_SampleCount;
+    }
+
+    void cbtProfiler::SetEnabled(cbtBool _enabled)
+    {
+        s_Enabled.store(_enabled, std::memory_order_relaxed);
+    }
+
+    void cbtProfiler::EndZone(const cbtS8* _name, cbtU64 _begin)
+    {
+        cbtU64 end = GetTimestamp();
+        cbtProfileThread& thread = GetThread();
+
+        // Only this thread writes to its ring buffer, so a relaxed load of its own write count is enough.
+        cbtU64 writeCount = thread.m_WriteCount.load(std::memory_order_relaxed);
+        cbtProfileZone& zone = thread.m_Zones[writeCount & (ZONE_CAPACITY - 1)];
+        zone.m_Name.store(_name, std::memory_order_relaxed);
+        zone.m_Begin.store(_begin, std::memory_order_relaxed);
+        zone.m_End.store(end, std::memory_order_relaxed);
+        thread.m_WriteCount.store(writeCount + 1, std::memory_order_release);
+    }
+
+    void cbtProfiler::SetThreadName(const cbtStr& _name)
+    {
+        cbtProfileThread& thread = GetThread();
+        cbtProfilerRegistry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.m_Mutex);
+        thread.m_Name = _name;
+    }
+
+    void cbtProfiler::EndFrame()
+    {
+        cbtU64 timestamp = GetTimestamp();
+        cbtU32 threadID = GetThread().m_ID;
+        cbtProfilerRegistry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.m_Mutex);
+        registry.m_FrameEnds[registry.m_FrameCount % FRAME_CAPACITY] = timestamp;
+        ++registry.m_FrameCount;
+        registry.m_FrameThreadID = threadID;
+
+        // Skip the zones recorded while disabled, so that they are not counted once the profiler is enabled again.
+        if (!IsEnabled())
+        {
+            for (cbtU32 i = 0; i < registry.m_Threads.size(); ++i)
+            { registry.m_Threads[i]->m_StatsReadCount = registry.m_Threads[i]->m_WriteCount.load(std::memory_order_acquire); }
+            return;
+        }
+
+        // Sum the time spent in each zone which ended since the last frame, across every thread.
+        std::vector<cbtProfileZoneSnapshot> zones;
+        for (cbtU32 i = 0; i < registry.m_Threads.size(); ++i)
+        {
+            cbtProfileThread& thread = *registry.m_Threads[i];
+            thread.m_StatsReadCount = SnapshotZones(thread, thread.m_StatsReadCount, zones);
+        }
+
+        std::unordered_map<const cbtS8*, cbtU64> frameTimes;
+        for (cbtU32 i = 0; i < zones.size(); ++i)
+        { frameTimes[zones[i].m_Name] += zones[i].m_End - zones[i].m_Begin; }
+        for (auto iter = frameTimes.begin(); iter != frameTimes.end(); ++iter)
+        { AddSampleLocked(registry, iter->first, cbtProfileDomain::CPU, (cbtF64)iter->second / 1000000.0); }
+    }
+
+    void cbtProfiler::AddSample(const cbtStr& _name, cbtProfileDomain _domain, cbtF64 _milliseconds)
+    {
+        cbtProfilerRegistry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.m_Mutex);
+        AddSampleLocked(registry, _name, _domain, _milliseconds);
+    }
+
+    std::vector<cbtProfileStat> cbtProfiler::GetStats()
+    {
+        cbtProfilerRegistry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.m_Mutex);
+
+        std::vector<cbtProfileStat> stats;
+        for (auto iter = registry.m_Stats.begin(); iter != registry.m_Stats.end(); ++iter)
+        {
+            const cbtProfileStatHistory& history = iter->second;
+            cbtU32 windowSize = (cbtU32)std::min<cbtU64>(history.m_SampleCount, STAT_WINDOW);
+
+            cbtProfileStat stat;
+            stat.m_Domain = iter->first.first;
+            stat.m_Name = iter->first.second;
+            stat.m_LastMS = history.m_Samples[(history.m_SampleCount - 1) % STAT_WINDOW];
+            stat.m_SampleCount = history.m_SampleCount;
+            for (cbtU32 i = 0; i < windowSize; ++i)
+            {
+                stat.m_AverageMS += history.m_Samples[i];
+                stat.m_MaxMS = std::max(stat.m_MaxMS, history.m_Samples[i]);
+            }
+            stat.m_AverageMS /= (cbtF64)windowSize;
+            stats.push_back(stat);
+        }
+        return stats;
+    }
+
+    void cbtProfiler::LogStats()
+    {
+        std::vector<cbtProfileStat> stats = GetStats();
+        for (cbtU32 i = 0; i < stats.size(); ++i)
+        {
+            CBT_LOG_INFO(CBT_LOG_CATEGORY_APPLICATION, "Profiler %s %s: average %.3fms, max %.3fms, last %.3fms.",
+                    stats[i].m_Domain == cbtProfileDomain::CPU ? "CPU" : "GPU", stats[i].m_Name.c_str(), stats[i].m_AverageMS,
+                    stats[i].m_MaxMS, stats[i].m_LastMS);
+        }
+    }
+
+    void cbtProfiler::ExportChromeTrace(const cbtStr& _filePath, cbtU32 _frameCount)
+    {
+        // Copy everything needed out of the registry, so that threads are not blocked from registering while the trace is written.
+        std::vector<cbtU64> frameEnds;
+        std::vector<cbtProfileThread*> threads;
+        std::vector<cbtStr> threadNames;
+        cbtU64 firstFrame = 0;
+        cbtU32 frameThreadID = 0;
+        {
+            cbtProfilerRegistry& registry = GetRegistry();
+            std::lock_guard<std::mutex> lock(registry.m_Mutex);
+
+            cbtU64 frameCount = std::min<cbtU64>({ _frameCount, FRAME_CAPACITY - 1, registry.m_FrameCount ? registry.m_FrameCount - 1 : 0 });
+            firstFrame = registry.m_FrameCount - frameCount;
+            for (cbtU64 i = firstFrame - (registry.m_FrameCount ? 1 : 0); i < registry.m_FrameCount; ++i)
+            { frameEnds.push_back(registry.m_FrameEnds[i % FRAME_CAPACITY]); }
+            frameThreadID = registry.m_FrameThreadID;
+
+            threads = registry.m_Threads;
+            for (cbtU32 i = 0; i < threads.size(); ++i)
+            { threadNames.push_back(threads[i]->m_Name); }
+        }
+
+        // Export from the start of the first frame, or everything if no frames have ended.
+        cbtU64 startTime = frameEnds.empty() ? 0 : frameEnds.front();
+
+        cbtStr json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        cbtS8 buffer[512];
+        cbtBool firstEvent = true;
+        auto appendEvent = [&](const cbtS8* _name, cbtU32 _threadID, cbtU64 _begin, cbtU64 _end)
+        {
+            // Chrome traces are in microseconds.
+            cbtF64 begin = (cbtF64)(_begin - startTime) / 1000.0;
+            cbtF64 duration = (cbtF64)(_end - _begin) / 1000.0;
+            std::snprintf(buffer, sizeof(buffer), "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                    firstEvent ? "" : ",\n", _name, _threadID, begin, duration);
+            json += buffer;
+            firstEvent = false;
+        };
+
+        for (cbtU32 i = 0; i < threads.size(); ++i)
+        {
+            std::snprintf(buffer, sizeof(buffer), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                    firstEvent ? "" : ",\n", threads[i]->m_ID, threadNames[i].c_str());
+            json += buffer;
+            firstEvent = false;
+        }
+
+        for (cbtU32 i = 1; i < frameEnds.size(); ++i)
+        {
+            cbtS8 frameName[32];
+            std::snprintf(frameName, sizeof(frameName), "Frame %llu", firstFrame + i - 1);
+            appendEvent(frameName, frameThreadID, frameEnds[i - 1], frameEnds[i]);
+        }
+
+        std::vector<cbtProfileZoneSnapshot> zones;
+        for (cbtU32 i = 0; i < threads.size(); ++i)
+        {
+            zones.clear();
+            SnapshotZones(*threads[i], 0, zones);
+            for (cbtU32 j = 0; j < zones.size(); ++j)
+            {
+                if (zones[j].m_Begin >= startTime)
+                { appendEvent(zones[j].m_Name, threads[i]->m_ID, zones[j].m_Begin, zones[j].m_End); }
+            }
+        }
+
+        json += "\n]}\n";
+        cbtFileUtil::StringToFile(_filePath, json);
+        CBT_LOG_INFO(CBT_LOG_CATEGORY_APPLICATION, "Exported %u frames of profiling data to %s.",
+                frameEnds.empty() ? 0 : (cbtU32)frameEnds.size() - 1, _filePath.c_str());
+    }
+
+NS_CBT_END
\ No newline at end of file
@@ -0,0 +1,185 @@
+#pragma once
+
+// Include CBT
+#include "cbtMacros.h"
+
+// Include STD
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+NS_CBT_BEGIN
+
+    /// Where a zone was timed.
+    enum class cbtProfileDomain
+    {
+        CPU,
+        GPU,
+    };
+
+    /// The rolling timings of a zone, over the last cbtProfiler::STAT_WINDOW frames it was recorded in.
+    struct cbtProfileStat
+    {
+        cbtStr m_Name;
+        cbtProfileDomain m_Domain = cbtProfileDomain::CPU;
+        /// The time spent in the zone during the last frame it was recorded in, in milliseconds.
+        cbtF64 m_LastMS = 0.0;
+        /// The average time spent in the zone per frame, in milliseconds.
+        cbtF64 m_AverageMS = 0.0;
+        /// The longest time spent in the zone in a single frame, in milliseconds.
+        cbtF64 m_MaxMS = 0.0;
+        /// The number of frames the zone has ever been recorded in.
+        cbtU64 m_SampleCount = 0;
+    };
+
+    /**
+        \brief
+            A hierarchical CPU profiler. Each thread records the zones it has timed into its own lock-free ring buffer,
+            and the last few frames can be exported as a Chrome trace (chrome://tracing or https://ui.perfetto.dev).
+            Zones are timed using CBT_PROFILE_SCOPE or CBT_REGION, and may be nested.
+            The profiler is disabled by default. While disabled, a zone costs a single branch.
+    */
+    class cbtProfiler
+    {
+    public:
+        /// The number of zones each thread's ring buffer can hold. Older zones are overwritten. Must be a power of 2.
+        static constexpr cbtU32 ZONE_CAPACITY = 16384;
+        /// The number of frame boundaries kept, which limits how many frames can be exported.
+        static constexpr cbtU32 FRAME_CAPACITY = 128;
+        /// The number of frames cbtProfileStat averages over.
+        static constexpr cbtU32 STAT_WINDOW = 60;
+
+    private:
+        static std::atomic<cbtBool> s_Enabled;
+
+        /**
+            \brief Private Constructor. All functions should be static. No objects of this class should be created.
+        */
+        cbtProfiler()
+        {
+        }
+
+        /**
+            \brief Private Destructor. All functions should be static. No objects of this class should be created.
+        */
+        ~cbtProfiler()
+        {
+        }
+
+    public:
+        inline static cbtBool IsEnabled()
+        {
+            return s_Enabled.load(std::memory_order_relaxed);
+        }
+
+        /**
+            \brief Enable or disable the profiler. Zones which are already open when the profiler is enabled are not recorded.
+
+            \param _enabled Should the profiler be enabled.
+        */
+        static void SetEnabled(cbtBool _enabled);
+
+        /**
+            \brief Get the current time in nanoseconds.
+
+            \return The current time in nanoseconds.
+        */
+        inline static cbtU64 GetTimestamp()
+        {
+            return static_cast<cbtU64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        /**
+            \brief
+                Record a zone on the calling thread, ending now. Use CBT_PROFILE_SCOPE instead of calling this directly.
+                Zones are stored flat. Nesting is recovered from their times when viewing the trace.
+
+            \param _name The name of the zone. Must be a string literal or otherwise outlive the profiler, as only the pointer is kept.
+            \param _begin The time the zone began, from GetTimestamp().
+        */
+        static void EndZone(const cbtS8* _name, cbtU64 _begin);
+
+        /**
+            \brief Name the calling thread in exported traces.
+
+            \param _name The name of the thread.
+        */
+        static void SetThreadName(const cbtStr& _name);
+
+        /**
+            \brief
+                Mark the end of a frame. Should be called once per frame by the main loop.
+                If the profiler is enabled, the time spent in each CPU zone which ended during the frame is added to its cbtProfileStat.
+        */
+        static void EndFrame();
+
+        /**
+            \brief Add a frame's timing of a zone to its cbtProfileStat. Used to report zones which are not timed by cbtProfileScope, such as GPU zones.
+
+            \param _name The name of the zone.
+            \param _domain Where the zone was timed.
+            \param _milliseconds The time spent in the zone during the frame.
+        */
+        static void AddSample(const cbtStr& _name, cbtProfileDomain _domain, cbtF64 _milliseconds);
+
+        /**
+            \brief Get the rolling timings of every zone recorded while the profiler was enabled.
+
+            \return The rolling timings of every zone, sorted by domain then name.
+        */
+        static std::vector<cbtProfileStat> GetStats();
+
+        /**
+            \brief Log the rolling timings of every zone.
+        */
+        static void LogStats();
+
+        /**
+            \brief Write the zones recorded during the last few frames to a Chrome trace JSON file.
+
+            \param _filePath The file path of the trace.
+            \param _frameCount The number of frames to export. Capped at the number of frames recorded, and FRAME_CAPACITY - 1.
+        */
+        static void ExportChromeTrace(const cbtStr& _filePath, cbtU32 _frameCount = FRAME_CAPACITY - 1);
+    };
+
+    /**
+        \brief Times a zone from its creation to its destruction if the profiler is enabled.
+    */
+    class cbtProfileScope
+    {
+    private:
+        /// The name of the zone, or nullptr if the profiler was disabled when the zone was opened.
+        const cbtS8* m_Name = nullptr;
+        cbtU64 m_Begin = 0;
+
+    public:
+        cbtProfileScope(const cbtS8* _name)
+        {
+            if (cbtProfiler::IsEnabled())
+            {
+                m_Name = _name;
+                m_Begin = cbtProfiler::GetTimestamp();
+            }
+        }
+
+        ~cbtProfileScope()
+        {
+            if (m_Name)
+            { cbtProfiler::EndZone(m_Name, m_Begin); }
+        }
+
+        cbtProfileScope(const cbtProfileScope&) = delete;
+        cbtProfileScope& operator=(const cbtProfileScope&) = delete;
+    };
+
+NS_CBT_END
+
+#define CBT_PROFILE_CONCAT_IMPL(__A__, __B__) __A__##__B__
+#define CBT_PROFILE_CONCAT(__A__, __B__) CBT_PROFILE_CONCAT_IMPL(__A__, __B__)
+
+/// Time the enclosing scope as a zone named __NAME__, which must be a string literal.
+#define CBT_PROFILE_SCOPE(__NAME__) NS_CBT::cbtProfileScope CBT_PROFILE_CONCAT(cbtProfileScope, __LINE__)(__NAME__)
+/// Time the enclosing function as a zone.
+#define CBT_PROFILE_FUNCTION() CBT_PROFILE_SCOPE(__func__)
\ No newline at end of file
@@ -9,7 +9,7 @@ NS_CBT_BEGIN
     cbtTransform::cbtTransform()
             :m_Parent(nullptr), m_Child(nullptr), m_SiblingPrev(nullptr), m_SiblingNext(nullptr),
              m_LocalPosition(cbtVector3F::ZERO), m_LocalScale(1.0f, 1.0f, 1.0f),
-             m_LocalRotation(cbtQuaternion::IDENTITY)
+             m_LocalRotation(cbtQuaternion::IDENTITY), m_HasPreviousState(false)
     {
     }
 
@@ -57,6 +57,7 @@ NS_CBT_BEGIN
         }
 
         m_Parent = m_SiblingNext = m_SiblingPrev = nullptr;
+        MarkChanged();
     }
 
     void cbtTransform::SetParent(cbtTransform* _parent)
@@ -77,6 +78,7 @@ NS_CBT_BEGIN
             m_SiblingNext->m_SiblingPrev = this;
         }
         m_Parent->m_Child = this;
+        MarkChanged();
     }
 
 // These functions will give the vector relative to the WORLD.
@@ -104,4 +106,17 @@ NS_CBT_BEGIN
         return cbtVector3F(matrix[3][0], matrix[3][1], matrix[3][2]);
     }
 
+// Interpolation
+    cbtTransformState cbtTransform::GetInterpolatedLocalState(cbtF32 _alpha) const
+    {
+        if (!m_HasPreviousState)
+        { return GetLocalState(); }
+
+        return cbtTransformState {
+                m_PreviousState.m_Position + (m_LocalPosition - m_PreviousState.m_Position) * _alpha,
+                cbtQuaternion::Slerp(m_PreviousState.m_Rotation, m_LocalRotation, _alpha, true),
+                m_PreviousState.m_Scale + (m_LocalScale - m_PreviousState.m_Scale) * _alpha
+        };
+    }
+
 NS_CBT_END
\ No newline at end of file
@@ -4,14 +4,27 @@
 #include "Core/Math/cbtVector3.h"
 #include "Core/Math/cbtQuaternion.h"
 #include "Game/Component/cbtComponent.h"
+#include "Core/General/cbtPasskey.h"
 
 // Include STD
 #include <list>
 
 NS_CBT_BEGIN
 
+    class cbtApplication;
+
+    /// The local position, rotation and scale of a cbtTransform.
+    struct cbtTransformState
+    {
+        cbtVector3F m_Position;
+        cbtQuaternion m_Rotation;
+        cbtVector3F m_Scale;
+    };
+
     class cbtTransform : public cbtComponent
     {
+        CBT_SLAB_ALLOCATED(cbtTransform)
+
     private:
         // Scene Graph
         cbtTransform* m_Parent;
@@ -24,6 +37,12 @@ NS_CBT_BEGIN
         cbtVector3F m_LocalScale;
         cbtQuaternion m_LocalRotation;
 
+        // Interpolation
+        /// The local state at the previous fixed update, which rendering interpolates from.
+        cbtTransformState m_PreviousState;
+        /// False until the first fixed update after the transform is created or ResetInterpolation() is called.
+        cbtBool m_HasPreviousState;
+
     public:
         cbtTransform(); ///< Constructor(s)
         virtual ~cbtTransform(); ///< Protected Destructor. Use Ref::Release instead.
@@ -84,11 +103,13 @@ NS_CBT_BEGIN
         void SetLocalPosition(const cbtVector3F& _position)
         {
             m_LocalPosition = _position;
+            MarkChanged();
         }
 
         void LocalTranslate(const cbtVector3F& _translation)
         {
             m_LocalPosition += _translation;
+            MarkChanged();
         }
 
         // Rotation
@@ -105,27 +126,32 @@ NS_CBT_BEGIN
         void SetLocalRotation(cbtF32 _angle, const cbtVector3F& _rotationAxis)
         {
             m_LocalRotation.SetToRotation(_angle, _rotationAxis);
+            MarkChanged();
         }
 
         void LocalRotate(cbtF32 _angle, const cbtVector3F& _rotationAxis)
         {
             m_LocalRotation = (cbtQuaternion(_angle, _rotationAxis) * m_LocalRotation).Normalized();
+            MarkChanged();
         }
 
         // LocalScale
         void SetLocalScale(const cbtVector3F& _scale)
         {
             m_LocalScale = _scale;
+            MarkChanged();
         }
 
         void LocalScale(const cbtVector3F& _scale)
         {
             m_LocalScale *= _scale;
+            MarkChanged();
         }
 
         void LocalScale(cbtF32 _scale)
         {
             m_LocalScale *= _scale;
+            MarkChanged();
         }
 
         /*
@@ -155,12 +181,78 @@ NS_CBT_BEGIN
             return GetLocalTranslationMatrix() * GetLocalRotationMatrix() * GetLocalScaleMatrix();
         }
 
+        // Interpolation
+        cbtTransformState GetLocalState() const
+        {
+            return cbtTransformState { m_LocalPosition, m_LocalRotation, m_LocalScale };
+        }
+
+        void SetLocalState(const cbtTransformState& _state)
+        {
+            m_LocalPosition = _state.m_Position;
+            m_LocalRotation = _state.m_Rotation;
+            m_LocalScale = _state.m_Scale;
+            MarkChanged();
+        }
+
+        /**
+            \brief
+                Set the local state without marking the transform as changed.
+                Used by cbtApplication to move a transform to its interpolated state for rendering and back, which is not a change to the simulation.
+
+            \param _state The local state.
+        */
+        void SetRenderedLocalState(cbtPasskey<cbtApplication>, const cbtTransformState& _state)
+        {
+            m_LocalPosition = _state.m_Position;
+            m_LocalRotation = _state.m_Rotation;
+            m_LocalScale = _state.m_Scale;
+        }
+
+        /**
+            \brief Remember the current local state as the state at the previous fixed update. Called by cbtApplication before every fixed update.
+        */
+        void SavePreviousState()
+        {
+            m_PreviousState = GetLocalState();
+            m_HasPreviousState = true;
+        }
+
+        /**
+            \brief Stop interpolating from the state at the previous fixed update, such as after teleporting, until the next fixed update.
+        */
+        void ResetInterpolation()
+        {
+            m_HasPreviousState = false;
+        }
+
+        /**
+            \brief Get the local state between the previous fixed update and the current one.
+
+            \param _alpha How far between the previous fixed update (0) and the current one (1) to interpolate.
+
+            \return The interpolated local state.
+        */
+        cbtTransformState GetInterpolatedLocalState(cbtF32 _alpha) const;
+
         // Any rotation is done relative to the object's parent orientation.
         cbtMatrix4F GetGlobalRotationMatrix() const
         {
             return m_Parent ? GetLocalRotationMatrix() * m_Parent->GetGlobalRotationMatrix() : GetLocalRotationMatrix();
         }
 
+        /**
+            \brief Check if this transform, or any of its ancestors, has changed since a change version, which means its global transform may have changed.
+
+            \param _version The change version.
+
+            \return True if the global transform may have changed after _version ended.
+        */
+        cbtBool HasGlobalChangedSince(cbtU32 _version) const
+        {
+            return HasChangedSince(_version) || (m_Parent && m_Parent->HasGlobalChangedSince(_version));
+        }
+
         // This function will give the model matrix relative to the WORLD.
         cbtMatrix4F GetGlobalModelMatrix() const
         {
@@ -7,19 +7,38 @@
 #include "Core/General/cbtSparseSet.h"
 #include "Core/General/cbtHandleSet.h"
 #include "Core/General/cbtFlags.h"
+#include "Core/Memory/cbtSlabAllocator.h"
+#include "Core/Memory/cbtMemoryTracker.h"
 
 // Include STD
+#include <algorithm>
 #include <utility>
+#include <typeinfo>
+#include <vector>
 
 NS_CBT_BEGIN
 
 // Forward Declaration(s)
     class cbtScene;
+    class cbtComponentPool;
 
 // Type Definition(s)
+/// Entities are 32bit handles, or 64bit handles if CBT_ENTITY_64BIT is defined.
+#ifdef CBT_ENTITY_64BIT
+    typedef cbtU64 cbtECS;
+#else
     typedef cbtU32 cbtECS;
+#endif
 
-    typedef cbtHandleSet<cbtECS> cbtEntityPool;
+/// The number of bits of an entity which store its index. The rest store its version. Defaults to half of the entity.
+#ifndef CBT_ENTITY_INDEX_BITS
+#define CBT_ENTITY_INDEX_BITS (CBT_BITSIZE(cbtECS) >> 1)
+#endif
+
+    typedef cbtHandleSet<cbtECS, CBT_ENTITY_INDEX_BITS> cbtEntityPool;
+
+/// The maximum number of entities a scene can hold. Limited by the index of an entity, and by the cbtS32 indices of cbtSparseSet.
+    constexpr cbtU64 CBT_MAX_ENTITY_COUNT = (cbtEntityPool::MAX_HANDLE_COUNT < 0x80000000ull) ? cbtEntityPool::MAX_HANDLE_COUNT : 0x80000000ull;
 
 // Component Flag(s)
 /// No Flags
@@ -71,12 +90,23 @@ NS_CBT_BEGIN
 /**
     \brief
         Base class of components. All components should inherit from cbtComponent.
+        Components which are created and destroyed in large numbers should declare CBT_SLAB_ALLOCATED.
+
+        Every component records the change version at which it last changed, so that systems can process only the components which changed
+        since they last ran. Derived classes call MarkChanged from every function which changes them.
 */
     class cbtComponent : public cbtManaged
     {
     private:
+        /// The current change version, which is stamped on components when they change.
+        static inline cbtU32 s_ChangeVersion = 1;
+
         /// The entity this component belongs to.
         cbtECS m_Entity;
+        /// The pool this component is stored in, or nullptr once it has been removed.
+        cbtComponentPool* m_Pool = nullptr;
+        /// The change version at which this component last changed.
+        cbtU32 m_ChangeVersion = 0;
 
     protected:
         /**
@@ -120,32 +150,159 @@ NS_CBT_BEGIN
         {
             return m_Entity;
         }
+
+        /**
+            \brief Set the pool this component is stored in, which is told when the component changes. Called by cbtComponentPool.
+
+            \param _pool The pool, or nullptr when the component is removed from it.
+        */
+        void SetPool(cbtPasskey<cbtComponentPool>, cbtComponentPool* _pool)
+        {
+            m_Pool = _pool;
+        }
+
+        /**
+            \brief Record that this component has changed in the current change version.
+        */
+        inline void MarkChanged();
+
+        inline cbtU32 GetChangeVersion() const
+        {
+            return m_ChangeVersion;
+        }
+
+        /**
+            \brief Check if this component has changed since a change version.
+
+            \param _version The change version.
+
+            \return True if this component changed after _version ended.
+        */
+        inline cbtBool HasChangedSince(cbtU32 _version) const
+        {
+            return m_ChangeVersion > _version;
+        }
+
+        inline static cbtU32 GetCurrentChangeVersion()
+        {
+            return s_ChangeVersion;
+        }
+
+        /**
+            \brief
+                Start a new change version. Called by cbtApplication at the start of every frame, and by systems which need to know which changes they have seen.
+                Must not be called while components are being changed on other threads.
+
+            \return The version which ended. Every change made before this call has this version or lower, and every change after it has a higher version.
+        */
+        inline static cbtU32 AdvanceChangeVersion()
+        {
+            return s_ChangeVersion++;
+        }
     };
 
 /**
     \brief
         A container for a pool of components.
-        Allows CBTScene to store all the components in a hash map, which would be impossible otherwise
+        Allows CBTScene to store all the components in a single table, which would be impossible otherwise
         as the various components do not have a common base class.
 */
     class cbtComponentPool
     {
     private:
-        /// The number of pages in the sparse set.
-        static constexpr cbtU32 PAGE_COUNT = 512;
         /// The number of paragraphs per page in the sparse set.
         static constexpr cbtU32 PARAGRAPH_COUNT = 512;
+        /// The number of pages in the sparse set, enough for every entity a scene can hold. Only the pages in use are allocated.
+        static constexpr cbtU32 PAGE_COUNT = (cbtU32)((CBT_MAX_ENTITY_COUNT + PARAGRAPH_COUNT - 1) / PARAGRAPH_COUNT);
+
+        /**
+            \brief
+                The operations which need to know the component type, for when the pool is used without it.
+                Each component type has a single static table, so a pool only stores a pointer to it.
+        */
+        struct VTable
+        {
+            /// Remove the component belonging to an entity from the pool, and return it without releasing it.
+            cbtComponent* (* m_Take)(void* _sparseSet, cbtECS _entity);
+            /// Check if an entity has a component.
+            cbtBool (* m_Has)(const void* _sparseSet, cbtECS _entity);
+            /// Get the number of components.
+            cbtU32 (* m_GetCount)(const void* _sparseSet);
+            /// Release every component and delete the sparse set.
+            void (* m_Destroy)(void* _sparseSet);
+            /// Get the position of an entity's component in the array of components.
+            cbtU32 (* m_GetDenseIndex)(const void* _sparseSet, cbtECS _entity);
+        };
+
+        /**
+            \brief The implementation of VTable for components of type T.
+        */
+        template<typename T>
+        struct Operations
+        {
+            typedef cbtSparseSet<T*, PAGE_COUNT, PARAGRAPH_COUNT> SparseSet;
+
+            static cbtComponent* Take(void* _sparseSet, cbtECS _entity)
+            {
+                SparseSet* sparseSet = static_cast<SparseSet*>(_sparseSet);
+                cbtECS index = cbtEntityPool::GetIndex(_entity);
+                T* component = (*sparseSet)[index];
+                sparseSet->Remove(index);
+                return component;
+            }
+
+            static cbtBool Has(const void* _sparseSet, cbtECS _entity)
+            {
+                return static_cast<const SparseSet*>(_sparseSet)->Has(cbtEntityPool::GetIndex(_entity));
+            }
+
+            static cbtU32 GetCount(const void* _sparseSet)
+            {
+                return static_cast<const SparseSet*>(_sparseSet)->GetCount();
+            }
+
+            static void Destroy(void* _sparseSet)
+            {
+                SparseSet* sparseSet = static_cast<SparseSet*>(_sparseSet);
+                T** componentArray = sparseSet->GetArray();
+                for (cbtU32 i = 0; i < sparseSet->GetCount(); ++i)
+                {
+                    componentArray[i]->SetPool({}, nullptr);
+                    componentArray[i]->AutoRelease();
+                }
+                delete sparseSet;
+            }
+
+            static cbtU32 GetDenseIndex(const void* _sparseSet, cbtECS _entity)
+            {
+                return (cbtU32)static_cast<const SparseSet*>(_sparseSet)->GetDenseIndex(cbtEntityPool::GetIndex(_entity));
+            }
+
+            static constexpr VTable s_VTable = { &Take, &Has, &GetCount, &Destroy, &GetDenseIndex };
+        };
 
         /// The sparse set containing the components.
         void* m_SparseSet = nullptr;
-        /// A function to remove a component. As we may not know the component type when removing, we need to store it as a lambda function in advance.
-        std::function<void(cbtECS)> m_Remove = nullptr;
-        /// A function to check if we have a component. As we may not know the component type when checking, we need to store it as a lambda function in advance.
-        std::function<cbtBool(cbtECS)> m_Has = nullptr;
-        /// A function to check how many of the components we have. As we may not know the component type when checking, we need to store it as a lambda function in advance.
-        std::function<cbtECS(void)> m_GetCount = nullptr;
-        ///  A function to delete the components in the destructor. As we may not know the component type when deleting, we need to store it as a lambda function in advance.
-        std::function<void(void)> m_Destructor = nullptr;
+        /// The operations for the type of component in this pool.
+        const VTable* m_VTable = nullptr;
+        /**
+            The highest change version of the components in each chunk of CHUNK_SIZE components in the array of components.
+            May be higher than the highest version in the chunk, but never lower, so chunks which have not changed can be skipped.
+        */
+        std::vector<cbtU32> m_ChunkVersions;
+
+        /**
+            \brief Recompute the change version of every chunk, after the components have been reordered.
+        */
+        template<typename T>
+        void RebuildChunkVersions()
+        {
+            T** components = GetArray<T>();
+            cbtU32 count = GetCount();
+            m_ChunkVersions.assign((count + CHUNK_SIZE - 1) / CHUNK_SIZE, 0);
+            for (cbtU32 i = 0; i < count; ++i)
+            { m_ChunkVersions[i / CHUNK_SIZE] = std::max(m_ChunkVersions[i / CHUNK_SIZE], components[i]->GetChangeVersion()); }
+        }
 
         /**
             \brief Private Constructor. Create an instance of CBTComponentPool using CreateComponentPool.
@@ -155,12 +312,18 @@ NS_CBT_BEGIN
         }
 
     public:
+        /// The number of components which share an entry in the pool's change versions.
+        static constexpr cbtU32 CHUNK_SIZE = 64;
+
+        cbtComponentPool(const cbtComponentPool&) = delete;
+        cbtComponentPool& operator=(const cbtComponentPool&) = delete;
+
         /**
             \brief Destructor
         */
         ~cbtComponentPool()
         {
-            m_Destructor();
+            m_VTable->m_Destroy(m_SparseSet);
         }
 
         /**
@@ -170,7 +333,66 @@ NS_CBT_BEGIN
         */
         void Remove(cbtECS _entity)
         {
-            m_Remove(_entity);
+            Take(_entity)->AutoRelease();
+        }
+
+        /**
+            \brief Remove the component belonging to an entity without releasing it, so that many components can be released at once.
+
+            \param _entity The entity whose component to remove.
+
+            \return The removed component. The caller must release it.
+        */
+        cbtComponent* Take(cbtECS _entity)
+        {
+            // The last component is moved into the removed component's place, so its chunk takes on the last chunk's version.
+            cbtU32 chunk = m_VTable->m_GetDenseIndex(m_SparseSet, _entity) / CHUNK_SIZE;
+            cbtU32 lastChunk = (GetCount() - 1) / CHUNK_SIZE;
+            m_ChunkVersions[chunk] = std::max(m_ChunkVersions[chunk], m_ChunkVersions[lastChunk]);
+            m_ChunkVersions.resize((GetCount() - 1 + CHUNK_SIZE - 1) / CHUNK_SIZE);
+
+            cbtComponent* component = m_VTable->m_Take(m_SparseSet, _entity);
+            component->SetPool({}, nullptr);
+            return component;
+        }
+
+        /**
+            \brief Record that an entity's component has changed. Called by cbtComponent::MarkChanged.
+
+            \param _entity The entity whose component changed.
+            \param _version The change version the component changed in.
+        */
+        void MarkChanged(cbtECS _entity, cbtU32 _version)
+        {
+            cbtU32 chunk = m_VTable->m_GetDenseIndex(m_SparseSet, _entity) / CHUNK_SIZE;
+            if (chunk >= m_ChunkVersions.size())
+            { m_ChunkVersions.resize(chunk + 1, 0); }
+            m_ChunkVersions[chunk] = std::max(m_ChunkVersions[chunk], _version);
+        }
+
+        /**
+            \brief Call a function with every component which has changed since a change version, in the order of the array of components.
+                Chunks of components which have not changed are skipped without reading the components.
+
+            \param _version The change version.
+            \param _function A function which takes a T*.
+        */
+        template<typename T, typename Function>
+        void ForEachChangedSince(cbtU32 _version, Function&& _function)
+        {
+            T** components = GetArray<T>();
+            cbtU32 count = GetCount();
+            for (cbtU32 chunk = 0; chunk < m_ChunkVersions.size(); ++chunk)
+            {
+                if (m_ChunkVersions[chunk] <= _version)
+                { continue; }
+                cbtU32 end = std::min(count, (chunk + 1) * CHUNK_SIZE);
+                for (cbtU32 i = chunk * CHUNK_SIZE; i < end; ++i)
+                {
+                    if (components[i]->HasChangedSince(_version))
+                    { _function(components[i]); }
+                }
+            }
         }
 
         /**
@@ -182,7 +404,7 @@ NS_CBT_BEGIN
         */
         cbtBool Has(cbtECS _entity) const
         {
-            return m_Has(_entity);
+            return m_VTable->m_Has(m_SparseSet, _entity);
         }
 
         /**
@@ -192,7 +414,7 @@ NS_CBT_BEGIN
         */
         cbtU32 GetCount() const
         {
-            return m_GetCount();
+            return m_VTable->m_GetCount(m_SparseSet);
         }
 
         /**
@@ -247,6 +469,33 @@ NS_CBT_BEGIN
             return static_cast<SparseSet*>(m_SparseSet)->GetArray();
         }
 
+        /**
+            \brief Sort the components in this pool.
+
+            \param _compare A function which takes two const T* and returns true if the first component should come before the second.
+        */
+        template<typename T, typename Compare>
+        void Sort(Compare _compare)
+        {
+            typedef cbtSparseSet<T*, PAGE_COUNT, PARAGRAPH_COUNT> SparseSet;
+            static_cast<SparseSet*>(m_SparseSet)->Sort([&_compare](const T* _a, const T* _b) { return _compare(_a, _b); });
+            RebuildChunkVersions<T>();
+        }
+
+        /**
+            \brief Reorder the components in this pool to follow the order of the entities in another pool.
+
+            \param _other The pool whose order to follow. It must store components of type U.
+        */
+        template<typename T, typename U>
+        void SortAs(const cbtComponentPool& _other)
+        {
+            typedef cbtSparseSet<T*, PAGE_COUNT, PARAGRAPH_COUNT> SparseSet;
+            typedef cbtSparseSet<U*, PAGE_COUNT, PARAGRAPH_COUNT> OtherSparseSet;
+            static_cast<SparseSet*>(m_SparseSet)->SortAs(*static_cast<const OtherSparseSet*>(_other.m_SparseSet));
+            RebuildChunkVersions<T>();
+        }
+
         /**
             \brief Add a component and assign it to an entity.
 
@@ -266,15 +515,78 @@ NS_CBT_BEGIN
                 CBT_ASSERT(sparseSet->GetCount() == 0);
             }
 
+            // Record the memory used by the component, including anything it allocates when it awakes, under its type.
+            CBT_MEMORY_TAG(typeid(T).name());
             T* component = cbtNew T();
             component->Retain();
             component->Init(_entity);
+            component->SetPool({}, this);
             sparseSet->Insert(cbtEntityPool::GetIndex(_entity), component);
+            // A new component counts as changed.
+            component->MarkChanged();
             component->Awake(std::forward<Args>(_args)...);
 
             return component;
         }
 
+        /**
+            \brief Add a component to each of several entities, growing the pool once for all of them.
+
+            \param _entities The entities to add components to.
+            \param _count The number of entities.
+            \param _initialiser A function called with each component and its position in _entities, after the component has awoken.
+        */
+        template<typename T, typename Initialiser>
+        void AddMany(const cbtECS* _entities, cbtU32 _count, Initialiser&& _initialiser)
+        {
+            typedef cbtSparseSet<T*, PAGE_COUNT, PARAGRAPH_COUNT> SparseSet;
+            SparseSet* sparseSet = static_cast<SparseSet*>(m_SparseSet);
+
+            if (cbtFlags<T>::HasFlags(CBT_COMPONENT_FLAG_SCENE_UNIQUE))
+            {
+                CBT_ASSERT(sparseSet->GetCount() + _count <= 1);
+            }
+
+            // Grow geometrically, so that many small batches do not reallocate every time.
+            sparseSet->Reserve(std::max(sparseSet->GetCount() + _count, sparseSet->GetCount() * 2));
+
+            // Construct every component before any awakes, and auto-release them together rather than locking the release pool once each.
+            // Nothing else may be created while auto-release is deferred, and component constructors do not create anything.
+            CBT_MEMORY_TAG(typeid(T).name());
+            std::vector<cbtManaged*> components(_count);
+            {
+                cbtManaged::DeferAutoReleaseScope deferAutoRelease;
+                if constexpr (cbtIsSlabAllocated<T>::value)
+                {
+                    // Take every block from the slab allocator under a single lock. The components are freed as usual by T::operator delete.
+                    std::vector<void*> blocks(_count);
+                    cbtSlabAllocator<T>::AllocateMany(blocks.data(), _count);
+                    for (cbtU32 i = 0; i < _count; ++i)
+                    { components[i] = ::new(blocks[i]) T(); }
+                }
+                else
+                {
+                    for (cbtU32 i = 0; i < _count; ++i)
+                    { components[i] = cbtNew T(); }
+                }
+                // Anything else created in this scope would never be auto-released.
+                CBT_ASSERT(deferAutoRelease.GetCreatedCount() == _count);
+            }
+            cbtManaged::AutoRelease(components.data(), _count);
+
+            for (cbtU32 i = 0; i < _count; ++i)
+            {
+                T* component = static_cast<T*>(components[i]);
+                component->Retain();
+                component->Init(_entities[i]);
+                component->SetPool({}, this);
+                sparseSet->Insert(cbtEntityPool::GetIndex(_entities[i]), component);
+                component->MarkChanged();
+                component->Awake();
+                _initialiser(component, i);
+            }
+        }
+
         /**
             \brief
                 Create a CBTComponentPool to store components of type T.
@@ -288,33 +600,21 @@ NS_CBT_BEGIN
             typedef cbtSparseSet<T*, PAGE_COUNT, PARAGRAPH_COUNT> SparseSet;
             cbtComponentPool* componentPool = cbtNew cbtComponentPool();
             componentPool->m_SparseSet = static_cast<void*>(cbtNew SparseSet());
-            componentPool->m_Remove = [componentPool](cbtECS _entity) -> void
-            {
-              SparseSet* sparseSet = static_cast<SparseSet*>(componentPool->m_SparseSet);
-              cbtECS index = cbtEntityPool::GetIndex(_entity);
-              (*sparseSet)[index]->AutoRelease();
-              sparseSet->Remove(index);
-            };
-            componentPool->m_Has = [componentPool](cbtECS _entity) -> cbtBool
-            {
-              return static_cast<SparseSet*>(componentPool->m_SparseSet)->Has(cbtEntityPool::GetIndex(_entity));
-            };
-            componentPool->m_GetCount = [componentPool](void) -> cbtU32
-            {
-              return static_cast<SparseSet*>(componentPool->m_SparseSet)->GetCount();
-            };
-            componentPool->m_Destructor = [componentPool](void) -> void
-            {
-              SparseSet* sparseSet = static_cast<SparseSet*>(componentPool->m_SparseSet);
-              T** componentArray = sparseSet->GetArray();
-              for (cbtU32 i = 0; i < sparseSet->GetCount(); ++i)
-              { componentArray[i]->AutoRelease(); }
-              delete sparseSet;
-            };
+            componentPool->m_VTable = &Operations<T>::s_VTable;
             return componentPool;
         }
     };
 
+    inline void cbtComponent::MarkChanged()
+    {
+        // The pool only needs to be told the first time the component changes in a version.
+        if (m_ChangeVersion == s_ChangeVersion)
+        { return; }
+        m_ChangeVersion = s_ChangeVersion;
+        if (m_Pool != nullptr)
+        { m_Pool->MarkChanged(m_Entity, m_ChangeVersion); }
+    }
+
 /**
     \brief
         A CBTComponentGroup is used to store arrays of components belonging to entities that have all of the specified components.
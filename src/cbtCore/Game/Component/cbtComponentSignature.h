@@ -0,0 +1,124 @@
+#pragma once
+
+// Include CBT
+#include "cbtMacros.h"
+#include "Core/General/cbtFamily.h"
+#include "Core/General/cbtRef.h"
+#include "Debug/cbtDebug.h"
+
+NS_CBT_BEGIN
+
+/// \brief The maximum number of component types. Each component type takes 1 bit of every entity's cbtComponentSignature.
+#define CBT_MAX_COMPONENT_TYPES 128
+
+/**
+    \brief
+        The set of component types an entity has, with one bit per component type, indexed by the component type's cbtFamily<cbtManaged> ID.
+        Signatures are compared a whole word at a time, which the compiler can turn into SIMD instructions.
+*/
+    class cbtComponentSignature
+    {
+    private:
+        /// The number of 64bit words in a signature.
+        static constexpr cbtU32 WORD_COUNT = (CBT_MAX_COMPONENT_TYPES + 63) / 64;
+
+        cbtU64 m_Words[WORD_COUNT];
+
+        template<typename T>
+        void SetTypes()
+        {
+            Set(cbtFamily<cbtManaged>::GetID<T>());
+        }
+
+        template<typename T, typename U, typename ...Args>
+        void SetTypes()
+        {
+            Set(cbtFamily<cbtManaged>::GetID<T>());
+            SetTypes<U, Args...>();
+        }
+
+    public:
+        /**
+            \brief Constructor. The signature starts with no component types.
+
+            \return An empty cbtComponentSignature.
+        */
+        cbtComponentSignature()
+        {
+            Clear();
+        }
+
+        /**
+            \brief Get the signature of a set of component types.
+
+            \return A signature with the bit of every component type in Args set.
+        */
+        template<typename ...Args>
+        static cbtComponentSignature Create()
+        {
+            cbtComponentSignature signature;
+            if constexpr (sizeof...(Args) != 0)
+            { signature.SetTypes<Args...>(); }
+            return signature;
+        }
+
+        inline void Set(cbtS32 _typeID)
+        {
+            CBT_ASSERT(_typeID >= 0 && _typeID < CBT_MAX_COMPONENT_TYPES);
+            m_Words[_typeID >> 6] |= (cbtU64)1 << (_typeID & 63);
+        }
+
+        inline void Reset(cbtS32 _typeID)
+        {
+            CBT_ASSERT(_typeID >= 0 && _typeID < CBT_MAX_COMPONENT_TYPES);
+            m_Words[_typeID >> 6] &= ~((cbtU64)1 << (_typeID & 63));
+        }
+
+        inline cbtBool Test(cbtS32 _typeID) const
+        {
+            CBT_ASSERT(_typeID >= 0 && _typeID < CBT_MAX_COMPONENT_TYPES);
+            return (m_Words[_typeID >> 6] & ((cbtU64)1 << (_typeID & 63))) != 0;
+        }
+
+        inline void Clear()
+        {
+            for (cbtU32 i = 0; i < WORD_COUNT; ++i)
+            { m_Words[i] = 0; }
+        }
+
+        /**
+            \brief Check if this signature has every component type in another signature.
+
+            \param _other The component types to check for.
+
+            \return True if every bit set in _other is also set in this signature.
+        */
+        inline cbtBool Contains(const cbtComponentSignature& _other) const
+        {
+            cbtU64 missing = 0;
+            for (cbtU32 i = 0; i < WORD_COUNT; ++i)
+            { missing |= _other.m_Words[i] & ~m_Words[i]; }
+            return missing == 0;
+        }
+
+        /**
+            \brief Call a function with the ID of every component type in this signature, in increasing order.
+
+            \param _function The function, which takes a cbtS32 type ID.
+        */
+        template<typename Function>
+        void ForEach(Function&& _function) const
+        {
+            for (cbtU32 i = 0; i < WORD_COUNT; ++i)
+            {
+                cbtU64 word = m_Words[i];
+                for (cbtU32 bit = 0; word != 0; ++bit, word >>= 1)
+                {
+                    if (word & 1)
+                    { _function((cbtS32)(i * 64 + bit)); }
+                }
+            }
+        }
+    };
+
+NS_CBT_END
\ No newline at end of file
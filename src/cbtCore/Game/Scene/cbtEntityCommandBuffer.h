@@ -0,0 +1,308 @@
+#pragma once
+
+// Include CBT
+#include "cbtMacros.h"
+#include "Debug/cbtDebug.h"
+#include "cbtScene.h"
+
+// Include STD
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+NS_CBT_BEGIN
+
+    /// An entity created by a cbtEntityCommandBuffer, which does not exist until the buffer is played back.
+    struct cbtDeferredEntity
+    {
+        /// The position of the entity among the entities created by the buffer.
+        cbtU32 m_Index;
+    };
+
+/**
+    \brief
+        Records entity & component creations and removals, so that they can be made to a cbtScene later, at a point where nothing is iterating over it.
+        This allows systems to make structural changes while iterating over a cbtComponentGroup, or from several threads, each with its own buffer.
+        A buffer must only be recorded into by one thread at a time. Commands are played back in the order they were recorded.
+
+        The arguments of recorded components are placed in fixed size blocks of memory which are reused after playback, like cbtEventQueue,
+        so once a buffer has grown to fit a frame's commands, recording does not allocate.
+
+        Commands on entities which no longer exist when they are played back are ignored, as are adding a component the entity already has
+        and removing one it does not have, so that two buffers may safely make the same change.
+*/
+    class cbtEntityCommandBuffer
+    {
+    public:
+        /// The size of each block of memory component arguments are placed in.
+        static constexpr cbtU32 BLOCK_SIZE = 4096;
+
+    private:
+        enum CommandType : cbtU8
+        {
+            CBT_COMMAND_CREATE_ENTITY,
+            CBT_COMMAND_REMOVE_ENTITY,
+            CBT_COMMAND_ADD_COMPONENT,
+            CBT_COMMAND_REMOVE_COMPONENT,
+        };
+
+        /// Adds or removes a component of a type.
+        typedef void (* ComponentFunction)(cbtScene& _scene, cbtECS _entity, void* _arguments);
+        /// Destroys the arguments of a component.
+        typedef void (* DestroyFunction)(void* _arguments);
+
+        struct Command
+        {
+            CommandType m_Type;
+            /// True if m_Entity is the index of an entity created by this buffer, rather than an existing entity.
+            cbtBool m_Deferred;
+            cbtECS m_Entity;
+            ComponentFunction m_Function;
+            DestroyFunction m_Destroy;
+            void* m_Arguments;
+        };
+
+        /// The blocks of memory component arguments are placed in. Blocks are never freed until the buffer is destroyed.
+        std::vector<cbtByte*> m_Blocks;
+        /// The block the next arguments are placed in.
+        cbtU32 m_BlockIndex = 0;
+        /// The offset in the current block the next arguments are placed at.
+        cbtU32 m_BlockOffset = 0;
+        /// The recorded commands, in the order they were recorded.
+        std::vector<Command> m_Commands;
+        /// The number of entities created by the recorded commands.
+        cbtU32 m_CreatedCount = 0;
+        /// The entities created by the last playback, indexed by cbtDeferredEntity::m_Index.
+        std::vector<cbtECS> m_CreatedEntities;
+
+        /**
+            \brief Reserve memory for a component's arguments.
+
+            \param _size The size of the arguments.
+            \param _alignment The alignment of the arguments.
+
+            \return The memory to place the arguments in.
+        */
+        void* Allocate(cbtU32 _size, cbtU32 _alignment)
+        {
+            cbtU32 offset = (m_BlockOffset + _alignment - 1) & ~(_alignment - 1);
+            if (m_BlockIndex < m_Blocks.size() && offset + _size > BLOCK_SIZE)
+            {
+                ++m_BlockIndex;
+                offset = 0;
+            }
+            if (m_BlockIndex == m_Blocks.size())
+            { m_Blocks.push_back(cbtNew cbtByte[BLOCK_SIZE]); }
+
+            m_BlockOffset = offset + _size;
+            return m_Blocks[m_BlockIndex] + offset;
+        }
+
+        template<typename T, typename Arguments>
+        static void AddComponentFunction(cbtScene& _scene, cbtECS _entity, void* _arguments)
+        {
+            if (_scene.HasComponent<T>(_entity))
+            { return; }
+            std::apply([&_scene, _entity](auto& ... _args) { _scene.AddComponent<T>(_entity, std::move(_args)...); }, *static_cast<Arguments*>(_arguments));
+        }
+
+        template<typename T>
+        static void RemoveComponentFunction(cbtScene& _scene, cbtECS _entity, void*)
+        {
+            if (_scene.HasComponent<T>(_entity))
+            { _scene.RemoveComponent<T>(_entity); }
+        }
+
+        template<typename Arguments>
+        static void DestroyArguments(void* _arguments)
+        {
+            static_cast<Arguments*>(_arguments)->~Arguments();
+        }
+
+        template<typename T, typename ...Args>
+        void RecordAddComponent(cbtBool _deferred, cbtECS _entity, Args&& ... _args)
+        {
+            typedef std::tuple<std::decay_t<Args>...> Arguments;
+            static_assert(sizeof(Arguments) <= BLOCK_SIZE, "The arguments of a component must fit in a block of the entity command buffer.");
+            static_assert(alignof(Arguments) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "The arguments of a component must not be over-aligned.");
+            void* arguments = new (Allocate(sizeof(Arguments), alignof(Arguments))) Arguments(std::forward<Args>(_args)...);
+            m_Commands.push_back({ CBT_COMMAND_ADD_COMPONENT, _deferred, _entity, &AddComponentFunction<T, Arguments>, &DestroyArguments<Arguments>, arguments });
+        }
+
+        /**
+            \brief Get the entity a command applies to.
+
+            \return The entity. A cbtDeferredEntity is always created by an earlier command of the same playback.
+        */
+        cbtECS GetEntity(const Command& _command) const
+        {
+            return _command.m_Deferred ? m_CreatedEntities[_command.m_Entity] : _command.m_Entity;
+        }
+
+    public:
+        /**
+            \brief Default Constructor.
+
+            \return A cbtEntityCommandBuffer.
+        */
+        cbtEntityCommandBuffer()
+        {
+        }
+
+        cbtEntityCommandBuffer(const cbtEntityCommandBuffer&) = delete;
+        cbtEntityCommandBuffer& operator=(const cbtEntityCommandBuffer&) = delete;
+
+        /**
+            \brief Destructor. Recorded commands are discarded without being played back.
+        */
+        ~cbtEntityCommandBuffer()
+        {
+            Clear();
+            for (cbtU32 i = 0; i < m_Blocks.size(); ++i)
+            { delete[] m_Blocks[i]; }
+        }
+
+        inline cbtU32 GetCommandCount() const { return (cbtU32)m_Commands.size(); }
+
+        inline cbtBool IsEmpty() const { return m_Commands.empty(); }
+
+        /**
+            \brief Record the creation of an entity.
+
+            \return The entity to be created, which components can be added to before it exists.
+        */
+        cbtDeferredEntity AddEntity()
+        {
+            m_Commands.push_back({ CBT_COMMAND_CREATE_ENTITY, true, (cbtECS)m_CreatedCount, nullptr, nullptr, nullptr });
+            return { m_CreatedCount++ };
+        }
+
+        /**
+            \brief Record the removal of an entity and all of its components.
+
+            \param _entity The entity to remove.
+        */
+        void RemoveEntity(cbtECS _entity)
+        {
+            m_Commands.push_back({ CBT_COMMAND_REMOVE_ENTITY, false, _entity, nullptr, nullptr, nullptr });
+        }
+
+        void RemoveEntity(cbtDeferredEntity _entity)
+        {
+            CBT_ASSERT(_entity.m_Index < m_CreatedCount);
+            m_Commands.push_back({ CBT_COMMAND_REMOVE_ENTITY, true, (cbtECS)_entity.m_Index, nullptr, nullptr, nullptr });
+        }
+
+        /**
+            \brief Record the addition of a component to an entity.
+
+            \param _entity The entity to add the component to.
+            \param _args The arguments to awake the component with. They are copied or moved into the buffer.
+        */
+        template<typename T, typename ...Args>
+        void AddComponent(cbtECS _entity, Args&& ... _args)
+        {
+            RecordAddComponent<T>(false, _entity, std::forward<Args>(_args)...);
+        }
+
+        template<typename T, typename ...Args>
+        void AddComponent(cbtDeferredEntity _entity, Args&& ... _args)
+        {
+            CBT_ASSERT(_entity.m_Index < m_CreatedCount);
+            RecordAddComponent<T>(true, (cbtECS)_entity.m_Index, std::forward<Args>(_args)...);
+        }
+
+        /**
+            \brief Record the removal of a component from an entity.
+
+            \param _entity The entity to remove the component from.
+        */
+        template<typename T>
+        void RemoveComponent(cbtECS _entity)
+        {
+            m_Commands.push_back({ CBT_COMMAND_REMOVE_COMPONENT, false, _entity, &RemoveComponentFunction<T>, nullptr, nullptr });
+        }
+
+        template<typename T>
+        void RemoveComponent(cbtDeferredEntity _entity)
+        {
+            CBT_ASSERT(_entity.m_Index < m_CreatedCount);
+            m_Commands.push_back({ CBT_COMMAND_REMOVE_COMPONENT, true, (cbtECS)_entity.m_Index, &RemoveComponentFunction<T>, nullptr, nullptr });
+        }
+
+        /**
+            \brief Make the recorded changes to a scene, in the order they were recorded, then clear the buffer.
+
+            \param _scene The scene. Nothing may be iterating over or changing it during playback.
+
+            \sa GetCreatedEntity
+        */
+        void Playback(cbtScene& _scene)
+        {
+            m_CreatedEntities.assign(m_CreatedCount, 0);
+            for (cbtU32 i = 0; i < m_Commands.size(); ++i)
+            {
+                const Command& command = m_Commands[i];
+                if (command.m_Type == CBT_COMMAND_CREATE_ENTITY)
+                {
+                    m_CreatedEntities[command.m_Entity] = _scene.AddEntity();
+                    continue;
+                }
+
+                cbtECS entity = GetEntity(command);
+                if (!_scene.HasEntity(entity))
+                { continue; }
+                if (command.m_Type == CBT_COMMAND_REMOVE_ENTITY)
+                { _scene.RemoveEntity(entity); }
+                else
+                { command.m_Function(_scene, entity, command.m_Arguments); }
+            }
+            Clear();
+        }
+
+        /**
+            \brief Play back several buffers, one after another, so that changes recorded by several threads are made in a deterministic order.
+
+            \param _scene The scene. Nothing may be iterating over or changing it during playback.
+            \param _buffers The buffers, in the order to play them back in. For example, ordered by the index of the thread which recorded them.
+            \param _count The number of buffers.
+        */
+        static void Playback(cbtScene& _scene, cbtEntityCommandBuffer* const* _buffers, cbtU32 _count)
+        {
+            for (cbtU32 i = 0; i < _count; ++i)
+            { _buffers[i]->Playback(_scene); }
+        }
+
+        /**
+            \brief Get an entity created by the last playback.
+
+            \param _entity The entity returned by AddEntity before the playback.
+
+            \return The created entity.
+        */
+        cbtECS GetCreatedEntity(cbtDeferredEntity _entity) const
+        {
+            CBT_ASSERT(_entity.m_Index < m_CreatedEntities.size());
+            return m_CreatedEntities[_entity.m_Index];
+        }
+
+        /**
+            \brief Discard every recorded command, keeping the memory they used for the next commands.
+        */
+        void Clear()
+        {
+            for (cbtU32 i = 0; i < m_Commands.size(); ++i)
+            {
+                if (m_Commands[i].m_Destroy != nullptr)
+                { m_Commands[i].m_Destroy(m_Commands[i].m_Arguments); }
+            }
+            m_Commands.clear();
+            m_CreatedCount = 0;
+            m_BlockIndex = 0;
+            m_BlockOffset = 0;
+        }
+    };
+
+NS_CBT_END
\ No newline at end of file
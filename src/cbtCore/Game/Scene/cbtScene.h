@@ -7,10 +7,12 @@
 #include "Core/General/cbtHandleSet.h"
 #include "Core/Event/cbtEventDispatcher.h"
 #include "Game/Component/cbtComponent.h"
+#include "Game/Component/cbtComponentSignature.h"
 
 // Include STD
-#include <unordered_map>
+#include <cstdlib>
 #include <utility>
+#include <vector>
 
 NS_CBT_BEGIN
 
@@ -18,43 +20,59 @@ NS_CBT_BEGIN
     {
     private:
         cbtEntityPool m_EntityPool;
-        std::unordered_map<cbtS32, cbtComponentPool*> m_ComponentPools;
+        /// The component types each entity has, indexed by the entity's index.
+        std::vector<cbtComponentSignature> m_Signatures;
+        /// The component pools, indexed by the cbtFamily<cbtManaged> ID of their component type. nullptr if there is no pool for a type yet.
+        std::vector<cbtComponentPool*> m_ComponentPools;
+        /// The components taken out of their pools by RemoveEntities, kept to avoid reallocating every call.
+        std::vector<cbtManaged*> m_RemovedComponents;
 
     protected:
         virtual ~cbtScene()
         {
-            for (std::unordered_map<cbtS32, cbtComponentPool*>::iterator iter = m_ComponentPools.begin();
-                 iter != m_ComponentPools.end(); ++iter)
-            {
-                delete iter->second;
-            }
+            for (cbtU32 i = 0; i < m_ComponentPools.size(); ++i)
+            { delete m_ComponentPools[i]; }
         }
 
+        /**
+            \brief Get the pool of a type of component.
+
+            \return The pool of components of type T, or nullptr if no component of type T has been added to the scene.
+        */
         template<typename T>
-        void FilterEntities(std::vector<cbtECS>& _entities)
+        cbtComponentPool* GetComponentPool() const
         {
-            std::vector<cbtECS>::iterator iter = _entities.begin();
-            while (iter != _entities.end())
-            {
-                iter = HasComponent<T>(*iter) ? std::next(iter) : _entities.erase(iter);
-            }
+            cbtU32 familyID = (cbtU32)cbtFamily<cbtManaged>::GetID<T>();
+            return (familyID < m_ComponentPools.size()) ? m_ComponentPools[familyID] : nullptr;
         }
 
-        template<typename T, typename U, typename ...Args>
-        void FilterEntities(std::vector<cbtECS>& _entities)
+        /**
+            \brief Get the pool of a type of component, creating it if no component of that type has been added to the scene yet.
+
+            \return The pool of components of type T.
+        */
+        template<typename T>
+        cbtComponentPool* GetOrCreateComponentPool()
         {
-            std::vector<cbtECS>::iterator iter = _entities.begin();
-            while (iter != _entities.end())
+            cbtS32 familyID = cbtFamily<cbtManaged>::GetID<T>();
+            // Checked in every build, since a type past the signature's capacity would write outside every entity's signature.
+            if (familyID >= CBT_MAX_COMPONENT_TYPES)
             {
-                iter = HasComponent<T>(*iter) ? std::next(iter) : _entities.erase(iter);
+                CBT_LOG_CRITICAL(CBT_LOG_CATEGORY_APPLICATION, "cbtScene: Component type ID %d exceeds the maximum of %d component types. Increase CBT_MAX_COMPONENT_TYPES.",
+                                 familyID, CBT_MAX_COMPONENT_TYPES);
+                std::abort();
             }
-            FilterEntities<U, Args...>(_entities);
+            if ((cbtU32)familyID >= m_ComponentPools.size())
+            { m_ComponentPools.resize(familyID + 1, nullptr); }
+            if (m_ComponentPools[familyID] == nullptr)
+            { m_ComponentPools[familyID] = cbtComponentPool::CreateComponentPool<T>(); }
+            return m_ComponentPools[familyID];
         }
 
         template<typename ComponentGroup, typename T>
         void PopulateComponentGroup(const std::vector<cbtECS>& _entities, ComponentGroup& _componentGroup)
         {
-            cbtComponentPool* componentPool = m_ComponentPools.find(cbtFamily<cbtManaged>::GetID<T>())->second;
+            cbtComponentPool* componentPool = GetComponentPool<T>();
             T** groupArray = _componentGroup.template GetArray<T>();
             for (cbtU32 i = 0; i < _entities.size(); ++i)
             {
@@ -65,7 +83,7 @@ NS_CBT_BEGIN
         template<typename ComponentGroup, typename T, typename U, typename ...Args>
         void PopulateComponentGroup(const std::vector<cbtECS>& _entities, ComponentGroup& _componentGroup)
         {
-            cbtComponentPool* componentPool = m_ComponentPools.find(cbtFamily<cbtManaged>::GetID<T>())->second;
+            cbtComponentPool* componentPool = GetComponentPool<T>();
             T** groupArray = _componentGroup.template GetArray<T>();
             for (cbtU32 i = 0; i < _entities.size(); ++i)
             {
@@ -83,20 +101,71 @@ NS_CBT_BEGIN
         // Entity
         cbtECS AddEntity()
         {
-            return m_EntityPool.Add();
+            cbtECS entity = m_EntityPool.Add();
+            cbtECS index = cbtEntityPool::GetIndex(entity);
+            CBT_ASSERT(index < CBT_MAX_ENTITY_COUNT);
+            if (index >= m_Signatures.size())
+            { m_Signatures.resize(index + 1); }
+            return entity;
+        }
+
+        /**
+            \brief Add several entities at once, growing the scene's storage once for all of them.
+
+            \param _count The number of entities to add.
+            \param _entities The array to write the new entities to. Must have space for _count entities.
+        */
+        void AddEntities(cbtU32 _count, cbtECS* _entities)
+        {
+            m_EntityPool.Reserve(_count);
+            cbtECS maxIndex = 0;
+            for (cbtU32 i = 0; i < _count; ++i)
+            {
+                _entities[i] = m_EntityPool.Add();
+                cbtECS index = cbtEntityPool::GetIndex(_entities[i]);
+                maxIndex = (index > maxIndex) ? index : maxIndex;
+            }
+            CBT_ASSERT(maxIndex < CBT_MAX_ENTITY_COUNT);
+            if (_count != 0 && maxIndex >= m_Signatures.size())
+            { m_Signatures.resize(maxIndex + 1); }
+        }
+
+        cbtBool HasEntity(cbtECS _entity) const
+        {
+            return m_EntityPool.IsValid(_entity);
+        }
+
+        cbtU32 GetEntityCount() const
+        {
+            return m_EntityPool.GetHandleCount();
         }
 
         void RemoveEntity(cbtECS _entity)
         {
-            CBT_ASSERT(m_EntityPool.IsValid(_entity));
-            for (std::unordered_map<cbtS32, cbtComponentPool*>::iterator iter = m_ComponentPools.begin();
-                 iter != m_ComponentPools.end(); ++iter)
+            RemoveEntities(&_entity, 1);
+        }
+
+        /**
+            \brief Remove several entities and all of their components, releasing the components together.
+
+            \param _entities The entities to remove.
+            \param _count The number of entities.
+        */
+        void RemoveEntities(const cbtECS* _entities, cbtU32 _count)
+        {
+            m_RemovedComponents.clear();
+            for (cbtU32 i = 0; i < _count; ++i)
             {
-                cbtComponentPool* componentPool = iter->second;
-                if (componentPool->Has(_entity))
-                { componentPool->Remove(_entity); }
+                cbtECS entity = _entities[i];
+                CBT_ASSERT(m_EntityPool.IsValid(entity));
+                // Only visit the pools of the components the entity has.
+                cbtComponentSignature& signature = m_Signatures[cbtEntityPool::GetIndex(entity)];
+                signature.ForEach([this, entity](cbtS32 _typeID) { m_RemovedComponents.push_back(m_ComponentPools[_typeID]->Take(entity)); });
+                signature.Clear();
+                m_EntityPool.Remove(entity);
             }
-            m_EntityPool.Remove(_entity);
+            if (!m_RemovedComponents.empty())
+            { cbtManaged::AutoRelease(m_RemovedComponents.data(), (cbtU32)m_RemovedComponents.size()); }
         }
 
         // Component
@@ -104,66 +173,79 @@ NS_CBT_BEGIN
         cbtBool HasComponent(cbtECS _entity) const
         {
             CBT_ASSERT(m_EntityPool.IsValid(_entity));
-            std::unordered_map<cbtS32, cbtComponentPool*>::const_iterator iter = m_ComponentPools.find(
-                    cbtFamily<cbtManaged>::GetID<T>());
-            return (iter == m_ComponentPools.end()) ? false : iter->second->Has(_entity);
+            return m_Signatures[cbtEntityPool::GetIndex(_entity)].Test(cbtFamily<cbtManaged>::GetID<T>());
         }
 
         template<typename T>
         const T* GetComponent(cbtECS _entity) const
         {
             CBT_ASSERT(m_EntityPool.IsValid(_entity));
-            std::unordered_map<cbtS32, cbtComponentPool*>::const_iterator iter = m_ComponentPools.find(
-                    cbtFamily<cbtManaged>::GetID<T>());
-            return (iter == m_ComponentPools.end()) ? nullptr : iter->second->Get<T>(_entity);
+            cbtComponentPool* componentPool = GetComponentPool<T>();
+            return (componentPool == nullptr) ? nullptr : componentPool->Get<T>(_entity);
         }
 
         template<typename T>
         T* GetComponent(cbtECS _entity)
         {
             CBT_ASSERT(m_EntityPool.IsValid(_entity));
-            std::unordered_map<cbtS32, cbtComponentPool*>::iterator iter = m_ComponentPools.find(
-                    cbtFamily<cbtManaged>::GetID<T>());
-            return (iter == m_ComponentPools.end()) ? nullptr : iter->second->Get<T>(_entity);
+            cbtComponentPool* componentPool = GetComponentPool<T>();
+            return (componentPool == nullptr) ? nullptr : componentPool->Get<T>(_entity);
         }
 
         template<typename T>
         const T** GetComponentArray() const
         {
-            std::unordered_map<cbtS32, cbtComponentPool*>::const_iterator iter = m_ComponentPools.find(
-                    cbtFamily<cbtManaged>::GetID<T>());
-            return (iter == m_ComponentPools.end()) ? nullptr : iter->second->GetArray<T>();
+            cbtComponentPool* componentPool = GetComponentPool<T>();
+            return (componentPool == nullptr) ? nullptr : componentPool->GetArray<T>();
         }
 
         template<typename T>
         T** GetComponentArray()
         {
-            std::unordered_map<cbtS32, cbtComponentPool*>::iterator iter = m_ComponentPools.find(
-                    cbtFamily<cbtManaged>::GetID<T>());
-            return (iter == m_ComponentPools.end()) ? nullptr : iter->second->GetArray<T>();
+            cbtComponentPool* componentPool = GetComponentPool<T>();
+            return (componentPool == nullptr) ? nullptr : componentPool->GetArray<T>();
         }
 
         template<typename T>
         cbtU32 GetComponentCount() const
         {
-            std::unordered_map<cbtS32, cbtComponentPool*>::const_iterator iter = m_ComponentPools.find(
-                    cbtFamily<cbtManaged>::GetID<T>());
-            return (iter == m_ComponentPools.end()) ? 0 : iter->second->GetCount();
+            cbtComponentPool* componentPool = GetComponentPool<T>();
+            return (componentPool == nullptr) ? 0 : componentPool->GetCount();
         }
 
         template<typename T, typename ...Args>
         T* AddComponent(cbtECS _entity, Args&& ... _args)
         {
             CBT_ASSERT(!HasComponent<T>(_entity));
+            cbtComponentPool* componentPool = GetOrCreateComponentPool<T>();
+            m_Signatures[cbtEntityPool::GetIndex(_entity)].Set(cbtFamily<cbtManaged>::GetID<T>());
+            return componentPool->Add<T, Args...>(_entity, std::forward<Args>(_args)...);
+        }
+
+        /**
+            \brief Add a component of type T to each of several entities, growing the component pool once for all of them.
+
+            \param _entities The entities to add components to. None of them may already have a component of type T.
+            \param _count The number of entities.
+            \param _initialiser A function which takes a T* and the index of its entity in _entities, called after each component has awoken.
+        */
+        template<typename T, typename Initialiser>
+        void AddComponents(const cbtECS* _entities, cbtU32 _count, Initialiser&& _initialiser)
+        {
+            cbtComponentPool* componentPool = GetOrCreateComponentPool<T>();
             cbtS32 familyID = cbtFamily<cbtManaged>::GetID<T>();
-            std::unordered_map<cbtS32, cbtComponentPool*>::iterator iter = m_ComponentPools.find(familyID);
-            if (iter == m_ComponentPools.end())
+            for (cbtU32 i = 0; i < _count; ++i)
             {
-                cbtComponentPool* componentPool = cbtComponentPool::CreateComponentPool<T>();
-                m_ComponentPools.insert(std::pair<cbtS32, cbtComponentPool*>(familyID, componentPool));
-                iter = m_ComponentPools.find(familyID);
+                CBT_ASSERT(!HasComponent<T>(_entities[i]));
+                m_Signatures[cbtEntityPool::GetIndex(_entities[i])].Set(familyID);
             }
-            return iter->second->Add<T, Args...>(_entity, std::forward<Args>(_args)...);
+            componentPool->AddMany<T>(_entities, _count, std::forward<Initialiser>(_initialiser));
+        }
+
+        template<typename T>
+        void AddComponents(const cbtECS* _entities, cbtU32 _count)
+        {
+            AddComponents<T>(_entities, _count, [](T*, cbtU32) {});
         }
 
         template<typename T>
@@ -172,6 +254,50 @@ NS_CBT_BEGIN
             CBT_ASSERT(HasComponent<T>(_entity));
             cbtS32 familyID = cbtFamily<cbtManaged>::GetID<T>();
             m_ComponentPools[familyID]->Remove(_entity);
+            m_Signatures[cbtEntityPool::GetIndex(_entity)].Reset(familyID);
+        }
+
+        /**
+            \brief Call a function with every component of type T which has changed since a change version.
+
+            \param _version The change version, such as the value returned by cbtComponent::AdvanceChangeVersion when the caller last processed the changes.
+            \param _function A function which takes a T*.
+
+            \sa cbtComponent::MarkChanged
+        */
+        template<typename T, typename Function>
+        void ForEachChangedComponent(cbtU32 _version, Function&& _function)
+        {
+            cbtComponentPool* componentPool = GetComponentPool<T>();
+            if (componentPool != nullptr)
+            { componentPool->ForEachChangedSince<T>(_version, std::forward<Function>(_function)); }
+        }
+
+        /**
+            \brief Sort the components of type T, which changes the order of GetComponentArray<T>().
+
+            \param _compare A function which takes two const T* and returns true if the first component should come before the second.
+        */
+        template<typename T, typename Compare>
+        void SortComponents(Compare _compare)
+        {
+            cbtComponentPool* componentPool = GetComponentPool<T>();
+            if (componentPool != nullptr)
+            { componentPool->Sort<T>(_compare); }
+        }
+
+        /**
+            \brief
+                Reorder the components of type T to follow the order of the entities' components of type U.
+                For example, SortComponentsAs<cbtTransform, cbtGraphics>() lets the transforms of graphics components be iterated over linearly.
+        */
+        template<typename T, typename U>
+        void SortComponentsAs()
+        {
+            cbtComponentPool* componentPool = GetComponentPool<T>();
+            cbtComponentPool* otherPool = GetComponentPool<U>();
+            if (componentPool != nullptr && otherPool != nullptr)
+            { componentPool->SortAs<T, U>(*otherPool); }
         }
 
         // Preferably put the component type with the least number of components as the first template type for best performance.
@@ -180,10 +306,16 @@ NS_CBT_BEGIN
         {
             T** componentArray = GetComponentArray<T>();
             cbtU32 componentCount = GetComponentCount<T>();
+            // Every entity with a T has T in its signature, so only the other component types need to be matched.
+            const cbtComponentSignature otherTypes = cbtComponentSignature::Create<U, Args...>();
             std::vector<cbtECS> entities;
+            entities.reserve(componentCount);
             for (cbtU32 i = 0; i < componentCount; ++i)
-            { entities.push_back(componentArray[i]->GetEntity()); }
-            FilterEntities<U, Args...>(entities);
+            {
+                cbtECS entity = componentArray[i]->GetEntity();
+                if (m_Signatures[cbtEntityPool::GetIndex(entity)].Contains(otherTypes))
+                { entities.push_back(entity); }
+            }
             _componentGroup = cbtComponentGroup<T, U, Args...>((cbtU32)entities.size());
             PopulateComponentGroup<cbtComponentGroup<T, U, Args...>, T, U, Args...>(entities, _componentGroup);
         }
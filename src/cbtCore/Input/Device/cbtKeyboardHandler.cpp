@@ -1,13 +1,18 @@
 // Include CBT
 #include "cbtKeyboardHandler.h"
 
+// Include STD
+#include <algorithm>
+#include <iterator>
+
 NS_CBT_BEGIN
 
 // Constructor(s) & Destructor
     cbtKeyboardHandler::cbtKeyboardHandler()
+            :m_BindingsContext(CBT_INPUT_CONTEXT_NONE), m_BindingsDirty(true)
     {
-        m_PreviousInputState.reset();
         m_CurrentInputState.reset();
+        std::fill(std::begin(m_InputTimestamps), std::end(m_InputTimestamps), 0);
     }
 
     cbtKeyboardHandler::~cbtKeyboardHandler()
@@ -27,6 +32,7 @@ NS_CBT_BEGIN
         }
 
         iter->second[_inputName] = 1;
+        m_BindingsDirty = true;
     }
 
     void cbtKeyboardHandler::UnregisterButton(cbtInputMask _mask, cbtInputName _inputName)
@@ -39,68 +45,102 @@ NS_CBT_BEGIN
         iter->second[_inputName] = 0;
         if (iter->second.none())
         { m_RegisteredInputs.erase(iter); }
+        m_BindingsDirty = true;
+    }
+
+    const std::vector<cbtInputName>& cbtKeyboardHandler::GetKeyBindings(cbtInputContext _context, cbtKeycode _keycode)
+    {
+        if (m_BindingsDirty || _context != m_BindingsContext)
+        {
+            for (cbtU32 i = 0; i < CBTK_COUNT; ++i)
+            { m_KeyBindings[i].clear(); }
+
+            // Keyboard is always treated as controller 1.
+            for (std::unordered_map<cbtInputMask,
+                                    std::bitset<CBT_MAX_INPUT_NAME>>::const_iterator iter = m_RegisteredInputs.begin();
+                 iter != m_RegisteredInputs.end(); ++iter)
+            {
+                cbtKeycode keycode = cbtInput::GetKeycode(iter->first);
+                if (keycode >= CBTK_COUNT ||
+                    !cbtInput::CompareContext(_context, cbtInput::GetContext(iter->first)) ||
+                    !cbtInput::CompareControllerIndex(CBT_CONTROLLER_1, cbtInput::GetControllerIndex(iter->first)))
+                { continue; }
+
+                for (cbtInputName inputName = 0; inputName < CBT_MAX_INPUT_NAME; ++inputName)
+                {
+                    if (iter->second[inputName] &&
+                        std::find(m_KeyBindings[keycode].begin(), m_KeyBindings[keycode].end(), inputName) == m_KeyBindings[keycode].end())
+                    { m_KeyBindings[keycode].push_back(inputName); }
+                }
+            }
+
+            // Dispatch the inputs bound to the same key in a consistent order, rather than the order of m_RegisteredInputs.
+            for (cbtU32 i = 0; i < CBTK_COUNT; ++i)
+            { std::sort(m_KeyBindings[i].begin(), m_KeyBindings[i].end()); }
+
+            m_BindingsContext = _context;
+            m_BindingsDirty = false;
+        }
+
+        return m_KeyBindings[_keycode];
     }
 
 // Keyboard Events
-    void cbtKeyboardHandler::OnKeyPress(cbtInputContext _context, cbtKeycode _keycode)
+    void cbtKeyboardHandler::OnKeyPress(cbtInputContext _context, cbtKeycode _keycode, cbtU32 _timestamp)
     {
-        // Keyboard is always treated as controller 1.
-        cbtInputMask mask = cbtInput::GenerateInputMask(_context, CBT_CONTROLLER_1, _keycode);
+        if (_keycode >= CBTK_COUNT)
+        { return; }
 
-        for (std::unordered_map<cbtInputMask,
-                                std::bitset<CBT_MAX_INPUT_NAME>>::const_iterator iter = m_RegisteredInputs.begin();
-             iter != m_RegisteredInputs.end(); ++iter)
+        // Key repeats do not change anything, as the inputs are already held.
+        const std::vector<cbtInputName>& inputNames = GetKeyBindings(_context, _keycode);
+        for (cbtU32 i = 0; i < inputNames.size(); ++i)
         {
-            if (!cbtInput::CompareMask(mask, iter->first))
+            cbtInputName inputName = inputNames[i];
+            if (m_CurrentInputState[inputName])
             { continue; }
-            m_CurrentInputState |= iter->second;
+
+            m_CurrentInputState[inputName] = 1;
+            m_InputTimestamps[inputName] = _timestamp;
+            m_HeldInputs.push_back(inputName);
+            m_Transitions.push_back({ inputName, cbtButtonEvent::PRESS, _timestamp });
         }
     }
 
-    void cbtKeyboardHandler::OnKeyRelease(cbtInputContext _context, cbtKeycode _keycode)
+    void cbtKeyboardHandler::OnKeyRelease(cbtInputContext _context, cbtKeycode _keycode, cbtU32 _timestamp)
     {
-        // Keyboard is always treated as controller 1.
-        cbtInputMask mask = cbtInput::GenerateInputMask(_context, CBT_CONTROLLER_1, _keycode);
+        if (_keycode >= CBTK_COUNT)
+        { return; }
 
-        for (std::unordered_map<cbtInputMask,
-                                std::bitset<CBT_MAX_INPUT_NAME>>::const_iterator iter = m_RegisteredInputs.begin();
-             iter != m_RegisteredInputs.end(); ++iter)
+        const std::vector<cbtInputName>& inputNames = GetKeyBindings(_context, _keycode);
+        for (cbtU32 i = 0; i < inputNames.size(); ++i)
         {
-            if (!cbtInput::CompareMask(mask, iter->first))
+            cbtInputName inputName = inputNames[i];
+            if (!m_CurrentInputState[inputName])
             { continue; }
-            m_CurrentInputState = (m_CurrentInputState & ~iter->second);
+
+            m_CurrentInputState[inputName] = 0;
+            m_InputTimestamps[inputName] = _timestamp;
+            m_HeldInputs.erase(std::find(m_HeldInputs.begin(), m_HeldInputs.end(), inputName));
+            m_Transitions.push_back({ inputName, cbtButtonEvent::RELEASE, _timestamp });
         }
     }
 
     void cbtKeyboardHandler::DispatchEvents(cbtEventDispatcher& _dispatcher)
     {
-        for (cbtU32 i = 0; i < CBT_MAX_INPUT_NAME; ++i)
+        // Button Press & Release
+        for (cbtU32 i = 0; i < m_Transitions.size(); ++i)
         {
-            // Button Press
-            if (m_CurrentInputState[i] & ~m_PreviousInputState[i])
-            {
-                // Send both a press and a hold event.
-                _dispatcher.DispatchEvent<cbtInputEvent>(
-                        new cbtButtonEvent(static_cast<cbtInputName>(i), cbtButtonEvent::PRESS));
-                _dispatcher.DispatchEvent<cbtInputEvent>(
-                        new cbtButtonEvent(static_cast<cbtInputName>(i), cbtButtonEvent::HOLD));
-            }
-                // Button Hold
-            else if (m_CurrentInputState[i] & m_PreviousInputState[i])
-            {
-                _dispatcher.DispatchEvent<cbtInputEvent>(
-                        new cbtButtonEvent(static_cast<cbtInputName>(i), cbtButtonEvent::HOLD));
-            }
-                // Button Release
-            else if (~m_CurrentInputState[i] & m_PreviousInputState[i])
-            {
-                _dispatcher.DispatchEvent<cbtInputEvent>(
-                        new cbtButtonEvent(static_cast<cbtInputName>(i), cbtButtonEvent::RELEASE));
-            }
+            cbtButtonEvent transitionEvent(m_Transitions[i].m_InputName, m_Transitions[i].m_State, m_Transitions[i].m_Timestamp);
+            _dispatcher.DispatchEvent<cbtInputEvent>(transitionEvent);
         }
+        m_Transitions.clear();
 
-        // Update Button States
-        m_PreviousInputState = m_CurrentInputState;
+        // Button Hold, stamped with the time the input was pressed.
+        for (cbtU32 i = 0; i < m_HeldInputs.size(); ++i)
+        {
+            cbtButtonEvent holdEvent(m_HeldInputs[i], cbtButtonEvent::HOLD, m_InputTimestamps[m_HeldInputs[i]]);
+            _dispatcher.DispatchEvent<cbtInputEvent>(holdEvent);
+        }
     }
 
 NS_CBT_END
\ No newline at end of file
@@ -8,17 +8,48 @@
 // Include STD
 #include <bitset>
 #include <unordered_map>
+#include <vector>
 
 NS_CBT_BEGIN
 
     class cbtKeyboardHandler
     {
     protected:
-        std::bitset<CBT_MAX_INPUT_NAME> m_PreviousInputState;
+        /// A change of an input's state, in the order the key events happened.
+        struct cbtInputTransition
+        {
+            cbtInputName m_InputName;
+            cbtButtonEvent::ButtonState m_State;
+            cbtU32 m_Timestamp;
+        };
+
         std::bitset<CBT_MAX_INPUT_NAME> m_CurrentInputState;
+        /// The inputs which are held, in the order they were pressed.
+        std::vector<cbtInputName> m_HeldInputs;
+        /// The time each input was last pressed or released.
+        cbtU32 m_InputTimestamps[CBT_MAX_INPUT_NAME];
+        /// The presses and releases since the last DispatchEvents. Only these inputs, and the held ones, are dispatched.
+        std::vector<cbtInputTransition> m_Transitions;
 
         std::unordered_map<cbtInputMask, std::bitset<CBT_MAX_INPUT_NAME>> m_RegisteredInputs;
 
+        /// The inputs bound to each keycode in m_BindingsContext, built from m_RegisteredInputs.
+        std::vector<cbtInputName> m_KeyBindings[CBTK_COUNT];
+        /// The context m_KeyBindings was built for.
+        cbtInputContext m_BindingsContext;
+        /// Set when m_RegisteredInputs changes, so that m_KeyBindings is rebuilt before it is next used.
+        cbtBool m_BindingsDirty;
+
+        /**
+            \brief Get the inputs bound to a keycode in a context, rebuilding the bindings if the context or registered inputs have changed.
+
+            \param _context The input context.
+            \param _keycode The keycode.
+
+            \return The inputs bound to _keycode in _context.
+        */
+        const std::vector<cbtInputName>& GetKeyBindings(cbtInputContext _context, cbtKeycode _keycode);
+
     public:
         // Constructor(s) & Destructor
         cbtKeyboardHandler();
@@ -31,11 +62,35 @@ NS_CBT_BEGIN
         void UnregisterButton(cbtInputMask _mask, cbtInputName _inputName);
 
         // Events
-        void OnKeyPress(cbtInputContext _context, cbtKeycode _keycode);
+        /**
+            \brief Press the inputs bound to a key.
 
-        void OnKeyRelease(cbtInputContext _context, cbtKeycode _keycode);
+            \param _context The current input context.
+            \param _keycode The key.
+            \param _timestamp The time the key was pressed, in milliseconds, as given by cbtInputEngine::GetTimestamp().
+        */
+        void OnKeyPress(cbtInputContext _context, cbtKeycode _keycode, cbtU32 _timestamp = 0);
 
+        /**
+            \brief Release the inputs bound to a key.
+
+            \param _context The current input context.
+            \param _keycode The key.
+            \param _timestamp The time the key was released, in milliseconds, as given by cbtInputEngine::GetTimestamp().
+        */
+        void OnKeyRelease(cbtInputContext _context, cbtKeycode _keycode, cbtU32 _timestamp = 0);
+
+        /**
+            \brief
+                Dispatch a PRESS or RELEASE event for every press and release since the last call, in the order they happened,
+                then a HOLD event for every input which is held.
+                An input pressed and released between two calls receives both events, but no HOLD event.
+
+            \param _dispatcher The dispatcher to dispatch the events with.
+        */
         void DispatchEvents(cbtEventDispatcher& _dispatcher);
+
+        inline cbtBool IsHeld(cbtInputName _inputName) const { return m_CurrentInputState[_inputName]; }
     };
 
 NS_CBT_END
\ No newline at end of file
@@ -0,0 +1,88 @@
+// Include CBT
+#include "cbtInputEngine.h"
+
+NS_CBT_BEGIN
+
+    void cbtInputEngine::OnKeyEvent(cbtKeycode _keycode, cbtBool _pressed, cbtU32 _timestamp)
+    {
+        // A recording only starts with the next frame, so anything before it is not recorded.
+        if (m_InputMode == CBT_INPUT_MODE_RECORD && m_Recording.GetFrameCount() != 0 &&
+                !m_Recording.AddKeyEvent(_keycode, _pressed, _timestamp))
+        { CBT_LOG_WARN(CBT_LOG_CATEGORY_INPUT, "Too many key events in a frame. The input recording will not replay correctly."); }
+
+        if (_pressed)
+        { GetKeyboardHandler()->OnKeyPress(m_InputContext, _keycode, _timestamp); }
+        else
+        { GetKeyboardHandler()->OnKeyRelease(m_InputContext, _keycode, _timestamp); }
+    }
+
+    void cbtInputEngine::RecordFrameContext()
+    {
+        if (m_InputMode == CBT_INPUT_MODE_RECORD && m_Recording.GetFrameCount() != 0)
+        { m_Recording.SetFrameContext(m_InputContext); }
+    }
+
+    void cbtInputEngine::ReplayFrame()
+    {
+        if (m_InputMode != CBT_INPUT_MODE_REPLAY || IsReplayFinished())
+        { return; }
+
+        const cbtRecordedFrame& frame = m_Recording.GetFrame(m_ReplayFrame);
+        const cbtRecordedKeyEvent* events = m_Recording.GetFrameEvents(m_ReplayFrame);
+        m_InputContext = frame.m_Context;
+        for (cbtU32 i = 0; i < frame.m_EventCount; ++i)
+        {
+            if (events[i].m_Pressed)
+            { GetKeyboardHandler()->OnKeyPress(m_InputContext, (cbtKeycode)events[i].m_Keycode, events[i].m_Timestamp); }
+            else
+            { GetKeyboardHandler()->OnKeyRelease(m_InputContext, (cbtKeycode)events[i].m_Keycode, events[i].m_Timestamp); }
+        }
+        ++m_ReplayFrame;
+    }
+
+    void cbtInputEngine::StartRecording()
+    {
+        m_Recording.Clear();
+        m_InputMode = CBT_INPUT_MODE_RECORD;
+    }
+
+    cbtBool cbtInputEngine::StopRecording(const cbtStr& _filePath)
+    {
+        CBT_ASSERT(m_InputMode == CBT_INPUT_MODE_RECORD);
+        m_InputMode = CBT_INPUT_MODE_LIVE;
+        cbtBool saved = m_Recording.Save(_filePath);
+        if (saved)
+        { CBT_LOG_INFO(CBT_LOG_CATEGORY_INPUT, "Recorded %u frames of input to %s.", m_Recording.GetFrameCount(), _filePath.c_str()); }
+        m_Recording.Clear();
+        return saved;
+    }
+
+    cbtBool cbtInputEngine::StartReplay(const cbtStr& _filePath)
+    {
+        if (!m_Recording.Load(_filePath))
+        {
+            m_InputMode = CBT_INPUT_MODE_LIVE;
+            return false;
+        }
+
+        CBT_LOG_INFO(CBT_LOG_CATEGORY_INPUT, "Replaying %u frames of input from %s.", m_Recording.GetFrameCount(), _filePath.c_str());
+        m_InputMode = CBT_INPUT_MODE_REPLAY;
+        m_ReplayFrame = 0;
+        return true;
+    }
+
+    cbtF32 cbtInputEngine::BeginFrame(cbtF32 _deltaTime)
+    {
+        switch (m_InputMode)
+        {
+        case CBT_INPUT_MODE_RECORD:
+            m_Recording.AddFrame(_deltaTime);
+            return _deltaTime;
+        case CBT_INPUT_MODE_REPLAY:
+            return IsReplayFinished() ? _deltaTime : m_Recording.GetFrame(m_ReplayFrame).m_DeltaTime;
+        default:
+            return _deltaTime;
+        }
+    }
+
+NS_CBT_END
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "Core/General/cbtSingleton.h"
 #include "Core/Event/cbtEventDispatcher.h"
 #include "Input/cbtInputEvent.h"
+#include "Input/cbtInputRecording.h"
 #include "Input/Device/cbtKeyboardHandler.h"
 
 // Include STD
@@ -12,6 +13,17 @@
 
 NS_CBT_BEGIN
 
+    /// Where the input engine's input comes from.
+    enum cbtInputMode : cbtU32
+    {
+        /// Input comes from the devices.
+        CBT_INPUT_MODE_LIVE,
+        /// Input comes from the devices, and is recorded.
+        CBT_INPUT_MODE_RECORD,
+        /// Input comes from a recording, and the devices are ignored.
+        CBT_INPUT_MODE_REPLAY,
+    };
+
     class cbtInputEngine : public cbtSingleton<cbtInputEngine>
     {
         friend class cbtSingleton<cbtInputEngine>;
@@ -20,9 +32,13 @@ NS_CBT_BEGIN
         cbtInputContext m_InputContext; ///< Current Input Context
         cbtEventDispatcher m_EventDispatcher;
 
+        cbtInputMode m_InputMode; ///< Where input comes from.
+        cbtInputRecording m_Recording; ///< The recording being recorded or replayed.
+        cbtU32 m_ReplayFrame; ///< The frame of m_Recording being replayed.
+
         // Constructor(s) & Destructor
         cbtInputEngine()
-                :m_InputContext(CBT_INPUT_CONTEXT_DEFAULT)
+                :m_InputContext(CBT_INPUT_CONTEXT_DEFAULT), m_InputMode(CBT_INPUT_MODE_LIVE), m_ReplayFrame(0)
         {
         }
 
@@ -32,6 +48,25 @@ NS_CBT_BEGIN
 
         static cbtInputEngine* CreateInstance();
 
+        /**
+            \brief Pass a key event from a device to the keyboard handler, recording it if input is being recorded.
+
+            \param _keycode The key.
+            \param _pressed True if the key was pressed, false if it was released.
+            \param _timestamp The time of the key event.
+        */
+        void OnKeyEvent(cbtKeycode _keycode, cbtBool _pressed, cbtU32 _timestamp);
+
+        /**
+            \brief Record the input context of the current frame. Must be called before the frame's key events are passed to OnKeyEvent.
+        */
+        void RecordFrameContext();
+
+        /**
+            \brief Pass the key events of the current frame of the recording to the keyboard handler, in the input context they were recorded in.
+        */
+        void ReplayFrame();
+
     public:
         virtual void Init() = 0;
 
@@ -39,6 +74,13 @@ NS_CBT_BEGIN
 
         virtual void Exit() = 0;
 
+        /**
+            \brief Get the current time on the clock cbtInputEvent(s) are timestamped with.
+
+            \return The current time, in milliseconds.
+        */
+        virtual cbtU32 GetTimestamp() const = 0;
+
         virtual cbtKeyboardHandler* GetKeyboardHandler() = 0;
 
         virtual const cbtKeyboardHandler* GetKeyboardHandler() const = 0;
@@ -53,6 +95,52 @@ NS_CBT_BEGIN
             m_InputContext = _context;
         }
 
+        inline cbtInputMode GetInputMode() const { return m_InputMode; }
+
+        /**
+            \brief Start recording input, from the next call to BeginFrame.
+        */
+        void StartRecording();
+
+        /**
+            \brief Stop recording input, and save the recording.
+
+            \param _filePath The file to save the recording to.
+
+            \return True if the recording was saved.
+        */
+        cbtBool StopRecording(const cbtStr& _filePath);
+
+        /**
+            \brief Replay a recording instead of reading input from the devices, from the next call to BeginFrame.
+
+            \param _filePath The file to load the recording from.
+
+            \return True if the recording was loaded. If false, input keeps coming from the devices.
+        */
+        cbtBool StartReplay(const cbtStr& _filePath);
+
+        /**
+            \brief Check if every frame of the recording being replayed has been replayed.
+
+            \return True if replaying and there are no frames left.
+        */
+        inline cbtBool IsReplayFinished() const
+        {
+            return m_InputMode == CBT_INPUT_MODE_REPLAY && m_ReplayFrame >= m_Recording.GetFrameCount();
+        }
+
+        /**
+            \brief
+                Start a frame. When recording, the frame's delta time is recorded.
+                When replaying, the recorded delta time replaces it, so that the simulation sees exactly the same frames as the recorded session.
+
+            \param _deltaTime The delta time of the frame.
+
+            \return The delta time the frame should use.
+        */
+        cbtF32 BeginFrame(cbtF32 _deltaTime);
+
         const cbtEventDispatcher* GetEventDispatcher() const
         {
             return &m_EventDispatcher;
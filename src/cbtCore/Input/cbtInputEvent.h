@@ -10,14 +10,16 @@ NS_CBT_BEGIN
     {
     public:
         const cbtInputName m_InputName;
+        /// The time the input happened, in milliseconds, on the same clock as cbtInputEngine::GetTimestamp(). Compare the two to measure input latency.
+        const cbtU32 m_Timestamp;
 
         virtual ~cbtInputEvent()
         {
         }
 
     protected:
-        cbtInputEvent(cbtInputName _name)
-                :m_InputName(_name)
+        cbtInputEvent(cbtInputName _name, cbtU32 _timestamp)
+                :m_InputName(_name), m_Timestamp(_timestamp)
         {
         }
     };
@@ -33,8 +35,8 @@ NS_CBT_BEGIN
         const Axis m_Axis;
         const cbtF32 m_Value;
 
-        cbtAxisEvent(cbtInputName _name, Axis _axis, cbtF32 _value)
-                :cbtInputEvent(_name), m_Axis(_axis), m_Value(_value)
+        cbtAxisEvent(cbtInputName _name, Axis _axis, cbtF32 _value, cbtU32 _timestamp = 0)
+                :cbtInputEvent(_name, _timestamp), m_Axis(_axis), m_Value(_value)
         {
         }
 
@@ -53,8 +55,8 @@ NS_CBT_BEGIN
 
         const ButtonState m_State;
 
-        cbtButtonEvent(cbtInputName _name, ButtonState _state)
-                :cbtInputEvent(_name), m_State(_state)
+        cbtButtonEvent(cbtInputName _name, ButtonState _state, cbtU32 _timestamp = 0)
+                :cbtInputEvent(_name, _timestamp), m_State(_state)
         {
         }
 
@@ -111,8 +113,8 @@ NS_CBT_BEGIN
     public:
         const cbtCursorPosition m_CursorPosition;
 
-        cbtClickEvent(cbtInputName _name, ButtonState _state, cbtCursorPosition _cursorPosition)
-                :cbtButtonEvent(_name, _state), m_CursorPosition(_cursorPosition)
+        cbtClickEvent(cbtInputName _name, ButtonState _state, cbtCursorPosition _cursorPosition, cbtU32 _timestamp = 0)
+                :cbtButtonEvent(_name, _state, _timestamp), m_CursorPosition(_cursorPosition)
         {
         }
 
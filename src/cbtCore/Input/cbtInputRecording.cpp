@@ -0,0 +1,101 @@
+// Include CBT
+#include "cbtInputRecording.h"
+#include "Core/FileUtil/cbtFileUtil.h"
+#include "Debug/cbtDebug.h"
+
+// Include STD
+#include <cstring>
+#include <limits>
+
+NS_CBT_BEGIN
+
+    cbtBool cbtInputRecording::AddKeyEvent(cbtKeycode _keycode, cbtBool _pressed, cbtU32 _timestamp)
+    {
+        CBT_ASSERT(!m_Frames.empty());
+        cbtRecordedFrame& frame = m_Frames.back();
+        if (frame.m_EventCount == std::numeric_limits<cbtU16>::max())
+        { return false; }
+
+        m_Events.push_back({ (cbtU16)_keycode, (cbtU8)(_pressed ? 1 : 0), 0, _timestamp });
+        ++frame.m_EventCount;
+        return true;
+    }
+
+    cbtBool cbtInputRecording::Save(const cbtStr& _filePath) const
+    {
+        Header header;
+        header.m_Magic = MAGIC;
+        header.m_Version = VERSION;
+        header.m_FrameCount = (cbtU32)m_Frames.size();
+        header.m_EventCount = (cbtU32)m_Events.size();
+
+        const size_t framesSize = m_Frames.size() * sizeof(cbtRecordedFrame);
+        const size_t eventsSize = m_Events.size() * sizeof(cbtRecordedKeyEvent);
+        std::vector<cbtByte> bytes(sizeof(Header) + framesSize + eventsSize);
+        std::memcpy(&bytes[0], &header, sizeof(Header));
+        if (framesSize != 0)
+        { std::memcpy(&bytes[sizeof(Header)], m_Frames.data(), framesSize); }
+        if (eventsSize != 0)
+        { std::memcpy(&bytes[sizeof(Header) + framesSize], m_Events.data(), eventsSize); }
+
+        if (!cbtFileUtil::BytesToFile(_filePath, &bytes[0], bytes.size()))
+        {
+            CBT_LOG_WARN(CBT_LOG_CATEGORY_INPUT, "Cannot write input recording to %s.", _filePath.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    cbtBool cbtInputRecording::Load(const cbtStr& _filePath)
+    {
+        Clear();
+
+        std::vector<cbtByte> bytes;
+        if (!cbtFileUtil::FileToBytes(_filePath, bytes))
+        {
+            CBT_LOG_WARN(CBT_LOG_CATEGORY_INPUT, "Cannot read input recording from %s.", _filePath.c_str());
+            return false;
+        }
+
+        // Reject anything that is not a complete recording written by this version of the format.
+        Header header;
+        if (bytes.size() < sizeof(Header))
+        {
+            CBT_LOG_WARN(CBT_LOG_CATEGORY_INPUT, "%s is not an input recording.", _filePath.c_str());
+            return false;
+        }
+        std::memcpy(&header, &bytes[0], sizeof(Header));
+        const size_t framesSize = (size_t)header.m_FrameCount * sizeof(cbtRecordedFrame);
+        const size_t eventsSize = (size_t)header.m_EventCount * sizeof(cbtRecordedKeyEvent);
+        if (header.m_Magic != MAGIC || header.m_Version != VERSION || bytes.size() != sizeof(Header) + framesSize + eventsSize)
+        {
+            CBT_LOG_WARN(CBT_LOG_CATEGORY_INPUT, "%s is not an input recording, or was written by another version.", _filePath.c_str());
+            return false;
+        }
+
+        m_Frames.resize(header.m_FrameCount);
+        m_Events.resize(header.m_EventCount);
+        if (framesSize != 0)
+        { std::memcpy(m_Frames.data(), &bytes[sizeof(Header)], framesSize); }
+        if (eventsSize != 0)
+        { std::memcpy(m_Events.data(), &bytes[sizeof(Header) + framesSize], eventsSize); }
+
+        // Rebuild the index of each frame's first event, checking that the frames account for every event.
+        m_FirstEvents.resize(header.m_FrameCount);
+        cbtU32 eventCount = 0;
+        for (cbtU32 i = 0; i < header.m_FrameCount; ++i)
+        {
+            m_FirstEvents[i] = eventCount;
+            eventCount += m_Frames[i].m_EventCount;
+        }
+        if (eventCount != header.m_EventCount)
+        {
+            CBT_LOG_WARN(CBT_LOG_CATEGORY_INPUT, "Input recording %s is corrupted.", _filePath.c_str());
+            Clear();
+            return false;
+        }
+
+        return true;
+    }
+
+NS_CBT_END
\ No newline at end of file
@@ -0,0 +1,139 @@
+#pragma once
+
+// Include CBT
+#include "cbtInput.h"
+#include "Debug/cbtDebug.h"
+
+// Include STD
+#include <vector>
+
+NS_CBT_BEGIN
+
+    /// A key press or release in a cbtInputRecording.
+    struct cbtRecordedKeyEvent
+    {
+        cbtU16 m_Keycode;
+        cbtU8 m_Pressed;
+        cbtU8 m_Padding;
+        cbtU32 m_Timestamp;
+    };
+
+    /// A frame in a cbtInputRecording.
+    struct cbtRecordedFrame
+    {
+        /// The delta time of the frame, which is replayed exactly.
+        cbtF32 m_DeltaTime;
+        /// The input context the frame's key events were handled in.
+        cbtInputContext m_Context;
+        cbtU16 m_EventCount;
+    };
+
+    /**
+        \brief
+            The delta time, input context and key events of every frame of a session, so that the session can be replayed exactly.
+            Saved as a compact binary file of 8 bytes per frame and 8 bytes per key event.
+    */
+    class cbtInputRecording
+    {
+    private:
+        /// The header of a saved recording.
+        struct Header
+        {
+            cbtU32 m_Magic;
+            cbtU32 m_Version;
+            cbtU32 m_FrameCount;
+            cbtU32 m_EventCount;
+        };
+
+        static constexpr cbtU32 MAGIC = 0x49544243; // "CBTI"
+        /// Increase this whenever the file format changes, so that old recordings are rejected.
+        static constexpr cbtU32 VERSION = 1;
+
+        std::vector<cbtRecordedFrame> m_Frames;
+        /// The key events of every frame, in order.
+        std::vector<cbtRecordedKeyEvent> m_Events;
+        /// The index in m_Events of each frame's first key event.
+        std::vector<cbtU32> m_FirstEvents;
+
+    public:
+        cbtInputRecording()
+        {
+        }
+
+        ~cbtInputRecording()
+        {
+        }
+
+        void Clear()
+        {
+            m_Frames.clear();
+            m_Events.clear();
+            m_FirstEvents.clear();
+        }
+
+        /**
+            \brief Start recording a new frame.
+
+            \param _deltaTime The delta time of the frame.
+        */
+        void AddFrame(cbtF32 _deltaTime)
+        {
+            m_Frames.push_back({ _deltaTime, CBT_INPUT_CONTEXT_DEFAULT, 0 });
+            m_FirstEvents.push_back((cbtU32)m_Events.size());
+        }
+
+        /**
+            \brief Set the input context of the frame being recorded.
+
+            \param _context The input context.
+        */
+        void SetFrameContext(cbtInputContext _context)
+        {
+            CBT_ASSERT(!m_Frames.empty());
+            m_Frames.back().m_Context = _context;
+        }
+
+        /**
+            \brief Add a key event to the frame being recorded.
+
+            \param _keycode The key.
+            \param _pressed True if the key was pressed, false if it was released.
+            \param _timestamp The time of the key event.
+
+            \return False if the frame already has the maximum number of key events, in which case the event is not recorded.
+        */
+        cbtBool AddKeyEvent(cbtKeycode _keycode, cbtBool _pressed, cbtU32 _timestamp);
+
+        inline cbtU32 GetFrameCount() const { return (cbtU32)m_Frames.size(); }
+
+        inline const cbtRecordedFrame& GetFrame(cbtU32 _frame) const { return m_Frames[_frame]; }
+
+        /**
+            \brief Get the key events of a frame.
+
+            \param _frame The index of the frame.
+
+            \return The frame's key events. There are GetFrame(_frame).m_EventCount of them.
+        */
+        inline const cbtRecordedKeyEvent* GetFrameEvents(cbtU32 _frame) const { return m_Events.data() + m_FirstEvents[_frame]; }
+
+        /**
+            \brief Save the recording to a file.
+
+            \param _filePath The file path.
+
+            \return True if the recording was saved.
+        */
+        cbtBool Save(const cbtStr& _filePath) const;
+
+        /**
+            \brief Load a recording from a file, replacing this recording.
+
+            \param _filePath The file path.
+
+            \return True if the recording was loaded. If false, the recording is left empty.
+        */
+        cbtBool Load(const cbtStr& _filePath);
+    };
+
+NS_CBT_END
\ No newline at end of file
@@ -266,6 +266,9 @@ NS_CBT_BEGIN
 
         CBTK_AUDIOREWIND,
         CBTK_AUDIOFASTFORWARD,
+
+        /// The number of keycodes. This is not a key.
+        CBTK_COUNT,
     };
 
 NS_CBT_END
\ No newline at end of file
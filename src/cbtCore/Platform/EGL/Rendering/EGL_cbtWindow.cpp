@@ -0,0 +1,129 @@
+// Include CBT
+#include "EGL_cbtWindow.h"
+#include "Debug/cbtDebug.h"
+#include "Rendering/Window/cbtWindowEvent.h"
+#include "Platform/OpenGL/Rendering/GL_cbtFrameBuffer.h"
+
+#ifdef CBT_EGL
+
+NS_CBT_BEGIN
+
+    EGL_cbtWindow::EGL_cbtWindow(const cbtWindowProperties& _properties)
+            :cbtWindow(_properties)
+    {
+        // Prefer Mesa's surfaceless platform, which does not need a display server.
+        PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+        if (getPlatformDisplay)
+        { m_EGLDisplay = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr); }
+        if (m_EGLDisplay == EGL_NO_DISPLAY)
+        { m_EGLDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY); }
+
+        EGLint eglMajorVersion;
+        EGLint eglMinorVersion;
+        if (m_EGLDisplay == EGL_NO_DISPLAY || !eglInitialize(m_EGLDisplay, &eglMajorVersion, &eglMinorVersion))
+        {
+            CBT_LOG_ERROR(CBT_LOG_CATEGORY_RENDER, "EGL Window's Initialisation Failed!");
+            CBT_ASSERT(false);
+            return;
+        }
+        eglBindAPI(EGL_OPENGL_API);
+
+        // Nothing is drawn to a surface, so any config will do. The surfaceless platform does not have any.
+        EGLint configAttributes[] = { EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+        EGLConfig config = EGL_NO_CONFIG_KHR;
+        EGLint configCount = 0;
+        if (!eglChooseConfig(m_EGLDisplay, configAttributes, &config, 1, &configCount) || configCount == 0)
+        { config = EGL_NO_CONFIG_KHR; }
+
+        // Request the same version as SDL_cbtWindow, falling back to 4.5, which has the direct state access functions the renderer uses.
+        for (EGLint minorVersion = 6; minorVersion >= 5 && m_EGLContext == EGL_NO_CONTEXT; --minorVersion)
+        {
+            EGLint contextAttributes[] = {
+                    EGL_CONTEXT_MAJOR_VERSION, 4,
+                    EGL_CONTEXT_MINOR_VERSION, minorVersion,
+                    EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT,
+                    EGL_NONE
+            };
+            m_EGLContext = eglCreateContext(m_EGLDisplay, config, EGL_NO_CONTEXT, contextAttributes);
+        }
+
+        if (m_EGLContext == EGL_NO_CONTEXT || !eglMakeCurrent(m_EGLDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, m_EGLContext))
+        {
+            CBT_LOG_ERROR(CBT_LOG_CATEGORY_RENDER, "EGL Window's OpenGL Context Creation Failed!");
+            CBT_ASSERT(false);
+            return;
+        }
+
+        cbtStr glVersionMsg = "OpenGL Version: " + cbtStr((const cbtS8*)glGetString(GL_VERSION)) + " (" + cbtStr((const cbtS8*)glGetString(GL_RENDERER)) + ")";
+        CBT_LOG_INFO(CBT_LOG_CATEGORY_RENDER, glVersionMsg.c_str());
+
+        // GLEW is needed to create the framebuffer. A GLEW built for GLX loads every function, but reports that there is no GLX display.
+        GLenum initResult = glewInit();
+        CBT_ASSERT(initResult == GLEW_OK || initResult == GLEW_ERROR_NO_GLX_DISPLAY);
+
+        CreateFrameBuffer();
+    }
+
+    EGL_cbtWindow::~EGL_cbtWindow()
+    {
+        if (m_EGLContext != EGL_NO_CONTEXT)
+        {
+            DeleteFrameBuffer();
+            eglMakeCurrent(m_EGLDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+            eglDestroyContext(m_EGLDisplay, m_EGLContext);
+        }
+        if (m_EGLDisplay != EGL_NO_DISPLAY)
+        { eglTerminate(m_EGLDisplay); }
+    }
+
+    void EGL_cbtWindow::CreateFrameBuffer()
+    {
+        glCreateRenderbuffers(1, &m_ColorBuffer);
+        glNamedRenderbufferStorage(m_ColorBuffer, GL_RGBA8, (GLsizei)m_Properties.m_Width, (GLsizei)m_Properties.m_Height);
+        glCreateRenderbuffers(1, &m_DepthStencilBuffer);
+        glNamedRenderbufferStorage(m_DepthStencilBuffer, GL_DEPTH24_STENCIL8, (GLsizei)m_Properties.m_Width, (GLsizei)m_Properties.m_Height);
+
+        glCreateFramebuffers(1, &m_FrameBuffer);
+        glNamedFramebufferRenderbuffer(m_FrameBuffer, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_ColorBuffer);
+        glNamedFramebufferRenderbuffer(m_FrameBuffer, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_DepthStencilBuffer);
+        if (glCheckNamedFramebufferStatus(m_FrameBuffer, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        {
+            CBT_LOG_ERROR(CBT_LOG_CATEGORY_RENDER, "EGL Window's Framebuffer Is Incomplete!");
+            CBT_ASSERT(false);
+        }
+
+        // Everything which would have been drawn to the window is drawn to the framebuffer instead.
+        GL_cbtFrameBuffer::SetDefaultBufferName(m_FrameBuffer);
+    }
+
+    void EGL_cbtWindow::DeleteFrameBuffer()
+    {
+        GL_cbtFrameBuffer::SetDefaultBufferName(0);
+        glDeleteFramebuffers(1, &m_FrameBuffer);
+        glDeleteRenderbuffers(1, &m_ColorBuffer);
+        glDeleteRenderbuffers(1, &m_DepthStencilBuffer);
+        m_FrameBuffer = 0;
+        m_ColorBuffer = 0;
+        m_DepthStencilBuffer = 0;
+    }
+
+    void EGL_cbtWindow::Resize(cbtU32 _width, cbtU32 _height)
+    {
+        m_Properties.m_Width = _width;
+        m_Properties.m_Height = _height;
+        DeleteFrameBuffer();
+        CreateFrameBuffer();
+
+        // Queue Event
+        m_EventDispatcher.QueueEvent<cbtResizeWindowEvent>(cbtResizeWindowEvent(m_Properties));
+    }
+
+    void EGL_cbtWindow::SwapBuffers()
+    {
+        // There is nothing to present. Wait for the frame to finish instead, so that frames cannot queue up and each frame's time includes rendering it.
+        glFinish();
+    }
+
+NS_CBT_END
+
+#endif // CBT_EGL
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+// Include CBT
+#include "Rendering/Window/cbtWindow.h"
+
+#ifdef CBT_EGL
+
+// Include GLEW
+#include <GL/glew.h>
+
+// Include EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+NS_CBT_BEGIN
+
+    /**
+        \brief
+            A window which renders offscreen, into a framebuffer object, using an EGL context without a surface.
+            It needs neither a display server nor a GPU, so it can run on CI machines using Mesa's llvmpipe.
+    */
+    class EGL_cbtWindow : public cbtWindow
+    {
+    protected:
+        EGLDisplay m_EGLDisplay = EGL_NO_DISPLAY;
+        EGLContext m_EGLContext = EGL_NO_CONTEXT;
+
+        /// The framebuffer rendered into in place of the window's framebuffer.
+        GLuint m_FrameBuffer = 0;
+        GLuint m_ColorBuffer = 0;
+        GLuint m_DepthStencilBuffer = 0;
+
+        void CreateFrameBuffer();
+
+        void DeleteFrameBuffer();
+
+    public:
+        EGL_cbtWindow(const cbtWindowProperties& _properties);
+
+        virtual ~EGL_cbtWindow();
+
+        virtual void Resize(cbtU32 _width, cbtU32 _height);
+
+        virtual void SwapBuffers();
+    };
+
+NS_CBT_END
+
+#endif // CBT_EGL
\ No newline at end of file
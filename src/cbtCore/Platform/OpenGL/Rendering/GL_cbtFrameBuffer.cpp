@@ -11,8 +11,7 @@ NS_CBT_BEGIN
 /************************************************************Frame Buffer************************************************************/
     void cbtFrameBuffer::Bind(cbtFrameBuffer* _frameBuffer)
     {
-        glBindFramebuffer(GL_FRAMEBUFFER,
-                _frameBuffer ? static_cast<GL_cbtFrameBuffer*>(_frameBuffer)->GetBufferName() : 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, GL_cbtFrameBuffer::GetBufferName(_frameBuffer));
     }
 
     void cbtFrameBuffer::Blit(cbtFrameBuffer* _src, cbtFrameBuffer* _dest,
@@ -20,9 +19,6 @@ NS_CBT_BEGIN
             cbtS32 _srcX0, cbtS32 _srcY0, cbtS32 _srcX1, cbtS32 _srcY1,
             cbtS32 _destX0, cbtS32 _destY0, cbtS32 _destX1, cbtS32 _destY1)
     {
-        GL_cbtFrameBuffer* source = static_cast<GL_cbtFrameBuffer*>(_src);
-        GL_cbtFrameBuffer* destination = static_cast<GL_cbtFrameBuffer*>(_dest);
-
         GLbitfield mask = 0;
         mask |= (_colorBuffer ? GL_COLOR_BUFFER_BIT : 0);
         mask |= (_depthBuffer ? GL_DEPTH_BUFFER_BIT : 0);
@@ -30,7 +26,7 @@ NS_CBT_BEGIN
 
         /* If filter is not GL_NEAREST and mask includes GL_DEPTH_BUFFER_BIT or GL_STENCIL_BUFFER_BIT, no data is transferred and a GL_INVALID_OPERATION error is generated.
         So for simplicity let's just use GL_NEAREST. Don't act smart use GL_LINEAR. */
-        glBlitNamedFramebuffer(source ? source->GetBufferName() : 0, destination ? destination->GetBufferName() : 0,
+        glBlitNamedFramebuffer(GL_cbtFrameBuffer::GetBufferName(_src), GL_cbtFrameBuffer::GetBufferName(_dest),
                 _srcX0, _srcY0, _srcX1, _srcY1,
                 _destX0, _destY0, _destX1, _destY1,
                 mask, GL_NEAREST);
@@ -43,7 +39,7 @@ NS_CBT_BEGIN
         // Default FrameBuffer
         if (frameBuffer == nullptr)
         {
-            glClearNamedFramebufferfv(0, GL_COLOR, 0, &_color.m_R);
+            glClearNamedFramebufferfv(GL_cbtFrameBuffer::GetBufferName(nullptr), GL_COLOR, 0, &_color.m_R);
             return;
         }
 
@@ -64,7 +60,7 @@ NS_CBT_BEGIN
         // Default FrameBuffer
         if (frameBuffer == nullptr)
         {
-            glClearNamedFramebufferfv(0, GL_COLOR, 0, &_color.m_R);
+            glClearNamedFramebufferfv(GL_cbtFrameBuffer::GetBufferName(nullptr), GL_COLOR, 0, &_color.m_R);
             return;
         }
 
@@ -78,21 +74,18 @@ NS_CBT_BEGIN
 
     void cbtFrameBuffer::ClearDepth(cbtFrameBuffer* _frameBuffer, cbtF32 _depth)
     {
-        GL_cbtFrameBuffer* frameBuffer = static_cast<GL_cbtFrameBuffer*>(_frameBuffer);
-        glClearNamedFramebufferfv(frameBuffer ? frameBuffer->GetBufferName() : 0, GL_DEPTH, 0, &_depth);
+        glClearNamedFramebufferfv(GL_cbtFrameBuffer::GetBufferName(_frameBuffer), GL_DEPTH, 0, &_depth);
     }
 
     void cbtFrameBuffer::ClearDepthStencil(cbtFrameBuffer* _frameBuffer, cbtF32 _depth, cbtS32 _stencil)
     {
-        GL_cbtFrameBuffer* frameBuffer = static_cast<GL_cbtFrameBuffer*>(_frameBuffer);
-        glClearNamedFramebufferfi(frameBuffer ? frameBuffer->GetBufferName() : 0, GL_DEPTH_STENCIL, 0, _depth,
+        glClearNamedFramebufferfi(GL_cbtFrameBuffer::GetBufferName(_frameBuffer), GL_DEPTH_STENCIL, 0, _depth,
                 _stencil);
     }
 
     void cbtFrameBuffer::ClearStencil(cbtFrameBuffer* _frameBuffer, cbtS32 _stencil)
     {
-        GL_cbtFrameBuffer* frameBuffer = static_cast<GL_cbtFrameBuffer*>(_frameBuffer);
-        glClearNamedFramebufferiv(frameBuffer ? frameBuffer->GetBufferName() : 0, GL_STENCIL, 0, &_stencil);
+        glClearNamedFramebufferiv(GL_cbtFrameBuffer::GetBufferName(_frameBuffer), GL_STENCIL, 0, &_stencil);
     }
 
     void
@@ -109,6 +102,8 @@ NS_CBT_BEGIN
         return cbtNew GL_cbtFrameBuffer();
     }
 
+    GLuint GL_cbtFrameBuffer::s_DefaultBufferName = 0;
+
     GL_cbtFrameBuffer::GL_cbtFrameBuffer()
             :m_DepthAttachment(nullptr), m_StencilAttachment(nullptr), m_DepthStencilAttachment(nullptr)
     {
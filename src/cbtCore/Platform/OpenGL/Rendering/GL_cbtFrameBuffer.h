@@ -21,11 +21,36 @@ NS_CBT_BEGIN
         GL_cbtTexture* m_DepthStencilAttachment;
         GLuint m_BufferName;
 
+        /// The framebuffer used in place of a null cbtFrameBuffer. This is 0, the window's framebuffer, unless rendering headless.
+        static GLuint s_DefaultBufferName;
+
         virtual ~GL_cbtFrameBuffer();
 
     public:
         GL_cbtFrameBuffer();
 
+        /**
+            \brief Get the name of a framebuffer, or the default framebuffer if _frameBuffer is null.
+
+            \param _frameBuffer The framebuffer.
+
+            \return The name of the framebuffer.
+        */
+        static GLuint GetBufferName(cbtFrameBuffer* _frameBuffer)
+        {
+            return _frameBuffer ? static_cast<GL_cbtFrameBuffer*>(_frameBuffer)->GetBufferName() : s_DefaultBufferName;
+        }
+
+        /**
+            \brief Set the framebuffer used in place of a null cbtFrameBuffer, such as when rendering offscreen without a window.
+
+            \param _bufferName The name of the framebuffer. 0 is the window's framebuffer.
+        */
+        static void SetDefaultBufferName(GLuint _bufferName)
+        {
+            s_DefaultBufferName = _bufferName;
+        }
+
         GLuint GetBufferName()
         {
             return m_BufferName;
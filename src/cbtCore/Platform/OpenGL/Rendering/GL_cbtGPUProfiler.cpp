@@ -0,0 +1,136 @@
+// Include CBT
+#include "Rendering/RenderEngine/cbtGPUProfiler.h"
+
+#ifdef CBT_OPENGL
+
+// Include GLEW
+#include <GL/glew.h>
+
+// Include STD
+#include <vector>
+
+NS_CBT_BEGIN
+
+    /// A zone timed by a pair of timestamp queries.
+    struct GL_cbtGPUZone
+    {
+        const cbtS8* m_Name;
+        cbtU32 m_Camera;
+        GLuint m_BeginQuery;
+        GLuint m_EndQuery;
+    };
+
+    /// The zones recorded during a frame. The queries are kept and reused when the frame's slot comes around again.
+    struct GL_cbtGPUFrame
+    {
+        std::vector<GL_cbtGPUZone> m_Zones;
+        std::vector<GLuint> m_Queries;
+    };
+
+    /// The time spent in a zone during a frame, summed across every time it was opened.
+    struct GL_cbtGPUZoneTime
+    {
+        const cbtS8* m_Name;
+        cbtU32 m_Camera;
+        GLuint64 m_Nanoseconds;
+    };
+
+    static GL_cbtGPUFrame s_Frames[cbtGPUProfiler::FRAME_LATENCY];
+    static cbtU32 s_CurrentFrame = 0;
+    static cbtBool s_Recording = false;
+
+    /**
+        \brief Read back the results of a frame and report them to cbtProfiler, unless they are not available yet.
+
+        \param _frame The frame.
+    */
+    static void ResolveFrame(const GL_cbtGPUFrame& _frame)
+    {
+        if (_frame.m_Zones.empty())
+        { return; }
+
+        // Queries complete in order, so if the last one is available, every one is. Never wait, or the CPU would stall on the GPU.
+        GLint available = GL_FALSE;
+        glGetQueryObjectiv(_frame.m_Zones.back().m_EndQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available == GL_FALSE)
+        { return; }
+
+        std::vector<GL_cbtGPUZoneTime> zoneTimes;
+        for (cbtU32 i = 0; i < _frame.m_Zones.size(); ++i)
+        {
+            const GL_cbtGPUZone& zone = _frame.m_Zones[i];
+            GLuint64 beginTime = 0;
+            GLuint64 endTime = 0;
+            glGetQueryObjectui64v(zone.m_BeginQuery, GL_QUERY_RESULT, &beginTime);
+            glGetQueryObjectui64v(zone.m_EndQuery, GL_QUERY_RESULT, &endTime);
+
+            cbtU32 j = 0;
+            while (j < zoneTimes.size() && (zoneTimes[j].m_Name != zone.m_Name || zoneTimes[j].m_Camera != zone.m_Camera))
+            { ++j; }
+            if (j == zoneTimes.size())
+            { zoneTimes.push_back({ zone.m_Name, zone.m_Camera, 0 }); }
+            zoneTimes[j].m_Nanoseconds += (endTime > beginTime) ? (endTime - beginTime) : 0;
+        }
+
+        for (cbtU32 i = 0; i < zoneTimes.size(); ++i)
+        {
+            cbtStr name = zoneTimes[i].m_Name;
+            if (zoneTimes[i].m_Camera != CBT_GPU_PROFILE_NO_CAMERA)
+            { name += " (Camera " + CBT_TO_STRING(zoneTimes[i].m_Camera) + ")"; }
+            cbtProfiler::AddSample(name, cbtProfileDomain::GPU, (cbtF64)zoneTimes[i].m_Nanoseconds / 1000000.0);
+        }
+    }
+
+    void cbtGPUProfiler::BeginFrame()
+    {
+        s_CurrentFrame = (s_CurrentFrame + 1) % FRAME_LATENCY;
+        GL_cbtGPUFrame& frame = s_Frames[s_CurrentFrame];
+        ResolveFrame(frame);
+        frame.m_Zones.clear();
+
+        // Timestamp queries are core since OpenGL 3.3, and are supported by Mesa's software rasterisers.
+        s_Recording = cbtProfiler::IsEnabled() && (GLEW_VERSION_3_3 || GLEW_ARB_timer_query);
+    }
+
+    cbtU32 cbtGPUProfiler::BeginZone(const cbtS8* _name, cbtU32 _camera)
+    {
+        if (!s_Recording)
+        { return CBT_GPU_PROFILE_INVALID_ZONE; }
+
+        GL_cbtGPUFrame& frame = s_Frames[s_CurrentFrame];
+        cbtU32 queryIndex = (cbtU32)frame.m_Zones.size() * 2;
+        if (queryIndex + 2 > frame.m_Queries.size())
+        {
+            frame.m_Queries.resize(queryIndex + 2);
+            glGenQueries(2, &frame.m_Queries[queryIndex]);
+        }
+
+        GL_cbtGPUZone zone { _name, _camera, frame.m_Queries[queryIndex], frame.m_Queries[queryIndex + 1] };
+        glQueryCounter(zone.m_BeginQuery, GL_TIMESTAMP);
+        frame.m_Zones.push_back(zone);
+        return (cbtU32)frame.m_Zones.size() - 1;
+    }
+
+    void cbtGPUProfiler::EndZone(cbtU32 _zone)
+    {
+        if (_zone == CBT_GPU_PROFILE_INVALID_ZONE)
+        { return; }
+
+        glQueryCounter(s_Frames[s_CurrentFrame].m_Zones[_zone].m_EndQuery, GL_TIMESTAMP);
+    }
+
+    void cbtGPUProfiler::Destroy()
+    {
+        for (cbtU32 i = 0; i < FRAME_LATENCY; ++i)
+        {
+            if (!s_Frames[i].m_Queries.empty())
+            { glDeleteQueries((GLsizei)s_Frames[i].m_Queries.size(), s_Frames[i].m_Queries.data()); }
+            s_Frames[i].m_Queries.clear();
+            s_Frames[i].m_Zones.clear();
+        }
+        s_Recording = false;
+    }
+
+NS_CBT_END
+
+#endif // CBT_OPENGL
\ No newline at end of file
@@ -0,0 +1,82 @@
+// Include CBT
+#include "GL_cbtIndirectDrawBuffer.h"
+#include "GL_cbtVertexArray.h"
+
+#ifdef CBT_OPENGL
+
+NS_CBT_BEGIN
+
+    cbtIndirectDrawBuffer* cbtIndirectDrawBuffer::CreateIndirectDrawBuffer(cbtU32 _instanceCapacity, cbtU32 _commandCapacity)
+    {
+        return cbtNew GL_cbtIndirectDrawBuffer(_instanceCapacity, _commandCapacity);
+    }
+
+    GL_cbtIndirectDrawBuffer::GL_cbtIndirectDrawBuffer(cbtU32 _instanceCapacity, cbtU32 _commandCapacity)
+            :cbtIndirectDrawBuffer(_instanceCapacity, _commandCapacity)
+    {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        const GLsizeiptr instanceBufferSize = (GLsizeiptr)sizeof(cbtMeshInstance) * m_InstanceCapacity * FRAME_COUNT;
+        const GLsizeiptr commandBufferSize = (GLsizeiptr)sizeof(cbtDrawElementsIndirectCommand) * m_CommandCapacity * FRAME_COUNT;
+
+        glCreateBuffers(1, &m_InstanceBufferName);
+        glNamedBufferStorage(m_InstanceBufferName, instanceBufferSize, nullptr, flags);
+        m_Instances = static_cast<cbtMeshInstance*>(glMapNamedBufferRange(m_InstanceBufferName, 0, instanceBufferSize, flags));
+
+        glCreateBuffers(1, &m_CommandBufferName);
+        glNamedBufferStorage(m_CommandBufferName, commandBufferSize, nullptr, flags);
+        m_Commands = static_cast<cbtDrawElementsIndirectCommand*>(glMapNamedBufferRange(m_CommandBufferName, 0, commandBufferSize, flags));
+
+        for (cbtU32 i = 0; i < FRAME_COUNT; ++i)
+        { m_Fences[i] = nullptr; }
+    }
+
+    GL_cbtIndirectDrawBuffer::~GL_cbtIndirectDrawBuffer()
+    {
+        for (cbtU32 i = 0; i < FRAME_COUNT; ++i)
+        {
+            if (m_Fences[i] != nullptr)
+            { glDeleteSync(m_Fences[i]); }
+        }
+        glUnmapNamedBuffer(m_InstanceBufferName);
+        glUnmapNamedBuffer(m_CommandBufferName);
+        glDeleteBuffers(1, &m_InstanceBufferName);
+        glDeleteBuffers(1, &m_CommandBufferName);
+    }
+
+    void GL_cbtIndirectDrawBuffer::BeginFrame()
+    {
+        m_Region = (m_Region + 1) % FRAME_COUNT;
+        m_InstanceCount = 0;
+        m_CommandCount = 0;
+
+        GLsync fence = m_Fences[m_Region];
+        if (fence == nullptr)
+        { return; }
+        // The region is normally free already, since it was last used FRAME_COUNT - 1 frames ago.
+        GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        while (result == GL_TIMEOUT_EXPIRED)
+        { result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); }
+        glDeleteSync(fence);
+        m_Fences[m_Region] = nullptr;
+    }
+
+    void GL_cbtIndirectDrawBuffer::EndFrame()
+    {
+        if (m_Fences[m_Region] != nullptr)
+        { glDeleteSync(m_Fences[m_Region]); }
+        m_Fences[m_Region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    void GL_cbtIndirectDrawBuffer::Bind()
+    {
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_CommandBufferName);
+    }
+
+    void GL_cbtIndirectDrawBuffer::AttachInstances(cbtMesh* _mesh)
+    {
+        static_cast<GL_cbtVertexArray*>(_mesh->GetVAO())->AttachBuffer(cbtMesh::INSTANCE_DATA, m_InstanceBufferName);
+    }
+
+NS_CBT_END
+
+#endif // CBT_OPENGL
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+// Include CBT
+#include "Rendering/Buffer/cbtIndirectDrawBuffer.h"
+
+#ifdef CBT_OPENGL
+
+// Include GLEW
+#include <GL/glew.h>
+
+NS_CBT_BEGIN
+
+/** The instance and command buffers are created with glNamedBufferStorage and stay mapped for their whole lifetime.
+  * The mapping is coherent, so writes are visible to the GPU without being flushed.
+  * A fence is placed after the last draw of each frame, and waited on before the frame's region is written to again. */
+    class GL_cbtIndirectDrawBuffer : public cbtIndirectDrawBuffer
+    {
+    protected:
+        GLuint m_InstanceBufferName;
+        GLuint m_CommandBufferName;
+        /// The fence of the last frame which used each region, or nullptr if the GPU is done with the region.
+        GLsync m_Fences[FRAME_COUNT];
+
+        virtual ~GL_cbtIndirectDrawBuffer();
+
+    public:
+        GL_cbtIndirectDrawBuffer(cbtU32 _instanceCapacity, cbtU32 _commandCapacity);
+
+        virtual void BeginFrame();
+
+        virtual void EndFrame();
+
+        virtual void Bind();
+
+        virtual void AttachInstances(cbtMesh* _mesh);
+    };
+
+NS_CBT_END
+
+#endif // CBT_OPENGL
\ No newline at end of file
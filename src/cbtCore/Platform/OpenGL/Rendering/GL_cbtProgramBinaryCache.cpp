@@ -0,0 +1,166 @@
+// Include CBT
+#include "GL_cbtProgramBinaryCache.h"
+#include "Core/FileUtil/cbtFileUtil.h"
+#include "Core/General/cbtStringID.h"
+#include "Rendering/Shader/cbtShaderProgram.h"
+#include "Debug/cbtDebug.h"
+
+#ifdef CBT_OPENGL
+
+// Include STD
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+
+NS_CBT_BEGIN
+
+    cbtBool GL_cbtProgramBinaryCache::s_Enabled = true;
+    cbtStr GL_cbtProgramBinaryCache::s_Directory = "./shadercache/";
+    cbtStr GL_cbtProgramBinaryCache::s_DriverID;
+    cbtS32 GL_cbtProgramBinaryCache::s_Supported = -1;
+    GL_cbtProgramBinaryCacheStats GL_cbtProgramBinaryCache::s_Stats;
+
+    cbtU64 GL_cbtProgramBinaryCache::Hash(const cbtStr& _string, cbtU64 _hash)
+    {
+        // FNV-1a is used as std::hash is not guaranteed to be the same across builds, and the keys are stored on disk.
+        _hash = cbtHashFNV1a(_string.data(), _string.size(), _hash);
+        // Hash a separator so that {"ab", "c"} and {"a", "bc"} do not collide.
+        const cbtS8 separator = (cbtS8)0xFF;
+        return cbtHashFNV1a(&separator, 1, _hash);
+    }
+
+    cbtBool GL_cbtProgramBinaryCache::IsSupported()
+    {
+        if (s_Supported < 0)
+        {
+            GLint numFormats = 0;
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+            s_Supported = (numFormats > 0) ? 1 : 0;
+            if (!s_Supported)
+            { CBT_LOG_INFO(CBT_LOG_CATEGORY_RENDER, "Program binaries are not supported by this driver."); }
+        }
+        return s_Supported == 1;
+    }
+
+    cbtStr GL_cbtProgramBinaryCache::GetFilePath(cbtU64 _key)
+    {
+        cbtS8 fileName[32];
+        std::snprintf(fileName, sizeof(fileName), "%016llx.bin", _key);
+        return s_Directory + fileName;
+    }
+
+    void GL_cbtProgramBinaryCache::Invalidate(cbtU64 _key)
+    {
+        cbtFileUtil::RemoveFile(GetFilePath(_key));
+        ++s_Stats.m_Invalidations;
+    }
+
+    cbtU64 GL_cbtProgramBinaryCache::GetKey(const std::vector<cbtStr>& _vertexShaderSources,
+            const std::vector<cbtStr>& _fragmentShaderSources)
+    {
+        if (s_DriverID.empty())
+        {
+            const GLenum driverStrings[] = { GL_VENDOR, GL_RENDERER, GL_VERSION, GL_SHADING_LANGUAGE_VERSION };
+            for (cbtU32 i = 0; i < sizeof(driverStrings) / sizeof(driverStrings[0]); ++i)
+            {
+                const GLubyte* driverString = glGetString(driverStrings[i]);
+                s_DriverID += driverString ? reinterpret_cast<const cbtS8*>(driverString) : "";
+                s_DriverID += ";";
+            }
+        }
+
+        // The driver is hashed first, so the source part of the key is the same as cbtShaderProgram::GetSourceKey() computes for the render engine's cache.
+        return cbtShaderProgram::GetSourceKey(_vertexShaderSources, _fragmentShaderSources,
+                Hash(s_DriverID, CBT_FNV_OFFSET_BASIS));
+    }
+
+    cbtBool GL_cbtProgramBinaryCache::Load(cbtU64 _key, GLuint _programID)
+    {
+        if (!s_Enabled || !IsSupported())
+        { return false; }
+
+        auto startTime = std::chrono::steady_clock::now();
+
+        std::vector<cbtByte> bytes;
+        if (!cbtFileUtil::FileToBytes(GetFilePath(_key), bytes))
+        { return false; }
+
+        // Reject anything that is not a complete binary written by this version of the cache for this key.
+        Header header;
+        if (bytes.size() < sizeof(Header))
+        {
+            Invalidate(_key);
+            return false;
+        }
+        std::memcpy(&header, &bytes[0], sizeof(Header));
+        if (header.m_Magic != MAGIC || header.m_Version != VERSION || header.m_Key != _key ||
+                bytes.size() != sizeof(Header) + header.m_Length)
+        {
+            Invalidate(_key);
+            return false;
+        }
+
+        // The driver may still reject the binary, such as after a driver update which did not change its version string.
+        glProgramBinary(_programID, header.m_Format, &bytes[sizeof(Header)], (GLsizei)header.m_Length);
+        GLint linkStatus = GL_FALSE;
+        glGetProgramiv(_programID, GL_LINK_STATUS, &linkStatus);
+        if (linkStatus == GL_FALSE)
+        {
+            CBT_LOG_WARN(CBT_LOG_CATEGORY_RENDER, "Cached program binary %016llx was rejected by the driver.", _key);
+            Invalidate(_key);
+            return false;
+        }
+
+        std::chrono::duration<cbtF64, std::milli> loadTime = std::chrono::steady_clock::now() - startTime;
+        ++s_Stats.m_Hits;
+        s_Stats.m_LoadTime += loadTime.count();
+        if (header.m_CompileTime > loadTime.count())
+        { s_Stats.m_TimeSaved += header.m_CompileTime - loadTime.count(); }
+
+        return true;
+    }
+
+    void GL_cbtProgramBinaryCache::Store(cbtU64 _key, GLuint _programID, cbtF64 _compileTime)
+    {
+        ++s_Stats.m_Misses;
+        s_Stats.m_CompileTime += _compileTime;
+
+        if (!s_Enabled || !IsSupported())
+        { return; }
+
+        GLint binaryLength = 0;
+        glGetProgramiv(_programID, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+        if (binaryLength <= 0)
+        { return; }
+
+        Header header;
+        header.m_Magic = MAGIC;
+        header.m_Version = VERSION;
+        header.m_Key = _key;
+        header.m_CompileTime = _compileTime;
+
+        std::vector<cbtByte> bytes(sizeof(Header) + binaryLength);
+        GLsizei writtenLength = 0;
+        glGetProgramBinary(_programID, binaryLength, &writtenLength, &header.m_Format, &bytes[sizeof(Header)]);
+        header.m_Length = (cbtU32)writtenLength;
+        std::memcpy(&bytes[0], &header, sizeof(Header));
+        bytes.resize(sizeof(Header) + writtenLength);
+
+        if (!cbtFileUtil::CreateDirectories(s_Directory) ||
+                !cbtFileUtil::BytesToFile(GetFilePath(_key), &bytes[0], bytes.size()))
+        {
+            CBT_LOG_WARN(CBT_LOG_CATEGORY_RENDER, "Cannot write program binary to %s.", s_Directory.c_str());
+        }
+    }
+
+    void GL_cbtProgramBinaryCache::LogStats()
+    {
+        CBT_LOG_INFO(CBT_LOG_CATEGORY_RENDER,
+                "Program Binary Cache: %u hits, %u misses, %u invalidated. Loading took %.2fms, compiling took %.2fms, saved %.2fms.",
+                s_Stats.m_Hits, s_Stats.m_Misses, s_Stats.m_Invalidations, s_Stats.m_LoadTime, s_Stats.m_CompileTime,
+                s_Stats.m_TimeSaved);
+    }
+
+NS_CBT_END
+
+#endif // CBT_OPENGL
\ No newline at end of file
@@ -0,0 +1,156 @@
+#pragma once
+
+// Include CBT
+#include "cbtMacros.h"
+
+#ifdef CBT_OPENGL
+
+// Include GLEW
+#include <GL/glew.h>
+
+// Include STD
+#include <vector>
+
+NS_CBT_BEGIN
+
+    /// Statistics recorded by GL_cbtProgramBinaryCache.
+    struct GL_cbtProgramBinaryCacheStats
+    {
+        /// The number of programs loaded from the cache.
+        cbtU32 m_Hits = 0;
+        /// The number of programs compiled and linked from source.
+        cbtU32 m_Misses = 0;
+        /// The number of cached binaries which were corrupt or rejected by the driver, and have been deleted.
+        cbtU32 m_Invalidations = 0;
+        /// The time spent loading cached binaries, in milliseconds.
+        cbtF64 m_LoadTime = 0.0;
+        /// The time spent compiling and linking programs from source, in milliseconds.
+        cbtF64 m_CompileTime = 0.0;
+        /// The compile time avoided by cache hits, in milliseconds. This uses the compile time recorded when each binary was stored.
+        cbtF64 m_TimeSaved = 0.0;
+    };
+
+    /**
+        \brief
+            An on-disk cache of linked program binaries, using glGetProgramBinary and glProgramBinary.
+            Binaries are keyed by a hash of the shader sources and the driver's vendor, renderer and version strings,
+            so editing a shader or updating the driver results in a miss rather than a stale binary.
+            If the driver rejects a cached binary anyway, the file is deleted and the program is compiled from source.
+    */
+    class GL_cbtProgramBinaryCache
+    {
+    private:
+        /// The file header written in front of each cached binary.
+        struct Header
+        {
+            cbtU32 m_Magic;
+            cbtU32 m_Version;
+            cbtU64 m_Key;
+            GLenum m_Format;
+            cbtU32 m_Length;
+            cbtF64 m_CompileTime;
+        };
+
+        /// Identifies a cached binary file.
+        static constexpr cbtU32 MAGIC = 0x50544243; // "CBTP"
+        /// Increase this whenever Header changes, so that old files are rejected.
+        static constexpr cbtU32 VERSION = 1;
+
+        /// Is the cache enabled.
+        static cbtBool s_Enabled;
+        /// The directory the binaries are stored in.
+        static cbtStr s_Directory;
+        /// The driver's vendor, renderer and version strings. Queried on first use.
+        static cbtStr s_DriverID;
+        /// Does the driver support at least 1 program binary format. -1 if not yet queried.
+        static cbtS32 s_Supported;
+        /// The recorded statistics.
+        static GL_cbtProgramBinaryCacheStats s_Stats;
+
+        /**
+            \brief Private Constructor. All functions should be static. No objects of this class should be created.
+        */
+        GL_cbtProgramBinaryCache()
+        {
+        }
+
+        /**
+            \brief Private Destructor. All functions should be static. No objects of this class should be created.
+        */
+        ~GL_cbtProgramBinaryCache()
+        {
+        }
+
+        static cbtU64 Hash(const cbtStr& _string, cbtU64 _hash);
+
+        static cbtBool IsSupported();
+
+        static cbtStr GetFilePath(cbtU64 _key);
+
+        static void Invalidate(cbtU64 _key);
+
+    public:
+        /**
+            \brief Get the cache key of a program.
+
+            \param _vertexShaderSources The vertex shader sources of the program.
+            \param _fragmentShaderSources The fragment shader sources of the program.
+
+            \return The cache key of the program.
+        */
+        static cbtU64 GetKey(const std::vector<cbtStr>& _vertexShaderSources,
+                const std::vector<cbtStr>& _fragmentShaderSources);
+
+        /**
+            \brief Load a cached binary into a program.
+
+            \param _key The cache key of the program.
+            \param _programID The program to load the binary into. It must not have any shaders attached.
+
+            \return Returns true if the binary was loaded and the program is linked. Otherwise, returns false and the program must be compiled from source.
+        */
+        static cbtBool Load(cbtU64 _key, GLuint _programID);
+
+        /**
+            \brief Store the binary of a linked program, and record it as a miss.
+
+            \param _key The cache key of the program.
+            \param _programID The linked program. GL_PROGRAM_BINARY_RETRIEVABLE_HINT should have been set before linking.
+            \param _compileTime The time taken to compile and link the program, in milliseconds.
+        */
+        static void Store(cbtU64 _key, GLuint _programID, cbtF64 _compileTime);
+
+        inline static cbtBool IsEnabled()
+        {
+            return s_Enabled;
+        }
+
+        inline static void SetEnabled(cbtBool _enabled)
+        {
+            s_Enabled = _enabled;
+        }
+
+        inline static const cbtStr& GetDirectory()
+        {
+            return s_Directory;
+        }
+
+        inline static void SetDirectory(const cbtStr& _directory)
+        {
+            s_Directory = _directory;
+        }
+
+        inline static const GL_cbtProgramBinaryCacheStats& GetStats()
+        {
+            return s_Stats;
+        }
+
+        /**
+            \brief Log the recorded statistics.
+        */
+        static void LogStats();
+    };
+
+NS_CBT_END
+
+#endif // CBT_OPENGL
\ No newline at end of file
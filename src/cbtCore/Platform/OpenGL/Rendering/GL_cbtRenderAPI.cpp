@@ -1,5 +1,6 @@
 // Include CBT
 #include "Rendering/RenderEngine/cbtRenderAPI.h"
+#include "GL_cbtFrameBuffer.h"
 
 #ifdef CBT_OPENGL
 
@@ -115,6 +116,12 @@ NS_CBT_BEGIN
         glDrawElementsInstanced(GL_TRIANGLES, _numElements, GL_UNSIGNED_INT, 0, _numInstances);
     }
 
+    void cbtRenderAPI::MultiDrawElementsIndirect(cbtU32 _firstCommand, cbtU32 _drawCount)
+    {
+        const void* offset = (const void*)((size_t)_firstCommand * sizeof(cbtDrawElementsIndirectCommand));
+        glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, offset, _drawCount, 0);
+    }
+
     void cbtRenderAPI::SetViewPort(cbtS32 _bottomX, cbtS32 _bottomY, cbtS32 _width, cbtS32 _height)
     {
         glViewport(_bottomX, _bottomY, _width, _height);
@@ -180,6 +187,14 @@ NS_CBT_BEGIN
                 ToOpenGLStencilOp(_stencilPassDepthPass));
     }
 
+    void cbtRenderAPI::ReadPixels(cbtS32 _bottomX, cbtS32 _bottomY, cbtS32 _width, cbtS32 _height, std::vector<cbtByte>& _pixels)
+    {
+        _pixels.resize((size_t)_width * (size_t)_height * 4);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, GL_cbtFrameBuffer::GetBufferName(nullptr));
+        glReadPixels(_bottomX, _bottomY, _width, _height, GL_RGBA, GL_UNSIGNED_BYTE, _pixels.data());
+    }
+
 NS_CBT_END
 
 #endif // CBT_OPENGL
\ No newline at end of file
@@ -1,5 +1,8 @@
 // Include CBT
 #include "GL_cbtRenderEngine.h"
+#include "GL_cbtProgramBinaryCache.h"
+#include "Rendering/RenderEngine/cbtGPUProfiler.h"
+#include "Rendering/Asset/cbtAssetLoader.h"
 
 #ifdef CBT_OPENGL
 
@@ -17,27 +20,54 @@ NS_CBT_BEGIN
 
         // Initialise GLEW (Must be initialised or textures and meshes and whatever fuck shit will fail. Learnt that the hard way when I forgot to initialise it.)
         GLenum initResult = glewInit();
+#ifdef CBT_EGL
+        // Under EGL, a GLEW built for GLX loads every function, but reports that there is no GLX display.
+        CBT_ASSERT(initResult == GLEW_OK || (_winProp.IsHeadless() && initResult == GLEW_ERROR_NO_GLX_DISPLAY));
+#else
         CBT_ASSERT(initResult == GLEW_OK);
+#endif // CBT_EGL
 
-        m_MaterialLibrary = cbtNew cbtLibrary<cbtMaterial>();
-        m_ShaderLibrary = cbtNew cbtLibrary<cbtShaderProgram>();
-        m_MeshLibrary = cbtNew cbtLibrary<cbtMesh>();
-        m_TextureLibrary = cbtNew cbtLibrary<cbtTexture>();
+        // Let the driver compile shaders on as many threads as it wants. Shader programs are then linked in the background and polled.
+        if (GLEW_KHR_parallel_shader_compile)
+        { glMaxShaderCompilerThreadsKHR(0xFFFFFFFF); }
+        else if (GLEW_ARB_parallel_shader_compile)
+        { glMaxShaderCompilerThreadsARB(0xFFFFFFFF); }
+
+        m_MaterialLibrary = cbtNew cbtIDLibrary<cbtMaterial>();
+        m_ShaderLibrary = cbtNew cbtIDLibrary<cbtShaderProgram>();
+        m_MeshLibrary = cbtNew cbtIDLibrary<cbtMesh>();
+        m_TextureLibrary = cbtNew cbtIDLibrary<cbtTexture>();
+        m_ShaderCache = cbtNew cbtAssetCache<cbtShaderProgram, cbtU64>();
+        m_MeshCache = cbtNew cbtAssetCache<cbtMesh>();
+        m_TextureCache = cbtNew cbtAssetCache<cbtTexture>();
         m_Renderer = cbtNew cbtRenderer();
+
+        // Start the asset loading worker threads.
+        cbtAssetLoader::GetInstance();
     }
 
     void GL_cbtRenderEngine::Update()
     {
+        // Upload any assets which have finished loading before rendering.
+        cbtAssetLoader::GetInstance()->Update();
         m_Renderer->Update();
     }
 
     void GL_cbtRenderEngine::Exit()
     {
+        // Stop loading assets while the context is still alive.
+        cbtAssetLoader::Destroy();
+        GL_cbtProgramBinaryCache::LogStats();
+
         delete m_MaterialLibrary;
         delete m_ShaderLibrary;
         delete m_MeshLibrary;
         delete m_TextureLibrary;
+        delete m_ShaderCache;
+        delete m_MeshCache;
+        delete m_TextureCache;
         delete m_Renderer;
+        cbtGPUProfiler::Destroy();
         cbtManaged::ClearReleasePool();
 
         delete m_Window;
@@ -1,9 +1,13 @@
 // Include CBT
 #include "GL_cbtShaderProgram.h"
+#include "GL_cbtProgramBinaryCache.h"
 #include "Debug/cbtDebug.h"
 
 #ifdef CBT_OPENGL
 
+// Include STD
+#include <chrono>
+
 NS_CBT_BEGIN
 
     cbtShaderProgram*
@@ -17,70 +21,79 @@ NS_CBT_BEGIN
             const std::vector<cbtStr> _fragmentShaderSources)
             :cbtShaderProgram(_name)
     {
-        std::vector<GLuint> vertexShaderIDs, fragmentShaderIDs;
-
         // Create the shader program.
         m_ProgramID = glCreateProgram();
 
-        // Create the shaders.
-        for (cbtS32 i = 0; i < _vertexShaderSources.size(); ++i)
+        /* Load the program from the binary cache if possible.
+        Otherwise, only issue the compile and link here. Their status is not queried till the program is first polled or used,
+        so that creating many programs in a row does not serialise the driver's compiler. */
+        m_CacheKey = GL_cbtProgramBinaryCache::GetKey(_vertexShaderSources, _fragmentShaderSources);
+        if (GL_cbtProgramBinaryCache::Load(m_CacheKey, m_ProgramID))
         {
-            // Create the fragment shader. OpenGL supports multiple vertex shaders per shader program.
-            GLuint vertexShaderID = CreateGLShader(GL_VERTEX_SHADER, _vertexShaderSources[i]);
-            vertexShaderIDs.push_back(vertexShaderID);
-            // Attach the shader to the program.
-            glAttachShader(m_ProgramID, vertexShaderID);
+            m_Linked = true;
+            ResolveUniforms();
         }
-
-        for (cbtS32 i = 0; i < _fragmentShaderSources.size(); ++i)
+        else
         {
-            // Create the fragment shader. OpenGL supports multiple fragment shaders per shader program.
-            GLuint fragmentShaderID = CreateGLShader(GL_FRAGMENT_SHADER, _fragmentShaderSources[i]);
-            fragmentShaderIDs.push_back(fragmentShaderID);
-            // Attach the shader to the program.
-            glAttachShader(m_ProgramID, fragmentShaderID);
+            m_CompileStartTime = std::chrono::steady_clock::now();
+            BeginCompileAndLink(_vertexShaderSources, _fragmentShaderSources);
+            m_Pending = true;
         }
+    }
 
-        // Link the shader program. Now that we have attached the shaders, this will use the attached shaders to create an executable that will run on the programmable vertex processor.
-        glLinkProgram(m_ProgramID);
-
-        /* Now that we are done creating the shader program, we no longer need the shaders and they can be deleted.
-        It is also possible to store the shaders to create other shader programs,
-        but there isn't a compelling reason to do so since we can just re-create them again if necessary. */
-        for (cbtS32 i = 0; i < vertexShaderIDs.size(); ++i)
+    GL_cbtShaderProgram::~GL_cbtShaderProgram()
+    {
+        for (cbtU32 i = 0; i < m_ShaderIDs.size(); ++i)
         {
-            glDetachShader(m_ProgramID, vertexShaderIDs[i]);
-            glDeleteShader(vertexShaderIDs[i]);
+            glDetachShader(m_ProgramID, m_ShaderIDs[i]);
+            glDeleteShader(m_ShaderIDs[i]);
         }
-        for (cbtS32 i = 0; i < fragmentShaderIDs.size(); ++i)
+        glDeleteProgram(m_ProgramID);
+    }
+
+    cbtBool GL_cbtShaderProgram::IsReady()
+    {
+        if (!m_Pending)
+        { return true; }
+
+        // Without GL_KHR_parallel_shader_compile there is no way to check without blocking, so just finish linking.
+        if (GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile)
         {
-            glDetachShader(m_ProgramID, fragmentShaderIDs[i]);
-            glDeleteShader(fragmentShaderIDs[i]);
+            GLint completionStatus = GL_FALSE;
+            glGetProgramiv(m_ProgramID, GL_COMPLETION_STATUS_KHR, &completionStatus);
+            if (completionStatus == GL_FALSE)
+            { return false; }
         }
 
-        // Verify Link Status
-        GLint linkStatus = 0;
-        glGetProgramiv(m_ProgramID, GL_LINK_STATUS, &linkStatus);
-        if (linkStatus == GL_FALSE)
-        {
-            // Get Info Log
-            GLint infoLogLength = 0;
-            glGetProgramiv(m_ProgramID, GL_INFO_LOG_LENGTH, &infoLogLength);
-            GLchar* infoLog = new GLchar[infoLogLength];
-            glGetProgramInfoLog(
-                    m_ProgramID/*Shader*/,
-                    infoLogLength /*Max Length*/,
-                    &infoLogLength /*This returns the length of the Info Log. (We already know the value, but we need to pass in the parameter anyways.)*/,
-                    infoLog/*Info Log*/);
+        Finalize();
+        return true;
+    }
 
-            // Assert
-            CBT_LOG_ERROR(CBT_LOG_CATEGORY_RENDER, infoLog);
-            CBT_ASSERT(false);
+    cbtBool GL_cbtShaderProgram::HasLinkFailed() const
+    {
+        return !m_Pending && !m_Linked;
+    }
 
-            // Clean-up
-            delete[] infoLog;
+    void GL_cbtShaderProgram::Finalize()
+    {
+        if (!m_Pending)
+        { return; }
+        m_Pending = false;
+
+        m_Linked = EndCompileAndLink();
+        if (m_Linked)
+        {
+            // This includes any time the program spent waiting to be polled, so it may overestimate the compile time.
+            std::chrono::duration<cbtF64, std::milli> compileTime =
+                    std::chrono::steady_clock::now() - m_CompileStartTime;
+            GL_cbtProgramBinaryCache::Store(m_CacheKey, m_ProgramID, compileTime.count());
         }
 
+        ResolveUniforms();
+    }
+
+    void GL_cbtShaderProgram::ResolveUniforms()
+    {
         // Get Uniform(s)
         m_Uniforms[CBT_U_MATRIX_PROJECTION] = GetUniformLocation("CBT_U_MATRIX_PROJECTION");
         m_Uniforms[CBT_U_TEXTURE_SCALE] = GetUniformLocation("CBT_U_TEXTURE_SCALE");
@@ -160,12 +173,78 @@ NS_CBT_BEGIN
 
         SetUniform("CBT_PBUFFER_COMPOSITE", CBT_PBUFFER_COMPOSITE);
 
-        CBT_LOG_INFO(CBT_LOG_CATEGORY_RENDER, "%s Created", _name.c_str());
+        CBT_LOG_INFO(CBT_LOG_CATEGORY_RENDER, "%s Created", m_Name.c_str());
     }
 
-    GL_cbtShaderProgram::~GL_cbtShaderProgram()
+    void GL_cbtShaderProgram::BeginCompileAndLink(const std::vector<cbtStr>& _vertexShaderSources,
+            const std::vector<cbtStr>& _fragmentShaderSources)
     {
-        glDeleteProgram(m_ProgramID);
+        // Allow the linked binary to be retrieved for the program binary cache.
+        glProgramParameteri(m_ProgramID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+        // Create the shaders.
+        for (cbtS32 i = 0; i < _vertexShaderSources.size(); ++i)
+        {
+            // Create the fragment shader. OpenGL supports multiple vertex shaders per shader program.
+            GLuint vertexShaderID = CreateGLShader(GL_VERTEX_SHADER, _vertexShaderSources[i]);
+            m_ShaderIDs.push_back(vertexShaderID);
+            // Attach the shader to the program.
+            glAttachShader(m_ProgramID, vertexShaderID);
+        }
+
+        for (cbtS32 i = 0; i < _fragmentShaderSources.size(); ++i)
+        {
+            // Create the fragment shader. OpenGL supports multiple fragment shaders per shader program.
+            GLuint fragmentShaderID = CreateGLShader(GL_FRAGMENT_SHADER, _fragmentShaderSources[i]);
+            m_ShaderIDs.push_back(fragmentShaderID);
+            // Attach the shader to the program.
+            glAttachShader(m_ProgramID, fragmentShaderID);
+        }
+
+        // Link the shader program. Now that we have attached the shaders, this will use the attached shaders to create an executable that will run on the programmable vertex processor.
+        glLinkProgram(m_ProgramID);
+    }
+
+    cbtBool GL_cbtShaderProgram::EndCompileAndLink()
+    {
+        // Verify Link Status
+        GLint linkStatus = 0;
+        glGetProgramiv(m_ProgramID, GL_LINK_STATUS, &linkStatus);
+        if (linkStatus == GL_FALSE)
+        {
+            // The compile status of the shaders is only checked if linking failed, as checking it earlier would block.
+            for (cbtU32 i = 0; i < m_ShaderIDs.size(); ++i)
+            { LogShaderErrors(m_ShaderIDs[i]); }
+
+            // Get Info Log
+            GLint infoLogLength = 0;
+            glGetProgramiv(m_ProgramID, GL_INFO_LOG_LENGTH, &infoLogLength);
+            GLchar* infoLog = new GLchar[infoLogLength];
+            glGetProgramInfoLog(
+                    m_ProgramID/*Shader*/,
+                    infoLogLength /*Max Length*/,
+                    &infoLogLength /*This returns the length of the Info Log. (We already know the value, but we need to pass in the parameter anyways.)*/,
+                    infoLog/*Info Log*/);
+
+            // Assert
+            CBT_LOG_ERROR(CBT_LOG_CATEGORY_RENDER, infoLog);
+            CBT_ASSERT(false);
+
+            // Clean-up
+            delete[] infoLog;
+        }
+
+        /* Now that we are done creating the shader program, we no longer need the shaders and they can be deleted.
+        It is also possible to store the shaders to create other shader programs,
+        but there isn't a compelling reason to do so since we can just re-create them again if necessary. */
+        for (cbtU32 i = 0; i < m_ShaderIDs.size(); ++i)
+        {
+            glDetachShader(m_ProgramID, m_ShaderIDs[i]);
+            glDeleteShader(m_ShaderIDs[i]);
+        }
+        m_ShaderIDs.clear();
+
+        return linkStatus != GL_FALSE;
     }
 
     GLuint GL_cbtShaderProgram::CreateGLShader(GLenum _shaderType, const cbtStr& _shaderSource)
@@ -176,35 +255,35 @@ NS_CBT_BEGIN
         GLuint shaderID = glCreateShader(_shaderType);
         // Set the source (the shader code) of the shader.
         glShaderSource(shaderID, 1, &(sourceCode), nullptr);
-        // Compile the shader.
+        // Compile the shader. The compile status is not checked here, as that would block till the driver has finished compiling.
         glCompileShader(shaderID);
 
+        return shaderID;
+    }
+
+    void GL_cbtShaderProgram::LogShaderErrors(GLuint _shaderID)
+    {
         // Verify Compile Status
         GLint compileStatus = 0;
-        glGetShaderiv(shaderID, GL_COMPILE_STATUS, &compileStatus);
+        glGetShaderiv(_shaderID, GL_COMPILE_STATUS, &compileStatus);
         if (compileStatus == GL_FALSE)
         {
             // Get Info Log
             GLint infoLogLength = 0;
-            glGetShaderiv(shaderID, GL_INFO_LOG_LENGTH, &infoLogLength);
+            glGetShaderiv(_shaderID, GL_INFO_LOG_LENGTH, &infoLogLength);
             GLchar* infoLog = new GLchar[infoLogLength];
             glGetShaderInfoLog(
-                    shaderID /*Shader*/,
+                    _shaderID /*Shader*/,
                     infoLogLength /*Max Length*/,
                     &infoLogLength /*This returns the length of the Info Log. (We already know the value, but we need to pass in the parameter anyways.)*/,
                     infoLog/*Info Log*/);
 
-            // Assert
+            // Log
             CBT_LOG_ERROR(CBT_LOG_CATEGORY_RENDER, infoLog);
-            CBT_ASSERT(compileStatus != GL_FALSE);
 
             // Clean-up
             delete[] infoLog;
-            glDeleteShader(shaderID);
-
-            return 0;
         }
-        return shaderID;
     }
 
     GLint GL_cbtShaderProgram::GetUniformLocation(const cbtStr& _uniformName) const
@@ -232,6 +311,7 @@ NS_CBT_BEGIN
 // Use Program
     void GL_cbtShaderProgram::UseProgram()
     {
+        Finalize();
         glUseProgram(m_ProgramID);
     }
 
@@ -9,6 +9,9 @@
 #include <GL/glew.h>
 // #include <gl/GL.h>
 
+// Include STD
+#include <chrono>
+
 NS_CBT_BEGIN
 
     class GL_cbtShaderProgram : public cbtShaderProgram
@@ -17,8 +20,44 @@ NS_CBT_BEGIN
         GLuint m_ProgramID;
         GLint m_Uniforms[CBT_NUM_SHADER_UNIFORM];
 
+        /// Has the link been issued but not yet finalised.
+        cbtBool m_Pending = false;
+        /// Was the program linked, or loaded from GL_cbtProgramBinaryCache. Only valid once the program is no longer pending.
+        cbtBool m_Linked = false;
+        /// The shaders attached to the program while it is pending.
+        std::vector<GLuint> m_ShaderIDs;
+        /// The key of the program in GL_cbtProgramBinaryCache.
+        cbtU64 m_CacheKey = 0;
+        /// When compilation was issued, used to record the compile time in GL_cbtProgramBinaryCache.
+        std::chrono::steady_clock::time_point m_CompileStartTime;
+
         virtual ~GL_cbtShaderProgram();
 
+        /**
+            \brief Issue the compile and link commands without querying their status, so that the driver is free to compile in the background.
+        */
+        void BeginCompileAndLink(const std::vector<cbtStr>& _vertexShaderSources,
+                const std::vector<cbtStr>& _fragmentShaderSources);
+
+        /**
+            \brief Query the link status, logging the compile and link errors if it failed, and delete the shaders. Blocks till linking has finished.
+
+            \return Returns true if the program was linked. Otherwise, returns false.
+        */
+        cbtBool EndCompileAndLink();
+
+        /**
+            \brief Finish linking the program if it is pending, and resolve its uniforms. Blocks till linking has finished.
+        */
+        void Finalize();
+
+        /**
+            \brief Get the locations of the engine's uniforms and assign the texture slots.
+        */
+        void ResolveUniforms();
+
+        void LogShaderErrors(GLuint _shaderID);
+
         GLuint CreateGLShader(GLenum _shaderType, const cbtStr& _shaderSource);
 
         GLint GetUniformLocation(const cbtStr& _uniformName) const;
@@ -29,6 +68,10 @@ NS_CBT_BEGIN
         GL_cbtShaderProgram(const cbtStr& _name, const std::vector<cbtStr>& _vertexShaderSources,
                 const std::vector<cbtStr> _fragmentShaderSources);
 
+        virtual cbtBool IsReady();
+
+        virtual cbtBool HasLinkFailed() const;
+
         /// Use Program
         virtual void UseProgram();
 
@@ -47,6 +47,7 @@ NS_CBT_BEGIN
         cbtU32 elementCount = layout.GetElementCount();
 
         glVertexArrayVertexBuffer(m_VAOName, m_VBOCounter, vboName, 0, layout.GetByteSize());
+        m_AttachedBuffers.push_back(vboName);
         glVertexArrayBindingDivisor(m_VAOName, m_VBOCounter, _vbo->GetDivisor());
 
         for (cbtU32 i = 0; i < elementCount; ++i)
@@ -80,6 +81,20 @@ NS_CBT_BEGIN
         ++m_VBOCounter;
     }
 
+    void GL_cbtVertexArray::AttachBuffer(cbtU32 _index, GLuint _bufferName)
+    {
+        CBT_ASSERT(_index < m_VBOs.size());
+        if (m_AttachedBuffers[_index] == _bufferName)
+        { return; }
+        m_AttachedBuffers[_index] = _bufferName;
+        glVertexArrayVertexBuffer(m_VAOName, _index, _bufferName, 0, m_VBOs[_index]->GetLayout().GetByteSize());
+    }
+
+    void GL_cbtVertexArray::ResetVBO(cbtU32 _index)
+    {
+        AttachBuffer(_index, static_cast<GL_cbtVertexBuffer*>(m_VBOs[_index])->GetVBOName());
+    }
+
     void GL_cbtVertexArray::SetEBO(cbtElementBuffer* _ebo)
     {
         _ebo->Retain();
@@ -21,6 +21,8 @@ NS_CBT_BEGIN
         GLuint m_VAOName;
         cbtU32 m_AttributeCounter;
         cbtU32 m_VBOCounter;
+        /// The buffer each VBO's attributes currently read from, indexed by the index of the VBO.
+        std::vector<GLuint> m_AttachedBuffers;
 
         virtual ~GL_cbtVertexArray();
 
@@ -32,6 +34,16 @@ NS_CBT_BEGIN
         virtual void AddVBO(cbtVertexBuffer* _vbo);
 
         virtual void SetEBO(cbtElementBuffer* _ebo);
+
+        /**
+            \brief Make the attributes of a VBO read from another buffer with the same layout, such as a buffer shared by several VAOs.
+
+            \param _index The index of the VBO.
+            \param _bufferName The buffer to read from.
+        */
+        void AttachBuffer(cbtU32 _index, GLuint _bufferName);
+
+        virtual void ResetVBO(cbtU32 _index);
     };
 
 NS_CBT_END
@@ -5,6 +5,12 @@
 #ifdef CBT_SDL
 
 #include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+
+// Include STD
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
 
 NS_CBT_BEGIN
 
@@ -36,6 +42,67 @@ NS_CBT_BEGIN
         SDL_RWclose(file);
     }
 
+    cbtBool cbtFileUtil::FileToBytes(const cbtStr& _filePath, std::vector<cbtByte>& _bytes)
+    {
+        SDL_RWops* file = SDL_RWFromFile(_filePath.c_str(), "rb");
+        if (!file)
+        { return false; }
+
+        cbtS64 fileSize = SDL_RWsize(file);
+        _bytes.resize(fileSize > 0 ? (size_t)fileSize : 0);
+        size_t readCount = _bytes.empty() ? 0 : SDL_RWread(file, &_bytes[0], _bytes.size(), 1);
+        SDL_RWclose(file);
+
+        return fileSize > 0 && readCount == 1;
+    }
+
+    cbtBool cbtFileUtil::BytesToFile(const cbtStr& _filePath, const cbtByte* _bytes, size_t _size)
+    {
+        SDL_RWops* file = SDL_RWFromFile(_filePath.c_str(), "wb");
+        if (!file)
+        { return false; }
+
+        size_t writeLength = SDL_RWwrite(file, _bytes, 1, _size);
+        SDL_RWclose(file);
+
+        return writeLength == _size;
+    }
+
+    void cbtFileUtil::RemoveFile(const cbtStr& _filePath)
+    {
+        std::remove(_filePath.c_str());
+    }
+
+    cbtBool cbtFileUtil::CreateDirectories(const cbtStr& _directoryPath)
+    {
+        std::error_code errorCode;
+        std::filesystem::create_directories(_directoryPath, errorCode);
+        return std::filesystem::is_directory(_directoryPath, errorCode);
+    }
+
+    cbtBool cbtFileUtil::PixelsToPNG(const cbtStr& _filePath, const cbtByte* _pixels, cbtU32 _width, cbtU32 _height)
+    {
+        SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, (int)_width, (int)_height, 32, SDL_PIXELFORMAT_RGBA32);
+        if (surface == nullptr)
+        {
+            CBT_LOG_WARN(CBT_LOG_CATEGORY_APPLICATION, "Unable to create a surface to write %s! %s", _filePath.c_str(), SDL_GetError());
+            return false;
+        }
+
+        // Flip the rows, as PNG files start from the top row.
+        const cbtU32 rowSize = _width * 4;
+        for (cbtU32 row = 0; row < _height; ++row)
+        {
+            std::memcpy(static_cast<cbtByte*>(surface->pixels) + row * surface->pitch, _pixels + (_height - row - 1) * rowSize, rowSize);
+        }
+
+        cbtBool written = (IMG_SavePNG(surface, _filePath.c_str()) == 0);
+        if (!written)
+        { CBT_LOG_WARN(CBT_LOG_CATEGORY_APPLICATION, "Unable to write %s! %s", _filePath.c_str(), IMG_GetError()); }
+        SDL_FreeSurface(surface);
+        return written;
+    }
+
 NS_CBT_END
 
 #endif // CBT_SDL
\ No newline at end of file
@@ -27,12 +27,9 @@ NS_CBT_BEGIN
         }
     }
 
-    void cbtDebug::Log(cbtLogCategory _category, cbtLogPriority _priority, const cbtS8* _format, ...)
+    void cbtDebug::Write(cbtLogCategory _category, cbtLogPriority _priority, const cbtS8* _message)
     {
-        va_list args;
-        va_start(args, _format);
-        cbtStr format = "[" + cbtDebug::ToString(_category) + "] " + cbtStr(_format);
-        SDL_LogMessageV(SDL_LOG_CATEGORY_APPLICATION, ToSDLLogPriority(_priority), format.c_str(), args);
+        SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, ToSDLLogPriority(_priority), "[%s] %s", cbtDebug::ToString(_category).c_str(), _message);
     }
 
 NS_CBT_END
\ No newline at end of file
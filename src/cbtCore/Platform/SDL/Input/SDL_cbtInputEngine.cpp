@@ -36,21 +36,31 @@ NS_CBT_BEGIN
 
     void SDL_cbtInputEngine::Update()
     {
+        // SDL is still polled while replaying, so that the window keeps responding, but the keyboard is ignored.
         SDLEventPoller::PollEvents();
+        const cbtBool replaying = (m_InputMode == CBT_INPUT_MODE_REPLAY);
+        if (replaying)
+        { ReplayFrame(); }
+        else
+        { RecordFrameContext(); }
+
         while (!m_SDLEventListener.m_EventQueue.empty())
         {
             SDL_Event& sdlEvent = m_SDLEventListener.m_EventQueue.front();
 
-            switch (sdlEvent.type)
+            if (!replaying)
             {
-            case SDL_KEYDOWN:
-                m_KeyboardHandler->OnKeyPress(m_InputContext, ToCBTKeycode(sdlEvent.key.keysym.sym));
-                break;
-            case SDL_KEYUP:
-                m_KeyboardHandler->OnKeyRelease(m_InputContext, ToCBTKeycode(sdlEvent.key.keysym.sym));
-                break;
-            default:
-                break;
+                switch (sdlEvent.type)
+                {
+                case SDL_KEYDOWN:
+                    OnKeyEvent(ToCBTKeycode(sdlEvent.key.keysym.sym), true, sdlEvent.key.timestamp);
+                    break;
+                case SDL_KEYUP:
+                    OnKeyEvent(ToCBTKeycode(sdlEvent.key.keysym.sym), false, sdlEvent.key.timestamp);
+                    break;
+                default:
+                    break;
+                }
             }
 
             m_SDLEventListener.m_EventQueue.pop();
@@ -33,6 +33,11 @@ NS_CBT_BEGIN
 
         virtual void Exit();
 
+        virtual cbtU32 GetTimestamp() const
+        {
+            return SDL_GetTicks();
+        }
+
         virtual cbtKeyboardHandler* GetKeyboardHandler()
         {
             return m_KeyboardHandler;
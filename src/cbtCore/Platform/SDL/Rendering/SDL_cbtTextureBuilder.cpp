@@ -1,5 +1,6 @@
 // Include CBT
 #include "Rendering/Texture/cbtTextureBuilder.h"
+#include "Rendering/RenderEngine/cbtRenderEngine.h"
 
 #ifdef CBT_SDL
 
@@ -8,29 +9,138 @@
 
 NS_CBT_BEGIN
 
+    class cbtTexture2DRequest : public cbtAssetRequest<cbtTexture>
+    {
+        friend class cbtTextureBuilder;
+
+    protected:
+        const cbtStr m_Name;
+        const cbtStr m_FilePath;
+        cbtBool m_FlipVertical, m_FlipHorizontal;
+        std::vector<cbtU8> m_Pixels;
+        cbtS32 m_Width = 0, m_Height = 0;
+
+        cbtTexture2DRequest(const cbtStr& _name, const cbtStr& _filePath, cbtBool _flipVertical,
+                cbtBool _flipHorizontal)
+                :m_Name(_name), m_FilePath(_filePath), m_FlipVertical(_flipVertical),
+                 m_FlipHorizontal(_flipHorizontal)
+        {
+        }
+
+        virtual ~cbtTexture2DRequest()
+        {
+        }
+
+        virtual void Decode()
+        {
+            if (!cbtTextureBuilder::DecodeImage(m_FilePath, m_FlipVertical, m_FlipHorizontal, m_Pixels, m_Width,
+                    m_Height))
+            { m_State = CBT_ASSET_STATE_FAILED; }
+        }
+
+        virtual void Upload()
+        {
+            cbtTexture* texture = cbtTexture::Create2DTexture(m_Name, m_Width, m_Height, CBT_RGBA8, &m_Pixels[0]);
+            cbtRenderEngine::GetInstance()->CacheTexture(m_Key, texture);
+            SetAsset(texture);
+            std::vector<cbtU8>().swap(m_Pixels);
+        }
+    };
+
+    class cbtCubeMapRequest : public cbtAssetRequest<cbtTexture>
+    {
+        friend class cbtTextureBuilder;
+
+    protected:
+        const cbtStr m_Name;
+        const std::array<cbtStr, CBT_CUBEMAP_MAX_SIDES> m_FilePath;
+        cbtBool m_FlipVertical, m_FlipHorizontal;
+        std::vector<cbtU8> m_Pixels[CBT_CUBEMAP_MAX_SIDES];
+        cbtS32 m_Width = 0, m_Height = 0;
+
+        cbtCubeMapRequest(const cbtStr& _name, const std::array<cbtStr, CBT_CUBEMAP_MAX_SIDES>& _filePath,
+                cbtBool _flipVertical, cbtBool _flipHorizontal)
+                :m_Name(_name), m_FilePath(_filePath), m_FlipVertical(_flipVertical),
+                 m_FlipHorizontal(_flipHorizontal)
+        {
+        }
+
+        virtual ~cbtCubeMapRequest()
+        {
+        }
+
+        virtual void Decode()
+        {
+            for (cbtU32 i = 0; i < CBT_CUBEMAP_MAX_SIDES; ++i)
+            {
+                if (!cbtTextureBuilder::DecodeImage(m_FilePath[i], m_FlipVertical, m_FlipHorizontal, m_Pixels[i],
+                        m_Width, m_Height))
+                {
+                    m_State = CBT_ASSET_STATE_FAILED;
+                    return;
+                }
+            }
+        }
+
+        virtual void Upload()
+        {
+            cbtTexture* texture = cbtTexture::CreateCubeMap(m_Name, m_Width, m_Height, CBT_RGBA8, {
+                    &m_Pixels[0][0], &m_Pixels[1][0], &m_Pixels[2][0],
+                    &m_Pixels[3][0], &m_Pixels[4][0], &m_Pixels[5][0]
+            });
+            cbtRenderEngine::GetInstance()->CacheTexture(m_Key, texture);
+            SetAsset(texture);
+            for (cbtU32 i = 0; i < CBT_CUBEMAP_MAX_SIDES; ++i)
+            { std::vector<cbtU8>().swap(m_Pixels[i]); }
+        }
+    };
+
 // Image Loading
-    cbtTexture* cbtTextureBuilder::Create2DTexture(const cbtStr& _name, const cbtStr& _filePath, cbtBool _flipVertical,
-            cbtBool _flipHorizontal)
+    cbtBool cbtTextureBuilder::DecodeImage(const cbtStr& _filePath, cbtBool _flipVertical, cbtBool _flipHorizontal,
+            std::vector<cbtU8>& _pixels, cbtS32& _width, cbtS32& _height)
     {
-        SDL_PixelFormat* pixelFormat = SDL_AllocFormat(SDL_PIXELFORMAT_RGBA32);
         SDL_Surface* rawSurface = IMG_Load(_filePath.c_str());
+        if (!rawSurface)
+        {
+            CBT_LOG_ERROR(CBT_LOG_CATEGORY_RENDER, "Cannot load image [%s]. %s", _filePath.c_str(), IMG_GetError());
+            return false;
+        }
+
+        SDL_PixelFormat* pixelFormat = SDL_AllocFormat(SDL_PIXELFORMAT_RGBA32);
         SDL_Surface* convertedSurface = SDL_ConvertSurface(rawSurface, pixelFormat, 0);
+        SDL_FreeSurface(rawSurface);
         CBT_ASSERT(convertedSurface);
 
-        cbtS32 width = convertedSurface->w;
-        cbtS32 height = convertedSurface->h;
+        _width = convertedSurface->w;
+        _height = convertedSurface->h;
         cbtU8* pixelData = static_cast<cbtU8*>(convertedSurface->pixels);
         if (_flipHorizontal)
-        { FlipImageHorizontally(pixelData, width, height, pixelFormat->BytesPerPixel); }
+        { FlipImageHorizontally(pixelData, _width, _height, pixelFormat->BytesPerPixel); }
         if (_flipVertical)
-        { FlipImageVertically(pixelData, width, height, pixelFormat->BytesPerPixel); }
-
-        cbtTexture* texture = cbtTexture::Create2DTexture(_name, width, height, CBT_RGBA8, pixelData);
+        { FlipImageVertically(pixelData, _width, _height, pixelFormat->BytesPerPixel); }
+        _pixels.assign(pixelData, pixelData + (_width * _height * pixelFormat->BytesPerPixel));
 
         SDL_FreeFormat(pixelFormat);
-        SDL_FreeSurface(rawSurface);
         SDL_FreeSurface(convertedSurface);
 
+        return true;
+    }
+
+    cbtTexture* cbtTextureBuilder::Create2DTexture(const cbtStr& _name, const cbtStr& _filePath, cbtBool _flipVertical,
+            cbtBool _flipHorizontal)
+    {
+        cbtStr cacheKey = GetCacheKey(_filePath, _flipVertical, _flipHorizontal);
+        cbtTexture* texture = cbtRenderEngine::GetInstance()->GetCachedTexture(cacheKey);
+        if (texture)
+        { return texture; }
+
+        std::vector<cbtU8> pixels;
+        cbtS32 width, height;
+        if (!DecodeImage(_filePath, _flipVertical, _flipHorizontal, pixels, width, height))
+        { return nullptr; }
+
+        texture = cbtTexture::Create2DTexture(_name, width, height, CBT_RGBA8, &pixels[0]);
+        cbtRenderEngine::GetInstance()->CacheTexture(cacheKey, texture);
         return texture;
     }
 
@@ -38,43 +148,57 @@ NS_CBT_BEGIN
     cbtTextureBuilder::CreateCubeMap(const cbtStr& _name, std::array<cbtStr, CBT_CUBEMAP_MAX_SIDES> _filePath,
             cbtBool _flipVertical, cbtBool _flipHorizontal)
     {
-        SDL_PixelFormat* pixelFormat = SDL_AllocFormat(SDL_PIXELFORMAT_RGBA32);
-        SDL_Surface* rawSurface[CBT_CUBEMAP_MAX_SIDES];
-        SDL_Surface* convertedSurface[CBT_CUBEMAP_MAX_SIDES];
+        cbtStr cacheKey = GetCacheKey(_filePath, _flipVertical, _flipHorizontal);
+        cbtTexture* texture = cbtRenderEngine::GetInstance()->GetCachedTexture(cacheKey);
+        if (texture)
+        { return texture; }
 
+        std::vector<cbtU8> pixels[CBT_CUBEMAP_MAX_SIDES];
+        cbtS32 width, height;
         for (cbtU32 i = 0; i < CBT_CUBEMAP_MAX_SIDES; ++i)
         {
-            rawSurface[i] = IMG_Load(_filePath[i].c_str());
-            convertedSurface[i] = SDL_ConvertSurface(rawSurface[i], pixelFormat, 0);
-            CBT_ASSERT(convertedSurface[i]);
-
-            cbtS32 width = convertedSurface[i]->w;
-            cbtS32 height = convertedSurface[i]->h;
-            cbtU8* pixelData = static_cast<cbtU8*>(convertedSurface[i]->pixels);
-            if (_flipHorizontal)
-            { FlipImageHorizontally(pixelData, width, height, pixelFormat->BytesPerPixel); }
-            if (_flipVertical)
-            { FlipImageVertically(pixelData, width, height, pixelFormat->BytesPerPixel); }
+            if (!DecodeImage(_filePath[i], _flipVertical, _flipHorizontal, pixels[i], width, height))
+            { return nullptr; }
         }
 
-        cbtTexture* texture = cbtTexture::CreateCubeMap(_name, convertedSurface[0]->w, convertedSurface[0]->h,
-                CBT_RGBA8, {
-                        static_cast<cbtU8*>(convertedSurface[0]->pixels),
-                        static_cast<cbtU8*>(convertedSurface[1]->pixels),
-                        static_cast<cbtU8*>(convertedSurface[2]->pixels),
-                        static_cast<cbtU8*>(convertedSurface[3]->pixels),
-                        static_cast<cbtU8*>(convertedSurface[4]->pixels),
-                        static_cast<cbtU8*>(convertedSurface[5]->pixels)
-                });
+        texture = cbtTexture::CreateCubeMap(_name, width, height, CBT_RGBA8, {
+                &pixels[0][0], &pixels[1][0], &pixels[2][0],
+                &pixels[3][0], &pixels[4][0], &pixels[5][0]
+        });
+        cbtRenderEngine::GetInstance()->CacheTexture(cacheKey, texture);
+        return texture;
+    }
 
-        SDL_FreeFormat(pixelFormat);
-        for (cbtU32 i = 0; i < CBT_CUBEMAP_MAX_SIDES; ++i)
-        {
-            SDL_FreeSurface(rawSurface[i]);
-            SDL_FreeSurface(convertedSurface[i]);
-        }
+    cbtRef<cbtAssetRequest<cbtTexture>> cbtTextureBuilder::Create2DTextureAsync(const cbtStr& _name, const cbtStr& _filePath,
+            cbtBool _flipVertical, cbtBool _flipHorizontal)
+    {
+        cbtStr cacheKey = GetCacheKey(_filePath, _flipVertical, _flipHorizontal);
+        cbtTexture* texture = cbtRenderEngine::GetInstance()->GetCachedTexture(cacheKey);
+        if (texture)
+        { return cbtNew cbtResidentAssetRequest<cbtTexture>(texture); }
+        cbtAssetRequest<cbtTexture>* inFlight = cbtAssetLoader::GetInstance()->FindInFlight<cbtTexture>(cacheKey);
+        if (inFlight)
+        { return inFlight; }
+
+        cbtTexture2DRequest* request = cbtNew cbtTexture2DRequest(_name, _filePath, _flipVertical, _flipHorizontal);
+        cbtAssetLoader::GetInstance()->Submit(request, cacheKey);
+        return request;
+    }
 
-        return texture;
+    cbtRef<cbtAssetRequest<cbtTexture>> cbtTextureBuilder::CreateCubeMapAsync(const cbtStr& _name,
+            std::array<cbtStr, CBT_CUBEMAP_MAX_SIDES> _filePath, cbtBool _flipVertical, cbtBool _flipHorizontal)
+    {
+        cbtStr cacheKey = GetCacheKey(_filePath, _flipVertical, _flipHorizontal);
+        cbtTexture* texture = cbtRenderEngine::GetInstance()->GetCachedTexture(cacheKey);
+        if (texture)
+        { return cbtNew cbtResidentAssetRequest<cbtTexture>(texture); }
+        cbtAssetRequest<cbtTexture>* inFlight = cbtAssetLoader::GetInstance()->FindInFlight<cbtTexture>(cacheKey);
+        if (inFlight)
+        { return inFlight; }
+
+        cbtCubeMapRequest* request = cbtNew cbtCubeMapRequest(_name, _filePath, _flipVertical, _flipHorizontal);
+        cbtAssetLoader::GetInstance()->Submit(request, cacheKey);
+        return request;
     }
 
 NS_CBT_END
@@ -2,6 +2,7 @@
 #include "SDL_cbtWindow.h"
 #include "Debug/cbtDebug.h"
 #include "Rendering/Window/cbtWindowEvent.h"
+#include "Platform/EGL/Rendering/EGL_cbtWindow.h"
 
 #ifdef CBT_SDL
 
@@ -9,6 +10,15 @@ NS_CBT_BEGIN
 
     cbtWindow* cbtWindow::CreateCBTWindow(const cbtWindowProperties& _properties)
     {
+        if (_properties.IsHeadless())
+        {
+#ifdef CBT_EGL
+            return cbtNew EGL_cbtWindow(_properties);
+#else
+            CBT_LOG_ERROR(CBT_LOG_CATEGORY_RENDER, "Headless rendering requires building with CBT_EGL! Creating a window instead.");
+            CBT_ASSERT(false);
+#endif // CBT_EGL
+        }
         return cbtNew SDL_cbtWindow(_properties);
     }
 
@@ -82,9 +92,8 @@ NS_CBT_BEGIN
         m_Properties.m_Width = (cbtU32)winddowWidth;
         m_Properties.m_Height = (cbtU32)windowHeight;
 
-        // Send Event
-        cbtEvent* windowEvent = new cbtResizeWindowEvent(m_Properties);
-        m_EventDispatcher.DispatchEvent<cbtResizeWindowEvent>(windowEvent, true);
+        // Queue Event
+        m_EventDispatcher.QueueEvent<cbtResizeWindowEvent>(cbtResizeWindowEvent(m_Properties));
     }
 
     void SDL_cbtWindow::SwapBuffers()
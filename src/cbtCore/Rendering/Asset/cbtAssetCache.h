@@ -0,0 +1,148 @@
+#pragma once
+
+// Include CBT
+#include "cbtMacros.h"
+#include "Core/General/cbtRef.h"
+#include "Core/General/cbtIDLibrary.h"
+
+// Include STD
+#include <unordered_map>
+
+NS_CBT_BEGIN
+
+/**
+    \brief
+        Loaded assets of type T, keyed by how they were loaded, such as their file path or a hash of their contents, so that loading an asset again shares it.
+        The cache retains its assets, but Evict() releases every asset which nothing else holds a reference to.
+        An asset therefore only stays loaded while it is in use, and is loaded again if it is requested after that.
+*/
+    template<class T, class Key = cbtStr>
+    class cbtAssetCache
+    {
+    private:
+        struct Entry
+        {
+            T* m_Asset;
+            /// True if the asset was registered in a cbtIDLibrary when it was cached, so the library also holds a reference to it.
+            cbtBool m_Registered;
+        };
+
+        std::unordered_map<Key, Entry> m_Entries;
+
+        typename std::unordered_map<Key, Entry>::iterator Remove(typename std::unordered_map<Key, Entry>::iterator _iter,
+                cbtIDLibrary<T>* _library)
+        {
+            Entry& entry = _iter->second;
+            if (entry.m_Registered && _library->GetItem(entry.m_Asset->GetNameID()) == entry.m_Asset)
+            { _library->RemoveItem(entry.m_Asset->GetNameID()); }
+            entry.m_Asset->AutoRelease();
+            return m_Entries.erase(_iter);
+        }
+
+    public:
+        cbtAssetCache()
+        {
+        }
+
+        ~cbtAssetCache()
+        {
+            for (auto iter = m_Entries.begin(); iter != m_Entries.end(); ++iter)
+            { iter->second.m_Asset->AutoRelease(); }
+        }
+
+        inline cbtU32 GetCount() const { return (cbtU32)m_Entries.size(); }
+
+        /**
+            \brief Get a cached asset.
+
+            \param _key The key of the asset.
+
+            \return The asset, or nullptr if there is no asset cached with key _key.
+        */
+        T* Get(const Key& _key) const
+        {
+            auto iter = m_Entries.find(_key);
+            return iter == m_Entries.end() ? nullptr : iter->second.m_Asset;
+        }
+
+        /**
+            \brief Add an asset to the cache.
+
+            \param _key The key of the asset.
+            \param _asset The asset. It is retained by the cache.
+            \param _registered True if the asset has just been registered in the library later passed to Remove() and Evict().
+        */
+        void Add(const Key& _key, T* _asset, cbtBool _registered)
+        {
+            CBT_ASSERT(m_Entries.find(_key) == m_Entries.end());
+            _asset->Retain();
+            m_Entries.insert(std::pair<Key, Entry>(_key, { _asset, _registered }));
+        }
+
+        /**
+            \brief Remove an asset from the cache, and from _library if it was registered there when it was cached.
+
+            \param _key The key of the asset.
+            \param _library The library the asset may have been registered in.
+        */
+        void Remove(const Key& _key, cbtIDLibrary<T>* _library)
+        {
+            auto iter = m_Entries.find(_key);
+            if (iter != m_Entries.end())
+            { Remove(iter, _library); }
+        }
+
+        /**
+            \brief Remove every asset for which _predicate returns true.
+
+            \param _predicate Called with each cached asset.
+            \param _library The library the assets may have been registered in.
+
+            \return The number of assets removed.
+        */
+        template<class Predicate>
+        cbtU32 RemoveIf(Predicate _predicate, cbtIDLibrary<T>* _library)
+        {
+            cbtU32 removedCount = 0;
+            for (auto iter = m_Entries.begin(); iter != m_Entries.end();)
+            {
+                if (!_predicate(iter->second.m_Asset))
+                {
+                    ++iter;
+                    continue;
+                }
+                iter = Remove(iter, _library);
+                ++removedCount;
+            }
+            return removedCount;
+        }
+
+        /**
+            \brief
+                Remove every asset whose only references are the cache's, and _library's if it was registered there when it was cached.
+                References pending in a release pool count as in use, so a newly loaded asset is kept till its caller has had a chance to retain it.
+
+            \param _library The library the assets may have been registered in.
+
+            \return The number of assets removed.
+        */
+        cbtU32 Evict(cbtIDLibrary<T>* _library)
+        {
+            cbtU32 evictedCount = 0;
+            for (auto iter = m_Entries.begin(); iter != m_Entries.end();)
+            {
+                const Entry& entry = iter->second;
+                cbtBool registered = entry.m_Registered && _library->GetItem(entry.m_Asset->GetNameID()) == entry.m_Asset;
+                if (entry.m_Asset->GetRefCount() > (registered ? 2 : 1))
+                {
+                    ++iter;
+                    continue;
+                }
+                iter = Remove(iter, _library);
+                ++evictedCount;
+            }
+            return evictedCount;
+        }
+    };
+
+NS_CBT_END
\ No newline at end of file
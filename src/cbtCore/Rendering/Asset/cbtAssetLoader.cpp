@@ -0,0 +1,179 @@
+// Include CBT
+#include "cbtAssetLoader.h"
+#include "Core/Memory/cbtMemoryTracker.h"
+
+// Include STD
+#include <chrono>
+
+NS_CBT_BEGIN
+
+    cbtAssetLoader::cbtAssetLoader()
+    {
+        // Leave a core for the main thread.
+        cbtU32 workerCount = std::thread::hardware_concurrency();
+        workerCount = (workerCount > 1) ? (workerCount - 1) : 1;
+        for (cbtU32 i = 0; i < workerCount; ++i)
+        { m_Workers.push_back(std::thread(&cbtAssetLoader::WorkerLoop, this)); }
+    }
+
+    cbtAssetLoader::~cbtAssetLoader()
+    {
+        // Jobs that have not started decoding are dropped. Jobs that are being decoded are allowed to finish.
+        std::deque<cbtAssetJob*> undecoded;
+        {
+            std::lock_guard<std::mutex> decodeLock(m_DecodeMutex);
+            m_Stop = true;
+            undecoded.swap(m_DecodeQueue);
+        }
+        m_DecodeCondition.notify_all();
+        for (cbtU32 i = 0; i < m_Workers.size(); ++i)
+        { m_Workers[i].join(); }
+
+        // Nothing else is running now, so the remaining jobs can be cancelled without locking.
+        for (cbtU32 i = 0; i < undecoded.size(); ++i)
+        { Cancel(undecoded[i]); }
+        for (cbtU32 i = 0; i < m_UploadQueue.size(); ++i)
+        { Cancel(m_UploadQueue[i]); }
+        m_UploadQueue.clear();
+        for (cbtU32 i = 0; i < m_PollQueue.size(); ++i)
+        { Cancel(m_PollQueue[i]); }
+        m_PollQueue.clear();
+    }
+
+    void cbtAssetLoader::WorkerLoop()
+    {
+        CBT_MEMORY_TAG("Asset");
+        cbtProfiler::SetThreadName("Asset Worker");
+        while (true)
+        {
+            cbtAssetJob* job = nullptr;
+            {
+                std::unique_lock<std::mutex> decodeLock(m_DecodeMutex);
+                m_DecodeCondition.wait(decodeLock, [this]() { return m_Stop || !m_DecodeQueue.empty(); });
+                if (m_Stop)
+                { return; }
+                job = m_DecodeQueue.front();
+                m_DecodeQueue.pop_front();
+            }
+
+            CBT_REGION(ASSET_DECODE)
+                job->Decode();
+            CBT_END_REGION(ASSET_DECODE)
+
+            std::lock_guard<std::mutex> uploadLock(m_UploadMutex);
+            m_UploadQueue.push_back(job);
+        }
+    }
+
+    void cbtAssetLoader::Upload(cbtAssetJob* _job)
+    {
+        if (_job->HasFailed())
+        {
+            Cancel(_job);
+            return;
+        }
+
+        _job->Upload();
+        if (_job->Poll())
+        { Finish(_job); }
+        else
+        { m_PollQueue.push_back(_job); }
+    }
+
+    void cbtAssetLoader::Cancel(cbtAssetJob* _job)
+    {
+        _job->Cancel();
+        Finish(_job);
+    }
+
+    void cbtAssetLoader::Finish(cbtAssetJob* _job)
+    {
+        if (_job->m_KeyType != CBT_INVALID_TYPE_ID)
+        { m_InFlight[_job->m_KeyType].erase(_job->m_Key); }
+        --m_PendingCount;
+        _job->Release();
+    }
+
+    void cbtAssetLoader::SubmitJob(cbtAssetJob* _job, cbtS32 _keyType, const cbtStr& _key)
+    {
+        CBT_ASSERT(_job != nullptr);
+
+        // Retain the job here on the main thread, so that the worker threads never need to touch the reference count.
+        _job->Retain();
+        ++m_PendingCount;
+        if (_keyType != CBT_INVALID_TYPE_ID)
+        {
+            if ((cbtU32)_keyType >= m_InFlight.size())
+            { m_InFlight.resize(_keyType + 1); }
+            CBT_ASSERT(m_InFlight[_keyType].find(_key) == m_InFlight[_keyType].end());
+            _job->m_Key = _key;
+            _job->m_KeyType = _keyType;
+            m_InFlight[_keyType].insert(std::pair<cbtStr, cbtAssetJob*>(_key, _job));
+        }
+        {
+            std::lock_guard<std::mutex> decodeLock(m_DecodeMutex);
+            m_DecodeQueue.push_back(_job);
+        }
+        m_DecodeCondition.notify_one();
+    }
+
+    void cbtAssetLoader::Update()
+    {
+        CBT_PROFILE_SCOPE("ASSET_UPLOAD");
+        // Polling is cheap, so every job waiting on the driver is polled regardless of the budget.
+        for (cbtU32 i = 0; i < m_PollQueue.size();)
+        {
+            cbtAssetJob* job = m_PollQueue[i];
+            if (job->Poll())
+            {
+                m_PollQueue[i] = m_PollQueue.back();
+                m_PollQueue.pop_back();
+                Finish(job);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+
+        auto startTime = std::chrono::steady_clock::now();
+        while (true)
+        {
+            cbtAssetJob* job = nullptr;
+            {
+                std::lock_guard<std::mutex> uploadLock(m_UploadMutex);
+                if (m_UploadQueue.empty())
+                { return; }
+                job = m_UploadQueue.front();
+                m_UploadQueue.pop_front();
+            }
+
+            Upload(job);
+
+            std::chrono::duration<cbtF32, std::milli> elapsedTime = std::chrono::steady_clock::now() - startTime;
+            if (elapsedTime.count() >= m_UploadBudget)
+            { return; }
+        }
+    }
+
+    cbtAssetJob* cbtAssetLoader::FindInFlight(cbtS32 _keyType, const cbtStr& _key)
+    {
+        if ((cbtU32)_keyType >= m_InFlight.size())
+        { return nullptr; }
+        auto iter = m_InFlight[_keyType].find(_key);
+        return iter == m_InFlight[_keyType].end() ? nullptr : iter->second;
+    }
+
+    void cbtAssetLoader::Flush()
+    {
+        cbtF32 uploadBudget = m_UploadBudget;
+        m_UploadBudget = 0.0f;
+        while (m_PendingCount > 0)
+        {
+            Update();
+            std::this_thread::yield();
+        }
+        m_UploadBudget = uploadBudget;
+    }
+
+NS_CBT_END
\ No newline at end of file
@@ -0,0 +1,344 @@
+#pragma once
+
+// Include CBT
+#include "cbtMacros.h"
+#include "Debug/cbtDebug.h"
+#include "Core/General/cbtRef.h"
+#include "Core/General/cbtFamily.h"
+#include "Core/General/cbtSingleton.h"
+
+// Include STD
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <unordered_map>
+
+NS_CBT_BEGIN
+
+    enum cbtAssetState
+    {
+        CBT_ASSET_STATE_LOADING,
+        CBT_ASSET_STATE_RESIDENT,
+        CBT_ASSET_STATE_FAILED,
+    };
+
+    /**
+        \brief
+            A unit of asynchronous asset loading.
+            Decode() is run on a worker thread and should only do CPU work such as file I/O, image decoding and parsing.
+            Upload() is run on the main thread by cbtAssetLoader::Update(), and is where the GPU resource is created.
+            If the GPU resource is still being processed by the driver after Upload(), such as a shader program being linked in the background,
+            Poll() is called on the main thread each Update() till it returns true.
+            A job is retained by the cbtAssetLoader from the moment it is submitted till it has been uploaded or cancelled.
+
+        \warning Decode() must not touch any cbtManaged reference counts or GPU state.
+    */
+    class cbtAssetJob : public cbtManaged
+    {
+        friend class cbtAssetLoader;
+
+    protected:
+        /// The loading state of the job. Only read or written on the main thread, except by Decode() to signal failure.
+        cbtAssetState m_State = CBT_ASSET_STATE_LOADING;
+        /// The key used to find this job while it is in flight. Empty if the job cannot be shared.
+        cbtStr m_Key;
+        /// The cbtFamily<cbtAssetJob> ID of the request type the job was submitted as, which selects the in-flight map m_Key is in.
+        cbtS32 m_KeyType = CBT_INVALID_TYPE_ID;
+
+        cbtAssetJob()
+        {
+        }
+
+        virtual ~cbtAssetJob()
+        {
+        }
+
+        /**
+            \brief Load and decode the asset's data. Called on a worker thread.
+        */
+        virtual void Decode() = 0;
+
+        /**
+            \brief Create the GPU resource from the decoded data. Called on the main thread.
+        */
+        virtual void Upload() = 0;
+
+        /**
+            \brief Check whether the GPU resource created by Upload() is ready. Called on the main thread. Must not block.
+
+            \return Returns true if the job is complete. Otherwise, returns false and the job is polled again next Update().
+        */
+        virtual cbtBool Poll()
+        {
+            return true;
+        }
+
+        /**
+            \brief Called on the main thread instead of Upload() if decoding failed or the cbtAssetLoader is shutting down.
+        */
+        virtual void Cancel()
+        {
+            m_State = CBT_ASSET_STATE_FAILED;
+        }
+
+    public:
+        inline cbtAssetState GetState() const
+        {
+            return m_State;
+        }
+
+        inline cbtBool IsResident() const
+        {
+            return m_State == CBT_ASSET_STATE_RESIDENT;
+        }
+
+        inline cbtBool HasFailed() const
+        {
+            return m_State == CBT_ASSET_STATE_FAILED;
+        }
+
+        inline const cbtStr& GetKey() const
+        {
+            return m_Key;
+        }
+    };
+
+    /**
+        \brief
+            A handle to an asset of type T which is being loaded asynchronously.
+            The asset is nullptr until it is resident. Callbacks registered using OnResident() are invoked on the main thread
+            as soon as the asset is resident, which makes it possible to keep rendering a material with its fallback
+            (no texture, or skipped while it has no mesh or shader) until the real resource is ready.
+            The builders return requests as a cbtRef, since the cbtAssetLoader releases a request once it is finished.
+            Keep the cbtRef to use the request after the current frame.
+    */
+    template<class T>
+    class cbtAssetRequest : public cbtAssetJob
+    {
+    protected:
+        /// The loaded asset.
+        cbtRef<T> m_Asset;
+        /// The callbacks to invoke once the asset is resident.
+        std::vector<std::function<void(T*)>> m_Callbacks;
+
+        cbtAssetRequest()
+        {
+        }
+
+        virtual ~cbtAssetRequest()
+        {
+        }
+
+        /**
+            \brief Set the loaded asset and invoke the registered callbacks. If _asset is nullptr, the request is marked as failed.
+
+            \param _asset The loaded asset.
+        */
+        void SetAsset(T* _asset)
+        {
+            m_Asset = _asset;
+            m_State = _asset ? CBT_ASSET_STATE_RESIDENT : CBT_ASSET_STATE_FAILED;
+            if (_asset)
+            {
+                for (cbtU32 i = 0; i < m_Callbacks.size(); ++i)
+                { m_Callbacks[i](_asset); }
+            }
+            m_Callbacks.clear();
+        }
+
+        virtual void Cancel()
+        {
+            cbtAssetJob::Cancel();
+            m_Callbacks.clear();
+        }
+
+    public:
+        inline const T* GetAsset() const
+        {
+            return m_Asset.GetRawPointer();
+        }
+
+        inline T* GetAsset()
+        {
+            return m_Asset.GetRawPointer();
+        }
+
+        /**
+            \brief Register a callback to be invoked on the main thread once the asset is resident. If it is already resident, the callback is invoked immediately.
+
+            \param _callback The callback to invoke.
+
+            \return This cbtAssetRequest, so that calls can be chained.
+        */
+        cbtAssetRequest<T>* OnResident(std::function<void(T*)> _callback)
+        {
+            if (IsResident())
+            { _callback(GetAsset()); }
+            else if (!HasFailed())
+            { m_Callbacks.push_back(_callback); }
+            return this;
+        }
+    };
+
+    /**
+        \brief A cbtAssetRequest for an asset which is already resident, such as one found in a cache. It is never submitted to the cbtAssetLoader.
+    */
+    template<class T>
+    class cbtResidentAssetRequest : public cbtAssetRequest<T>
+    {
+    protected:
+        virtual ~cbtResidentAssetRequest()
+        {
+        }
+
+        virtual void Decode()
+        {
+        }
+
+        virtual void Upload()
+        {
+        }
+
+    public:
+        cbtResidentAssetRequest(T* _asset)
+        {
+            this->SetAsset(_asset);
+        }
+    };
+
+    /**
+        \brief
+            Loads assets asynchronously.
+            Jobs are decoded on a pool of worker threads, then placed in an upload queue which is drained on the main thread by Update().
+            Update() stops uploading once the per-frame upload budget has been exceeded, so that a large batch of assets does not stall a single frame.
+            At least one job is uploaded each call to guarantee forward progress.
+    */
+    class cbtAssetLoader : public cbtSingleton<cbtAssetLoader>
+    {
+        friend class cbtSingleton<cbtAssetLoader>;
+
+    private:
+        /// The worker threads.
+        std::vector<std::thread> m_Workers;
+
+        /// Jobs waiting to be decoded.
+        std::deque<cbtAssetJob*> m_DecodeQueue;
+        /// Mutex for m_DecodeQueue and m_Stop.
+        std::mutex m_DecodeMutex;
+        /// Wakes the workers when there is a job to decode or when they should stop.
+        std::condition_variable m_DecodeCondition;
+        /// Set when the workers should stop.
+        cbtBool m_Stop = false;
+
+        /// Jobs waiting to be uploaded.
+        std::deque<cbtAssetJob*> m_UploadQueue;
+        /// Mutex for m_UploadQueue.
+        std::mutex m_UploadMutex;
+
+        /// Jobs which have been uploaded but are still being polled. Only accessed on the main thread.
+        std::vector<cbtAssetJob*> m_PollQueue;
+
+        /**
+            Jobs which have been submitted with a key and not yet uploaded or cancelled, indexed by the cbtFamily<cbtAssetJob> ID of their request type.
+            Each asset type has its own map, so that the same key used by two asset types can never be found as the wrong type. Only accessed on the main thread.
+        */
+        std::vector<std::unordered_map<cbtStr, cbtAssetJob*>> m_InFlight;
+
+        /// The number of jobs which have been submitted but not yet uploaded or cancelled. Only accessed on the main thread.
+        cbtU32 m_PendingCount = 0;
+        /// The maximum time, in milliseconds, spent uploading per call to Update().
+        cbtF32 m_UploadBudget = 4.0f;
+
+        cbtAssetLoader();
+
+        virtual ~cbtAssetLoader();
+
+        static cbtAssetLoader* CreateInstance()
+        {
+            return cbtNew cbtAssetLoader();
+        }
+
+        void WorkerLoop();
+
+        void Upload(cbtAssetJob* _job);
+
+        void Cancel(cbtAssetJob* _job);
+
+        void Finish(cbtAssetJob* _job);
+
+        void SubmitJob(cbtAssetJob* _job, cbtS32 _keyType, const cbtStr& _key);
+
+        cbtAssetJob* FindInFlight(cbtS32 _keyType, const cbtStr& _key);
+
+    public:
+        /**
+            \brief Submit a job to be decoded on a worker thread and uploaded on the main thread. Must be called on the main thread.
+
+            \param _job The job to submit.
+        */
+        void Submit(cbtAssetJob* _job)
+        {
+            SubmitJob(_job, CBT_INVALID_TYPE_ID, "");
+        }
+
+        /**
+            \brief Submit a request for an asset of type T, which can be found using FindInFlight<T>(_key) till it has been uploaded, so that duplicate requests can share it.
+
+            \param _request The request to submit.
+            \param _key The key of the request. It only needs to be unique among requests for assets of type T.
+        */
+        template<class T>
+        void Submit(cbtAssetRequest<T>* _request, const cbtStr& _key)
+        {
+            CBT_ASSERT(!_key.empty());
+            SubmitJob(_request, cbtFamily<cbtAssetJob>::GetID<cbtAssetRequest<T>>(), _key);
+        }
+
+        /**
+            \brief Find a request for an asset of type T which was submitted with a given key and has not yet been uploaded. Must be called on the main thread.
+
+            \param _key The key the request was submitted with.
+
+            \return The request if it is still in flight. Otherwise, returns nullptr.
+        */
+        template<class T>
+        cbtAssetRequest<T>* FindInFlight(const cbtStr& _key)
+        {
+            return static_cast<cbtAssetRequest<T>*>(FindInFlight(cbtFamily<cbtAssetJob>::GetID<cbtAssetRequest<T>>(), _key));
+        }
+
+        /**
+            \brief Poll uploaded jobs, then upload decoded jobs till the upload queue is empty or the upload budget is exceeded. Must be called on the main thread.
+        */
+        void Update();
+
+        /**
+            \brief Block till every submitted job has been uploaded and is complete. Must be called on the main thread.
+        */
+        void Flush();
+
+        inline cbtF32 GetUploadBudget() const
+        {
+            return m_UploadBudget;
+        }
+
+        inline void SetUploadBudget(cbtF32 _milliseconds)
+        {
+            m_UploadBudget = _milliseconds;
+        }
+
+        inline cbtU32 GetPendingCount() const
+        {
+            return m_PendingCount;
+        }
+
+        inline cbtU32 GetWorkerCount() const
+        {
+            return (cbtU32)m_Workers.size();
+        }
+    };
+
+NS_CBT_END
\ No newline at end of file
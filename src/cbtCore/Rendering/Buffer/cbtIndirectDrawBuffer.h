@@ -0,0 +1,119 @@
+#pragma once
+
+// Include CBT
+#include "Core/General/cbtRef.h"
+#include "Debug/cbtDebug.h"
+#include "Rendering/Mesh/cbtMesh.h"
+#include "Rendering/RenderEngine/cbtRenderAPI.h"
+
+NS_CBT_BEGIN
+
+/**
+    \brief
+        Persistently mapped buffers of mesh instances and cbtDrawElementsIndirectCommand, shared by every mesh.
+        Culling writes each visible instance straight into the buffer the GPU reads it from, and records a command for each draw,
+        so that meshes are drawn with cbtRenderAPI::MultiDrawElementsIndirect rather than by re-specifying their own instance buffers every frame.
+
+        Both buffers are split into FRAME_COUNT regions which are written in turn, one per frame,
+        so that the CPU never writes to a region the GPU may still be reading from.
+*/
+    class cbtIndirectDrawBuffer : public cbtManaged
+    {
+    public:
+        /// The number of frames whose instances and commands are kept in the buffers at once.
+        static constexpr cbtU32 FRAME_COUNT = 3;
+
+    protected:
+        /// The number of instances each region can hold.
+        const cbtU32 m_InstanceCapacity;
+        /// The number of commands each region can hold.
+        const cbtU32 m_CommandCapacity;
+        /// The region written to this frame.
+        cbtU32 m_Region;
+        /// The number of instances written to the region this frame.
+        cbtU32 m_InstanceCount;
+        /// The number of commands written to the region this frame.
+        cbtU32 m_CommandCount;
+        /// The mapped instance buffer, FRAME_COUNT * m_InstanceCapacity instances long.
+        cbtMeshInstance* m_Instances;
+        /// The mapped command buffer, FRAME_COUNT * m_CommandCapacity commands long.
+        cbtDrawElementsIndirectCommand* m_Commands;
+
+        virtual ~cbtIndirectDrawBuffer()
+        {
+        }
+
+    public:
+        cbtIndirectDrawBuffer(cbtU32 _instanceCapacity, cbtU32 _commandCapacity)
+                :m_InstanceCapacity(_instanceCapacity), m_CommandCapacity(_commandCapacity), m_Region(0), m_InstanceCount(0),
+                 m_CommandCount(0), m_Instances(nullptr), m_Commands(nullptr)
+        {
+        }
+
+        inline cbtU32 GetInstanceCapacity() const { return m_InstanceCapacity; }
+
+        inline cbtU32 GetCommandCapacity() const { return m_CommandCapacity; }
+
+        inline cbtU32 GetInstanceCount() const { return m_InstanceCount; }
+
+        inline cbtU32 GetCommandCount() const { return m_CommandCount; }
+
+        /**
+            \brief Start writing to the next region, waiting until the GPU has finished drawing the frame which last used it.
+        */
+        virtual void BeginFrame() = 0;
+
+        /**
+            \brief Mark the end of the draws which read from the current region. Call after the frame's last draw has been issued.
+        */
+        virtual void EndFrame() = 0;
+
+        /**
+            \brief Bind the command buffer as the one cbtRenderAPI::MultiDrawElementsIndirect reads from.
+        */
+        virtual void Bind() = 0;
+
+        /**
+            \brief
+                Make a mesh's instance attributes read from the instance buffer, so that it can draw the commands recorded for it.
+                Calling cbtMesh::SetInstanceData makes the mesh read from its own instance buffer again.
+
+            \param _mesh The mesh.
+        */
+        virtual void AttachInstances(cbtMesh* _mesh) = 0;
+
+        /**
+            \brief Start recording a draw. The instances of the draw are then written to the returned memory, and the draw is finished by EndCommand.
+
+            \param _maxInstanceCount The most instances the draw may have.
+
+            \return The memory to write the instances to, or nullptr if the region does not have space for the draw this frame.
+        */
+        cbtMeshInstance* BeginCommand(cbtU32 _maxInstanceCount)
+        {
+            if (m_CommandCount == m_CommandCapacity || _maxInstanceCount > m_InstanceCapacity - m_InstanceCount)
+            { return nullptr; }
+            return m_Instances + m_Region * m_InstanceCapacity + m_InstanceCount;
+        }
+
+        /**
+            \brief Finish recording the draw started by BeginCommand.
+
+            \param _indexCount The number of indices of the mesh to draw.
+            \param _instanceCount The number of instances written, which may be fewer than were reserved.
+
+            \return The index of the command, to pass to cbtRenderAPI::MultiDrawElementsIndirect.
+        */
+        cbtU32 EndCommand(cbtU32 _indexCount, cbtU32 _instanceCount)
+        {
+            CBT_ASSERT(m_CommandCount < m_CommandCapacity && _instanceCount <= m_InstanceCapacity - m_InstanceCount);
+            cbtU32 commandIndex = m_Region * m_CommandCapacity + m_CommandCount++;
+            m_Commands[commandIndex] = { _indexCount, _instanceCount, 0, 0, m_Region * m_InstanceCapacity + m_InstanceCount };
+            m_InstanceCount += _instanceCount;
+            return commandIndex;
+        }
+
+        static cbtIndirectDrawBuffer* CreateIndirectDrawBuffer(cbtU32 _instanceCapacity, cbtU32 _commandCapacity);
+    };
+
+NS_CBT_END
\ No newline at end of file
@@ -36,6 +36,13 @@ NS_CBT_BEGIN
 
         virtual void SetEBO(cbtElementBuffer* _ebo) = 0;
 
+        /**
+            \brief Make the attributes of a VBO read from the VBO again, after they were made to read from another buffer.
+
+            \param _index The index of the VBO.
+        */
+        virtual void ResetVBO(cbtU32 _index) = 0;
+
         inline cbtU32 GetVBOCount() const
         {
             return (cbtU32)m_VBOs.size();
@@ -12,6 +12,7 @@ NS_CBT_BEGIN
         m_ProjectionMode = _mode;
         SetNearPlane(m_NearPlane);
         SetFarPlane(m_FarPlane);
+        MarkChanged();
     }
 
     void cbtCamera::SetNearPlane(cbtF32 _value)
@@ -26,11 +27,13 @@ NS_CBT_BEGIN
             break;
         }
         SetFarPlane(m_FarPlane);
+        MarkChanged();
     }
 
     void cbtCamera::SetFarPlane(cbtF32 _value)
     {
         m_FarPlane = cbtMathUtil::Max<cbtF32>(m_NearPlane + 0.01f, _value);
+        MarkChanged();
     }
 
     cbtMatrix4F cbtCamera::GetProjectionMatrix() const
@@ -56,6 +59,7 @@ NS_CBT_BEGIN
         for (cbtU32 i = 0; i < m_PostProcessShaders.size(); ++i)
         { m_PostProcessShaders[i]->AutoRelease(); }
         m_PostProcessShaders.swap(shaders);
+        MarkChanged();
     }
 
 NS_CBT_END
\ No newline at end of file
@@ -36,6 +36,8 @@ NS_CBT_BEGIN
 
     class cbtCamera : public cbtComponent
     {
+        CBT_SLAB_ALLOCATED(cbtCamera)
+
     private:
         /// Projection Mode
         cbtProjectionMode m_ProjectionMode = cbtProjectionMode::PERSPECTIVE;
@@ -108,6 +110,7 @@ NS_CBT_BEGIN
         inline void SetAspectRatio(cbtF32 _aspectRatio)
         {
             m_AspectRatio = _aspectRatio;
+            MarkChanged();
         }
 
         inline cbtU8 GetDepth() const
@@ -118,6 +121,7 @@ NS_CBT_BEGIN
         inline void SetDepth(cbtU8 _depth)
         {
             m_Depth = cbtMathUtil::Min<cbtU8>(_depth, 15);
+            MarkChanged();
         }
 
         cbtMatrix4F GetProjectionMatrix() const;
@@ -131,6 +135,7 @@ NS_CBT_BEGIN
         inline void SetFOV(cbtF32 _fov)
         {
             m_FOV = cbtMathUtil::Clamp<cbtF32>(_fov, 1.0f, 89.0f);
+            MarkChanged();
         }
 
         // Orthographic
@@ -142,6 +147,7 @@ NS_CBT_BEGIN
         inline void SetOrthoSize(cbtF32 _orthoSize)
         {
             m_OrthoSize = _orthoSize;
+            MarkChanged();
         }
 
         // Viewport
@@ -153,6 +159,7 @@ NS_CBT_BEGIN
         inline void SetViewport(const cbtViewport& _viewport)
         {
             m_ViewPort = _viewport;
+            MarkChanged();
         }
 
         // Deferred Lighting Shader
@@ -169,6 +176,7 @@ NS_CBT_BEGIN
         void SetLightingShader(cbtShaderProgram* _shader)
         {
             m_LightingShader = _shader;
+            MarkChanged();
         }
 
         // Post Processing Shaders
@@ -193,6 +201,7 @@ NS_CBT_BEGIN
         inline void SetSkyboxColor(const cbtColor& _color)
         {
             m_SkyboxColor = _color;
+            MarkChanged();
         }
 
         inline const cbtTexture* GetSkyboxTexture() const
@@ -208,6 +217,7 @@ NS_CBT_BEGIN
         inline void SetSkyboxTexture(cbtTexture* _texture)
         {
             m_SkyboxTexture = _texture;
+            MarkChanged();
         }
 
         cbtShaderProgram* GetSkyboxShader()
@@ -223,6 +233,7 @@ NS_CBT_BEGIN
         void SetSkyboxShader(cbtShaderProgram* _shader)
         {
             m_SkyboxShader = _shader;
+            MarkChanged();
         }
     };
 
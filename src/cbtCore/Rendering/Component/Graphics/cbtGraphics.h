@@ -19,6 +19,8 @@ NS_CBT_BEGIN
 
     class cbtGraphics : public cbtComponent
     {
+        CBT_SLAB_ALLOCATED(cbtGraphics)
+
     private:
         // Variable(s)
         cbtRef<cbtMaterial> m_Material;
@@ -48,6 +50,7 @@ NS_CBT_BEGIN
         inline void SetMaterial(cbtMaterial* _material)
         {
             m_Material = _material;
+            MarkChanged();
         }
     };
 
@@ -16,6 +16,8 @@ NS_CBT_BEGIN
 
     class cbtLight : public cbtComponent
     {
+        CBT_SLAB_ALLOCATED(cbtLight)
+
     private:
         cbtLightMode m_Mode = cbtLightMode::CBT_LIGHT_POINT;
         cbtColor m_Color = cbtColor::WHITE;
@@ -54,6 +56,7 @@ NS_CBT_BEGIN
         inline void SetMode(cbtLightMode _type)
         {
             m_Mode = _type;
+            MarkChanged();
         }
 
         inline cbtColor GetColor() const
@@ -64,6 +67,7 @@ NS_CBT_BEGIN
         inline void SetColor(cbtColor _color)
         {
             m_Color = _color;
+            MarkChanged();
         }
 
         inline cbtF32 GetPower() const
@@ -74,6 +78,7 @@ NS_CBT_BEGIN
         inline void SetPower(cbtF32 _power)
         {
             m_Power = cbtMathUtil::Max<cbtF32>(0.0f, _power);
+            MarkChanged();
         }
 
         inline cbtF32 GetAttenuationConstant() const
@@ -84,6 +89,7 @@ NS_CBT_BEGIN
         inline void SetAttenuationConstant(cbtF32 _attenuation)
         {
             m_AttenuationConstant = cbtMathUtil::Max<cbtF32>(_attenuation, 0.0f);
+            MarkChanged();
         }
 
         inline cbtF32 GetAttenuationLinear() const
@@ -94,6 +100,7 @@ NS_CBT_BEGIN
         inline void SetAttenuationLinear(cbtF32 _attenuation)
         {
             m_AttenuationLinear = cbtMathUtil::Max<cbtF32>(_attenuation, 0.0f);
+            MarkChanged();
         }
 
         inline cbtF32 GetAttenuationQuadratic() const
@@ -104,6 +111,7 @@ NS_CBT_BEGIN
         inline void SetAttenuationQuadratic(cbtF32 _attenuation)
         {
             m_AttenuationQuadratic = cbtMathUtil::Max<cbtF32>(_attenuation, 0.0f);
+            MarkChanged();
         }
 
         inline cbtF32 GetSpotlightInnerConsine() const
@@ -119,6 +127,7 @@ NS_CBT_BEGIN
         inline void SetSpotlightInnerAngle(cbtF32 _angle)
         {
             m_SpotlightInnerAngle = cbtMathUtil::Clamp<cbtF32>(_angle, 1.0f, 89.0f);
+            MarkChanged();
         }
 
         inline cbtF32 GetSpotlightOuterConsine() const
@@ -134,6 +143,7 @@ NS_CBT_BEGIN
         inline void SetSpotlightOuterAngle(cbtF32 _angle)
         {
             m_SpotlightOuterAngle = cbtMathUtil::Clamp<cbtF32>(_angle, 1.0f, 89.0f);
+            MarkChanged();
         }
     };
 
@@ -2,6 +2,8 @@
 
 // Include CBT
 #include "Debug/cbtDebug.h"
+#include "Core/General/cbtStringID.h"
+#include "Core/Memory/cbtSlabAllocator.h"
 #include "Rendering/Mesh/cbtMesh.h"
 #include "Rendering/Texture/cbtTexture.h"
 #include "Rendering/Shader/cbtShaderProgram.h"
@@ -22,9 +24,13 @@ NS_CBT_BEGIN
 
     class cbtMaterial : public cbtManaged
     {
+        CBT_SLAB_ALLOCATED(cbtMaterial)
+
     protected:
         /// Material Name
         const cbtStr m_Name;
+        /// Material Name ID
+        const cbtStrID m_NameID;
 
         /// Ambient Color
         cbtColor m_AmbientColor = cbtColor(0.1f, 0.1f, 0.1f, 1.0f);
@@ -66,7 +72,7 @@ NS_CBT_BEGIN
 
     public:
         cbtMaterial(const cbtStr& _name)
-                :m_Name(_name)
+                :m_Name(_name), m_NameID(cbtStringTable::Intern(_name))
         {
         }
 
@@ -76,6 +82,11 @@ NS_CBT_BEGIN
             return m_Name;
         }
 
+        inline cbtStrID GetNameID() const
+        {
+            return m_NameID;
+        }
+
         inline cbtBool IsComplete() const
         {
             return (m_Mesh != nullptr) && (m_Shader != nullptr);
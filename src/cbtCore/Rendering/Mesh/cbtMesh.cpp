@@ -7,7 +7,7 @@ NS_CBT_BEGIN
 
     cbtMesh::cbtMesh(const cbtStr& _name, const cbtVertex _vertices[], cbtU32 _vertexCount, const cbtU32 _indices[],
             cbtU32 _indexCount)
-            :m_Name(_name), m_VertexCount(_vertexCount), m_IndexCount(_indexCount)
+            :m_Name(_name), m_NameID(cbtStringTable::Intern(_name)), m_VertexCount(_vertexCount), m_IndexCount(_indexCount)
     {
         // Copy Vertex Data
         m_Vertices = cbtNew cbtVertex[m_VertexCount];
@@ -103,6 +103,8 @@ NS_CBT_BEGIN
 
     void cbtMesh::SetInstanceData(cbtU32 _instanceCount, cbtMeshInstance* _instanceData)
     {
+        // The instances may have been read from a cbtIndirectDrawBuffer since they were last set.
+        m_VAO->ResetVBO(VertexBuffers::INSTANCE_DATA);
         m_VAO->GetVBOs()[VertexBuffers::INSTANCE_DATA]->SetData(_instanceCount * (cbtU32)sizeof(cbtMeshInstance),
                 _instanceData);
     }
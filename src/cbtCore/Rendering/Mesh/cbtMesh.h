@@ -4,6 +4,7 @@
 #include "cbtMacros.h"
 #include "cbtVertex.h"
 #include "Core/General/cbtRef.h"
+#include "Core/General/cbtStringID.h"
 #include "Core/Math/cbtBoundingBox.h"
 #include "Core/Math/cbtMatrix.h"
 #include "Rendering/Buffer/cbtVertexArray.h"
@@ -93,6 +94,8 @@ NS_CBT_BEGIN
     protected:
         /// The name of the Mesh.
         const cbtStr m_Name;
+        /// The interned name of the Mesh.
+        const cbtStrID m_NameID;
         /// Vertices
         cbtVertex* m_Vertices;
         /// Vertex Count
@@ -117,6 +120,11 @@ NS_CBT_BEGIN
             return m_Name;
         }
 
+        inline cbtStrID GetNameID() const
+        {
+            return m_NameID;
+        }
+
         inline const cbtBoundingBox& GetBoundingBox() const
         {
             return m_BoundingBox;
@@ -132,6 +140,11 @@ NS_CBT_BEGIN
             return m_IndexCount;
         }
 
+        inline cbtVertexArray* GetVAO()
+        {
+            return m_VAO;
+        }
+
         void SetInstanceData(cbtU32 _instanceCount, cbtMeshInstance* _instanceData);
 
         void Bind()
@@ -1,5 +1,6 @@
 // Include CBT
 #include "cbtMeshBuilder.h"
+#include "Rendering/RenderEngine/cbtRenderEngine.h"
 #include "Core/FileUtil/cbtFileUtil.h"
 #include "Core/Math/cbtMatrixUtil.h"
 
@@ -272,11 +273,79 @@ NS_CBT_BEGIN
         return cbtNew cbtMesh(_name, &vertices[0], 4, &indices[0], 6);
     }
 
+    class cbtMeshRequest : public cbtAssetRequest<cbtMesh>
+    {
+        friend class cbtMeshBuilder;
+
+    protected:
+        const cbtStr m_Name;
+        const cbtStr m_FilePath;
+        std::vector<cbtVertex> m_Vertices;
+        std::vector<cbtU32> m_Indices;
+
+        cbtMeshRequest(const cbtStr& _name, const cbtStr& _filePath)
+                :m_Name(_name), m_FilePath(_filePath)
+        {
+        }
+
+        virtual ~cbtMeshRequest()
+        {
+        }
+
+        virtual void Decode()
+        {
+            if (!cbtMeshBuilder::ParseOBJ(m_FilePath, m_Vertices, m_Indices))
+            { m_State = CBT_ASSET_STATE_FAILED; }
+        }
+
+        virtual void Upload()
+        {
+            cbtMesh* mesh = cbtNew cbtMesh(m_Name, &m_Vertices[0], (cbtU32)m_Vertices.size(), &m_Indices[0],
+                    (cbtU32)m_Indices.size());
+            cbtRenderEngine::GetInstance()->CacheMesh(m_Key, mesh);
+            SetAsset(mesh);
+            std::vector<cbtVertex>().swap(m_Vertices);
+            std::vector<cbtU32>().swap(m_Indices);
+        }
+    };
+
     cbtMesh* cbtMeshBuilder::LoadAsset(const cbtStr& _name, const cbtStr& _filePath)
     {
+        cbtMesh* mesh = cbtRenderEngine::GetInstance()->GetCachedMesh(_filePath);
+        if (mesh)
+        { return mesh; }
+
         // Vertex Data and Index Data
         std::vector<cbtVertex> vertices;
         std::vector<cbtU32> indices;
+        if (!ParseOBJ(_filePath, vertices, indices))
+        { return nullptr; }
+
+        // Create the mesh.
+        mesh = cbtNew cbtMesh(_name, &vertices[0], (cbtU32)vertices.size(), &indices[0], (cbtU32)indices.size());
+        cbtRenderEngine::GetInstance()->CacheMesh(_filePath, mesh);
+        return mesh;
+    }
+
+    cbtRef<cbtAssetRequest<cbtMesh>> cbtMeshBuilder::LoadAssetAsync(const cbtStr& _name, const cbtStr& _filePath)
+    {
+        cbtMesh* mesh = cbtRenderEngine::GetInstance()->GetCachedMesh(_filePath);
+        if (mesh)
+        { return cbtNew cbtResidentAssetRequest<cbtMesh>(mesh); }
+        cbtAssetRequest<cbtMesh>* inFlight = cbtAssetLoader::GetInstance()->FindInFlight<cbtMesh>(_filePath);
+        if (inFlight)
+        { return inFlight; }
+
+        cbtMeshRequest* request = cbtNew cbtMeshRequest(_name, _filePath);
+        cbtAssetLoader::GetInstance()->Submit(request, _filePath);
+        return request;
+    }
+
+    cbtBool cbtMeshBuilder::ParseOBJ(const cbtStr& _filePath, std::vector<cbtVertex>& _vertices,
+            std::vector<cbtU32>& _indices)
+    {
+        _vertices.clear();
+        _indices.clear();
 
         // Vertex Attribute(s)
         std::vector<cbtVector3F> positions;
@@ -336,7 +405,7 @@ NS_CBT_BEGIN
                             "Cannot load mesh [" + _filePath + "]. Make sure that the mesh is triangulated!";
                     CBT_LOG_ERROR(CBT_LOG_CATEGORY_RENDER, assertMessage.c_str());
                     CBT_ASSERT(false);
-                    return nullptr;
+                    return false;
                 }
 
                 // Add the Vertex.
@@ -348,28 +417,28 @@ NS_CBT_BEGIN
                     vertex.m_Normal = normals[normalIndices[i] - 1];
                     vertex.m_TexCoord = texCoords[texCoordIndices[i] - 1];
 
-                    vertices.push_back(vertex);
+                    _vertices.push_back(vertex);
                 }
             }
         }
 
         // Index the vertices. (This defeats the point of indexing, since vertex data is still repeated, but creating a proper solution is too troublesome for now.)
-        for (cbtU32 i = 0; i < vertices.size(); ++i)
+        for (cbtU32 i = 0; i < _vertices.size(); ++i)
         {
-            indices.push_back(i);
+            _indices.push_back(i);
         }
 
         // Set Tangents
-        for (cbtU32 i = 0; i < indices.size(); i += 3)
+        for (cbtU32 i = 0; i < _indices.size(); i += 3)
         {
             // This gives us 2 of the 3 edges.
             cbtMatrix<cbtF32, 3, 2> edges;
-            edges[0][0] = vertices[indices[i + 1]].m_Position.GetX() - vertices[indices[i]].m_Position.GetX();
-            edges[1][0] = vertices[indices[i + 1]].m_Position.GetY() - vertices[indices[i]].m_Position.GetY();
-            edges[2][0] = vertices[indices[i + 1]].m_Position.GetZ() - vertices[indices[i]].m_Position.GetZ();
-            edges[0][1] = vertices[indices[i + 2]].m_Position.GetX() - vertices[indices[i]].m_Position.GetX();
-            edges[1][1] = vertices[indices[i + 2]].m_Position.GetY() - vertices[indices[i]].m_Position.GetY();
-            edges[2][1] = vertices[indices[i + 2]].m_Position.GetZ() - vertices[indices[i]].m_Position.GetZ();
+            edges[0][0] = _vertices[_indices[i + 1]].m_Position.GetX() - _vertices[_indices[i]].m_Position.GetX();
+            edges[1][0] = _vertices[_indices[i + 1]].m_Position.GetY() - _vertices[_indices[i]].m_Position.GetY();
+            edges[2][0] = _vertices[_indices[i + 1]].m_Position.GetZ() - _vertices[_indices[i]].m_Position.GetZ();
+            edges[0][1] = _vertices[_indices[i + 2]].m_Position.GetX() - _vertices[_indices[i]].m_Position.GetX();
+            edges[1][1] = _vertices[_indices[i + 2]].m_Position.GetY() - _vertices[_indices[i]].m_Position.GetY();
+            edges[2][1] = _vertices[_indices[i + 2]].m_Position.GetZ() - _vertices[_indices[i]].m_Position.GetZ();
 
             // We have the length of 2 edges, and we know that each the edges can be represented by
             // some length of the tangent + some length of the bitangent.
@@ -379,26 +448,25 @@ NS_CBT_BEGIN
             // the ratio of the edge along the bitangent axis (also the same as the U axis for the texture coordinates) is V1 - V0.
             cbtMatrix<cbtF32, 2, 2> tangentToBitangentRatio;
             tangentToBitangentRatio[0][0] =
-                    vertices[indices[i + 1]].m_TexCoord.GetX() - vertices[indices[i]].m_TexCoord.GetX();
+                    _vertices[_indices[i + 1]].m_TexCoord.GetX() - _vertices[_indices[i]].m_TexCoord.GetX();
             tangentToBitangentRatio[1][0] =
-                    vertices[indices[i + 1]].m_TexCoord.GetY() - vertices[indices[i]].m_TexCoord.GetY();
+                    _vertices[_indices[i + 1]].m_TexCoord.GetY() - _vertices[_indices[i]].m_TexCoord.GetY();
             tangentToBitangentRatio[0][1] =
-                    vertices[indices[i + 2]].m_TexCoord.GetX() - vertices[indices[i]].m_TexCoord.GetX();
+                    _vertices[_indices[i + 2]].m_TexCoord.GetX() - _vertices[_indices[i]].m_TexCoord.GetX();
             tangentToBitangentRatio[1][1] =
-                    vertices[indices[i + 2]].m_TexCoord.GetY() - vertices[indices[i]].m_TexCoord.GetY();
+                    _vertices[_indices[i + 2]].m_TexCoord.GetY() - _vertices[_indices[i]].m_TexCoord.GetY();
 
             cbtMatrix<cbtF32, 3, 2> tangents = cbtMatrixUtil::GetInverseMatrix(tangentToBitangentRatio) * edges;
 
-            vertices[indices[i + 0]].m_Tangent += cbtVector3F(tangents[0][0], tangents[1][0], tangents[2][0]);
-            vertices[indices[i + 1]].m_Tangent += cbtVector3F(tangents[0][0], tangents[1][0], tangents[2][0]);
-            vertices[indices[i + 2]].m_Tangent += cbtVector3F(tangents[0][0], tangents[1][0], tangents[2][0]);
+            _vertices[_indices[i + 0]].m_Tangent += cbtVector3F(tangents[0][0], tangents[1][0], tangents[2][0]);
+            _vertices[_indices[i + 1]].m_Tangent += cbtVector3F(tangents[0][0], tangents[1][0], tangents[2][0]);
+            _vertices[_indices[i + 2]].m_Tangent += cbtVector3F(tangents[0][0], tangents[1][0], tangents[2][0]);
         }
 
-        for (cbtU32 i = 0; i < vertices.size(); ++i)
-        { Normalize(vertices[i].m_Tangent); }
+        for (cbtU32 i = 0; i < _vertices.size(); ++i)
+        { Normalize(_vertices[i].m_Tangent); }
 
-        // Create the mesh.
-        return cbtNew cbtMesh(_name, &vertices[0], (cbtU32)vertices.size(), &indices[0], (cbtU32)indices.size());
+        return !_vertices.empty();
     }
 
 NS_CBT_END
\ No newline at end of file
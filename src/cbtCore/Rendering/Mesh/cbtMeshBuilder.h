@@ -3,6 +3,10 @@
 // Include CBT
 #include "cbtMesh.h"
 #include "Core/General/cbtLibrary.h"
+#include "Rendering/Asset/cbtAssetLoader.h"
+
+// Include STD
+#include <vector>
 
 NS_CBT_BEGIN
 
@@ -30,7 +34,32 @@ NS_CBT_BEGIN
 
         static cbtMesh* CreateQuad(const cbtStr& _name);
 
+        /**
+            \brief Load a mesh from a .OBJ file. If the same file has already been loaded, the cached mesh is returned instead.
+
+            \return The mesh, or nullptr if the file could not be parsed.
+        */
         static cbtMesh* LoadAsset(const cbtStr& _name, const cbtStr& _filePath);
+
+        /**
+            \brief Load a mesh asynchronously. The file is parsed on a worker thread and uploaded on the main thread by cbtAssetLoader.
+            If the mesh is cached, or already being loaded, the existing mesh or request is shared.
+
+            \return A reference to a cbtAssetRequest, whose asset is nullptr till the mesh is resident.
+        */
+        static cbtRef<cbtAssetRequest<cbtMesh>> LoadAssetAsync(const cbtStr& _name, const cbtStr& _filePath);
+
+        /**
+            \brief Parse a triangulated .OBJ file into vertex and index data. This does not touch any GPU state and is safe to call on a worker thread.
+
+            \param _filePath The file path of the .OBJ file.
+            \param _vertices The parsed vertices, with tangents calculated.
+            \param _indices The parsed indices.
+
+            \return Returns true if the file was successfully parsed. Otherwise, returns false.
+        */
+        static cbtBool ParseOBJ(const cbtStr& _filePath, std::vector<cbtVertex>& _vertices,
+                std::vector<cbtU32>& _indices);
     };
 
 NS_CBT_END
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+
+// Include CBT
+#include "cbtMacros.h"
+
+NS_CBT_BEGIN
+
+/// Passed to cbtGPUProfiler::BeginZone for zones which do not belong to a camera.
+#define CBT_GPU_PROFILE_NO_CAMERA 0xFFFFFFFF
+/// Returned by cbtGPUProfiler::BeginZone for zones which are not being recorded.
+#define CBT_GPU_PROFILE_INVALID_ZONE 0xFFFFFFFF
+
+    /**
+        \brief
+            Times render passes on the GPU using timestamp queries.
+            Results are read back FRAME_LATENCY frames after they were issued, so reading them never stalls the pipeline.
+            They are reported to cbtProfiler as GPU zones, named "<Zone> (Camera <Index>)", and averaged with the CPU zones.
+            Only active while cbtProfiler is enabled and the driver supports timestamp queries.
+    */
+    class cbtGPUProfiler
+    {
+    public:
+        /// The number of frames between issuing a query and reading its result.
+        static constexpr cbtU32 FRAME_LATENCY = 4;
+
+    private:
+        /**
+            \brief Private Constructor. All functions should be static. No objects of this class should be created.
+        */
+        cbtGPUProfiler()
+        {
+        }
+
+        /**
+            \brief Private Destructor. All functions should be static. No objects of this class should be created.
+        */
+        ~cbtGPUProfiler()
+        {
+        }
+
+    public:
+        /**
+            \brief Read back the results of the frame issued FRAME_LATENCY frames ago, and start recording a new frame.
+        */
+        static void BeginFrame();
+
+        /**
+            \brief Open a zone.
+
+            \param _name The name of the zone. Must be a string literal or otherwise outlive the zone's results, as only the pointer is kept.
+            \param _camera The index of the camera being rendered, or CBT_GPU_PROFILE_NO_CAMERA.
+
+            \return The index of the zone, to be passed to EndZone(). CBT_GPU_PROFILE_INVALID_ZONE if the zone is not being recorded.
+        */
+        static cbtU32 BeginZone(const cbtS8* _name, cbtU32 _camera = CBT_GPU_PROFILE_NO_CAMERA);
+
+        /**
+            \brief Close a zone.
+
+            \param _zone The index returned by BeginZone().
+        */
+        static void EndZone(cbtU32 _zone);
+
+        /**
+            \brief Delete every query. Must be called before the context is destroyed.
+        */
+        static void Destroy();
+    };
+
+    /**
+        \brief Times a GPU zone from its creation to its destruction.
+    */
+    class cbtGPUProfileScope
+    {
+    private:
+        cbtU32 m_Zone;
+
+    public:
+        cbtGPUProfileScope(const cbtS8* _name, cbtU32 _camera = CBT_GPU_PROFILE_NO_CAMERA)
+                :m_Zone(cbtGPUProfiler::BeginZone(_name, _camera))
+        {
+        }
+
+        ~cbtGPUProfileScope()
+        {
+            cbtGPUProfiler::EndZone(m_Zone);
+        }
+
+        cbtGPUProfileScope(const cbtGPUProfileScope&) = delete;
+        cbtGPUProfileScope& operator=(const cbtGPUProfileScope&) = delete;
+    };
+
+NS_CBT_END
+
+/// Time the enclosing scope on the GPU as a zone named __NAME__, optionally for the camera of index __CAMERA__.
+#define CBT_GPU_PROFILE_SCOPE(__NAME__, ...) NS_CBT::cbtGPUProfileScope CBT_PROFILE_CONCAT(cbtGPUProfileScope, __LINE__)(__NAME__, ##__VA_ARGS__)
\ No newline at end of file
@@ -3,6 +3,9 @@
 // Include CBT
 #include "cbtMacros.h"
 
+// Include STD
+#include <vector>
+
 NS_CBT_BEGIN
 
     enum class cbtCompareFunc
@@ -29,6 +32,17 @@ NS_CBT_BEGIN
         INVERT,
     };
 
+    /// The parameters of one draw of cbtRenderAPI::MultiDrawElementsIndirect, laid out as the GPU reads them from the indirect draw buffer.
+    struct cbtDrawElementsIndirectCommand
+    {
+        cbtU32 m_Count;
+        cbtU32 m_InstanceCount;
+        cbtU32 m_FirstIndex;
+        cbtS32 m_BaseVertex;
+        /// The index of the draw's first instance in the bound instance buffer.
+        cbtU32 m_BaseInstance;
+    };
+
     class cbtRenderAPI
     {
     private:
@@ -55,6 +69,16 @@ NS_CBT_BEGIN
 
         static void DrawElementsInstanced(cbtU32 _numElements, cbtU32 _numInstances);
 
+        /**
+            \brief Draw with several cbtDrawElementsIndirectCommand read from the bound indirect draw buffer, in a single call.
+
+            \param _firstCommand The index of the first command in the indirect draw buffer.
+            \param _drawCount The number of consecutive commands to draw.
+
+            \sa cbtIndirectDrawBuffer
+        */
+        static void MultiDrawElementsIndirect(cbtU32 _firstCommand, cbtU32 _drawCount);
+
         static void SetViewPort(cbtS32 _bottomX, cbtS32 _bottomY, cbtS32 _width, cbtS32 _height);
 
         static void SetScissor(cbtS32 _bottomX, cbtS32 _bottomY, cbtS32 _width, cbtS32 _height);
@@ -66,6 +90,19 @@ NS_CBT_BEGIN
 
         static void
         SetStencilOp(cbtStencilOp _stencilFail, cbtStencilOp _stencilPassDepthFail, cbtStencilOp _stencilPassDepthPass);
+
+        /**
+            \brief
+                Wait for every queued command to finish, and read back a region of the default framebuffer.
+                A window's back buffer is undefined after it is swapped, so this is only reliable when rendering headless.
+
+            \param _bottomX The left of the region.
+            \param _bottomY The bottom of the region.
+            \param _width The width of the region.
+            \param _height The height of the region.
+            \param _pixels The pixels of the region, 4 bytes per pixel in RGBA order, starting from the bottom row.
+        */
+        static void ReadPixels(cbtS32 _bottomX, cbtS32 _bottomY, cbtS32 _width, cbtS32 _height, std::vector<cbtByte>& _pixels);
     };
 
 NS_CBT_END
\ No newline at end of file
@@ -4,11 +4,16 @@
 #include "cbtMacros.h"
 #include "Core/General/cbtSingleton.h"
 #include "Core/General/cbtLibrary.h"
+#include "Core/General/cbtIDLibrary.h"
+#include "Rendering/Asset/cbtAssetCache.h"
 #include "Rendering/Color/cbtColor.h"
 #include "Rendering/Window/cbtWindow.h"
 #include "cbtRenderAPI.h"
 #include "Rendering/Renderer/cbtRenderer.h"
 
+// Include STD
+#include <unordered_map>
+
 NS_CBT_BEGIN
 
     class cbtRenderEngine : public cbtSingleton<cbtRenderEngine>
@@ -16,10 +21,20 @@ NS_CBT_BEGIN
         friend class cbtSingleton<cbtRenderEngine>;
 
     protected:
-        cbtLibrary<cbtMaterial>* m_MaterialLibrary = nullptr;
-        cbtLibrary<cbtShaderProgram>* m_ShaderLibrary = nullptr;
-        cbtLibrary<cbtMesh>* m_MeshLibrary = nullptr;
-        cbtLibrary<cbtTexture>* m_TextureLibrary = nullptr;
+        /// Registered assets, keyed by their interned names.
+        cbtIDLibrary<cbtMaterial>* m_MaterialLibrary = nullptr;
+        cbtIDLibrary<cbtShaderProgram>* m_ShaderLibrary = nullptr;
+        cbtIDLibrary<cbtMesh>* m_MeshLibrary = nullptr;
+        cbtIDLibrary<cbtTexture>* m_TextureLibrary = nullptr;
+
+        /// Loaded shader programs, keyed by a hash of their sources.
+        cbtAssetCache<cbtShaderProgram, cbtU64>* m_ShaderCache = nullptr;
+        /// The cache keys of the shader programs loaded from each set of shader files, so a cached shader program can be found without reading its files.
+        std::unordered_map<cbtStr, cbtU64> m_ShaderCacheKeys;
+        /// Loaded meshes, keyed by their file path.
+        cbtAssetCache<cbtMesh>* m_MeshCache = nullptr;
+        /// Loaded textures, keyed by their file path(s) and load options.
+        cbtAssetCache<cbtTexture>* m_TextureCache = nullptr;
 
         cbtRenderEngine()
         {
@@ -31,47 +46,148 @@ NS_CBT_BEGIN
 
         static cbtRenderEngine* CreateInstance();
 
+        /**
+            \brief Add a loaded asset to a cache, and register it in its library if no other asset of the same name has been registered.
+
+            \param _cache The cache to add the asset to.
+            \param _library The library to register the asset in.
+            \param _key The cache key of the asset.
+            \param _asset The asset.
+        */
+        template<class T, class Key>
+        static void CacheAsset(cbtAssetCache<T, Key>* _cache, cbtIDLibrary<T>* _library, const Key& _key, T* _asset)
+        {
+            CBT_ASSERT(_cache && _library);
+            cbtBool registered = !_library->HasItem(_asset->GetNameID());
+            if (registered)
+            { _library->AddItem(_asset); }
+            else if (_library->GetItem(_asset->GetNameID()) != _asset)
+            {
+                CBT_LOG_WARN(CBT_LOG_CATEGORY_RENDER,
+                        "An asset named %s has already been registered. The asset was cached but not registered.",
+                        _asset->GetName().c_str());
+            }
+            _cache->Add(_key, _asset, registered);
+        }
+
     public:
-        inline const cbtLibrary<cbtMaterial>* GetMaterialLibrary() const
+        inline const cbtIDLibrary<cbtMaterial>* GetMaterialLibrary() const
         {
             return m_MaterialLibrary;
         }
 
-        inline cbtLibrary<cbtMaterial>* GetMaterialLibrary()
+        inline cbtIDLibrary<cbtMaterial>* GetMaterialLibrary()
         {
             return m_MaterialLibrary;
         }
 
-        inline const cbtLibrary<cbtShaderProgram>* GetShaderLibrary() const
+        inline const cbtIDLibrary<cbtShaderProgram>* GetShaderLibrary() const
         {
             return m_ShaderLibrary;
         }
 
-        inline cbtLibrary<cbtShaderProgram>* GetShaderLibrary()
+        inline cbtIDLibrary<cbtShaderProgram>* GetShaderLibrary()
         {
             return m_ShaderLibrary;
         }
 
-        inline const cbtLibrary<cbtMesh>* GetMeshLibrary() const
+        inline const cbtIDLibrary<cbtMesh>* GetMeshLibrary() const
         {
             return m_MeshLibrary;
         }
 
-        inline cbtLibrary<cbtMesh>* GetMeshLibrary()
+        inline cbtIDLibrary<cbtMesh>* GetMeshLibrary()
         {
             return m_MeshLibrary;
         }
 
-        inline const cbtLibrary<cbtTexture>* GetTextureLibrary() const
+        inline const cbtIDLibrary<cbtTexture>* GetTextureLibrary() const
         {
             return m_TextureLibrary;
         }
 
-        inline cbtLibrary<cbtTexture>* GetTextureLibrary()
+        inline cbtIDLibrary<cbtTexture>* GetTextureLibrary()
         {
             return m_TextureLibrary;
         }
 
+        /**
+            \brief
+                Release the cached assets which are no longer used by anything, and the shader programs which failed to link, unregistering them from their libraries.
+                This walks every cache, so it is not run every frame. cbtApplication runs it after a scene change, once the previous scene has been released.
+                It can also be called directly, such as after releasing a large group of assets. Assets whose last reference is still pending in a release pool are kept till a later call.
+        */
+        void EvictUnusedAssets()
+        {
+            m_ShaderCache->RemoveIf([](cbtShaderProgram* _shader) { return _shader->HasLinkFailed(); }, m_ShaderLibrary);
+            m_ShaderCache->Evict(m_ShaderLibrary);
+            m_MeshCache->Evict(m_MeshLibrary);
+            m_TextureCache->Evict(m_TextureLibrary);
+
+            // Forget the files of the shader programs which are no longer cached.
+            for (auto iter = m_ShaderCacheKeys.begin(); iter != m_ShaderCacheKeys.end();)
+            {
+                if (m_ShaderCache->Get(iter->second))
+                { ++iter; }
+                else
+                { iter = m_ShaderCacheKeys.erase(iter); }
+            }
+        }
+
+        inline cbtShaderProgram* GetCachedShader(cbtU64 _key)
+        {
+            return m_ShaderCache->Get(_key);
+        }
+
+        inline void CacheShader(cbtU64 _key, cbtShaderProgram* _shader)
+        {
+            CBT_ASSERT(!_shader->HasLinkFailed());
+            CacheAsset(m_ShaderCache, m_ShaderLibrary, _key, _shader);
+        }
+
+        inline void UncacheShader(cbtU64 _key)
+        {
+            m_ShaderCache->Remove(_key, m_ShaderLibrary);
+        }
+
+        /**
+            \brief Get the cache key of the shader program which was loaded from a set of shader files.
+
+            \param _filesKey The key of the shader files.
+
+            \return The cache key, or nullptr if no shader program has been loaded from these files.
+        */
+        inline const cbtU64* GetShaderCacheKey(const cbtStr& _filesKey) const
+        {
+            auto iter = m_ShaderCacheKeys.find(_filesKey);
+            return iter == m_ShaderCacheKeys.end() ? nullptr : &iter->second;
+        }
+
+        inline void SetShaderCacheKey(const cbtStr& _filesKey, cbtU64 _key)
+        {
+            m_ShaderCacheKeys[_filesKey] = _key;
+        }
+
+        inline cbtMesh* GetCachedMesh(const cbtStr& _key)
+        {
+            return m_MeshCache->Get(_key);
+        }
+
+        inline void CacheMesh(const cbtStr& _key, cbtMesh* _mesh)
+        {
+            CacheAsset(m_MeshCache, m_MeshLibrary, _key, _mesh);
+        }
+
+        inline cbtTexture* GetCachedTexture(const cbtStr& _key)
+        {
+            return m_TextureCache->Get(_key);
+        }
+
+        inline void CacheTexture(const cbtStr& _key, cbtTexture* _texture)
+        {
+            CacheAsset(m_TextureCache, m_TextureLibrary, _key, _texture);
+        }
+
         virtual const cbtWindow* GetWindow() const = 0;
 
         virtual cbtWindow* GetWindow() = 0;
@@ -4,6 +4,7 @@
 #include "Game/GameEngine/cbtGameEngine.h"
 #include "Rendering/RenderEngine/cbtRenderEngine.h"
 #include "Rendering/Mesh/cbtMeshBuilder.h"
+#include "Rendering/RenderEngine/cbtGPUProfiler.h"
 
 NS_CBT_BEGIN
 
@@ -149,6 +150,10 @@ NS_CBT_BEGIN
         m_FBuffer->Retain();
         m_PBuffer = CreatePBuffer(m_BufferWidth, m_BufferHeight);
         m_PBuffer->Retain();
+
+        m_IndirectDrawBuffer = cbtIndirectDrawBuffer::CreateIndirectDrawBuffer(CBT_INDIRECT_DRAW_MAX_INSTANCES,
+                CBT_INDIRECT_DRAW_MAX_COMMANDS);
+        m_IndirectDrawBuffer->Retain();
     }
 
     cbtRenderer::~cbtRenderer()
@@ -160,6 +165,8 @@ NS_CBT_BEGIN
         m_LBuffer->Release();
         m_FBuffer->Release();
         m_PBuffer->Release();
+
+        m_IndirectDrawBuffer->Release();
     }
 
     void cbtRenderer::Update()
@@ -295,6 +302,72 @@ NS_CBT_BEGIN
         return objects;
     }
 
+    void cbtRenderer::CullInstances(const std::unordered_map<cbtMaterial*, std::vector<cbtU32>>& _buckets,
+            const cbtMatrix4F& _viewMatrix, const cbtMatrix4F& _viewProjectionMatrix)
+    {
+        m_DrawBatches.clear();
+        m_OverflowInstances.clear();
+
+        cbtTransform** transformArray = m_Objects.GetArray<cbtTransform>();
+        for (std::unordered_map<cbtMaterial*, std::vector<cbtU32>>::const_iterator iter = _buckets.begin();
+             iter != _buckets.end(); ++iter)
+        {
+            cbtMaterial* material = iter->first;
+            const std::vector<cbtU32>& arrayIndices = iter->second;
+            cbtMesh* mesh = material->GetMesh();
+
+            // Write the instances straight into the indirect draw buffer, or keep them to upload to the mesh if the buffer is full.
+            DrawBatch batch;
+            batch.m_Material = material;
+            batch.m_InstanceCount = 0;
+            cbtMeshInstance* meshInstances = m_IndirectDrawBuffer->BeginCommand((cbtU32)arrayIndices.size());
+            batch.m_Indirect = (meshInstances != nullptr);
+            if (!batch.m_Indirect)
+            {
+                batch.m_First = (cbtU32)m_OverflowInstances.size();
+                m_OverflowInstances.resize(m_OverflowInstances.size() + arrayIndices.size());
+                meshInstances = &m_OverflowInstances[batch.m_First];
+            }
+
+            for (cbtU32 n = 0; n < (cbtU32)arrayIndices.size(); ++n)
+            {
+                cbtTransform* transform = transformArray[arrayIndices[n]];
+                cbtMatrix4F modelMatrix = transform->GetGlobalModelMatrix();
+
+                // Frustum Culling
+                if (InViewFrustum(_viewProjectionMatrix, modelMatrix, mesh->GetBoundingBox()))
+                {
+                    cbtMatrix4F modelViewMatrix = _viewMatrix * modelMatrix;
+                    cbtMatrix3F normalMatrix = cbtMatrixUtil::GetTransposeMatrix(
+                            cbtMatrixUtil::GetInverseMatrix(cbtMatrixUtil::GetMinorMatrix(modelViewMatrix, 3, 3)));
+                    meshInstances[batch.m_InstanceCount].SetModelViewMatrix(modelViewMatrix);
+                    meshInstances[batch.m_InstanceCount].SetNormalMatrix(normalMatrix);
+                    ++batch.m_InstanceCount;
+                }
+            }
+
+            if (batch.m_Indirect)
+            { batch.m_First = m_IndirectDrawBuffer->EndCommand(mesh->GetIndexCount(), batch.m_InstanceCount); }
+            m_DrawBatches.push_back(batch);
+        }
+    }
+
+    void cbtRenderer::DrawInstances(const DrawBatch& _batch)
+    {
+        cbtMesh* mesh = _batch.m_Material->GetMesh();
+        mesh->Bind();
+        if (_batch.m_Indirect)
+        {
+            m_IndirectDrawBuffer->AttachInstances(mesh);
+            cbtRenderAPI::MultiDrawElementsIndirect(_batch.m_First, 1);
+        }
+        else
+        {
+            mesh->SetInstanceData(_batch.m_InstanceCount, &m_OverflowInstances[_batch.m_First]);
+            cbtRenderAPI::DrawElementsInstanced(mesh->GetIndexCount(), _batch.m_InstanceCount);
+        }
+    }
+
     void cbtRenderer::RenderGPass(const cbtMatrix4F& _viewMatrix, const cbtMatrix4F& _projectionMatrix,
             const cbtMatrix4F& _viewProjectionMatrix, cbtCamera* _camCamera)
     {
@@ -304,12 +377,14 @@ NS_CBT_BEGIN
         cbtRenderAPI::SetStencilFunc(cbtCompareFunc::ALWAYS, CBT_STENCIL_OPAQUE);
         cbtRenderAPI::SetStencilOp(cbtStencilOp::KEEP, cbtStencilOp::KEEP, cbtStencilOp::REPLACE);
 
-        cbtTransform** transformArray = m_Objects.GetArray<cbtTransform>();
-        for (std::unordered_map<cbtMaterial*, std::vector<cbtU32>>::iterator iter = m_Deferred.begin();
-             iter != m_Deferred.end(); ++iter)
+        CullInstances(m_Deferred, _viewMatrix, _viewProjectionMatrix);
+        m_IndirectDrawBuffer->Bind();
+        for (cbtU32 i = 0; i < m_DrawBatches.size(); ++i)
         {
-            cbtMaterial* material = iter->first;
-            std::vector<cbtU32>& arrayIndices = iter->second;
+            const DrawBatch& batch = m_DrawBatches[i];
+            if (batch.m_InstanceCount == 0)
+            { continue; }
+            cbtMaterial* material = batch.m_Material;
 
             // Use the shader.
             cbtShaderProgram* shader = material->GetShader();
@@ -349,34 +424,8 @@ NS_CBT_BEGIN
             shader->SetUniform(CBT_U_NEAR_PLANE, _camCamera->GetNearPlane());
             shader->SetUniform(CBT_U_FAR_PLANE, _camCamera->GetFarPlane());
 
-            // Bind the mesh.
-            cbtMesh* mesh = material->GetMesh();
-            mesh->Bind();
-
-            // Set the mesh instance data.
-            cbtMeshInstance* meshInstances = cbtNew cbtMeshInstance[arrayIndices.size()];
-            cbtU32 numVisible = 0;
-            for (cbtU32 n = 0; n < (cbtU32)arrayIndices.size(); ++n)
-            {
-                cbtTransform* transform = transformArray[arrayIndices[n]];
-                cbtMatrix4F modelMatrix = transform->GetGlobalModelMatrix();
-                cbtMatrix4F modelViewMatrix = _viewMatrix * modelMatrix;
-                cbtMatrix3F normalMatrix = cbtMatrixUtil::GetTransposeMatrix(
-                        cbtMatrixUtil::GetInverseMatrix(cbtMatrixUtil::GetMinorMatrix(modelViewMatrix, 3, 3)));
-
-                // Frustum Culling
-                if (InViewFrustum(_viewProjectionMatrix, modelMatrix, mesh->GetBoundingBox()))
-                {
-                    meshInstances[numVisible].SetModelViewMatrix(modelViewMatrix);
-                    meshInstances[numVisible].SetNormalMatrix(normalMatrix);
-                    ++numVisible;
-                }
-            }
-            mesh->SetInstanceData(numVisible, meshInstances);
-            delete[] meshInstances;
-
-            // Draw Mesh
-            cbtRenderAPI::DrawElementsInstanced(mesh->GetIndexCount(), numVisible);
+            // Draw the visible instances.
+            DrawInstances(batch);
         }
 
         cbtRenderAPI::SetStencilOp(cbtStencilOp::KEEP, cbtStencilOp::KEEP, cbtStencilOp::KEEP);
@@ -495,11 +544,15 @@ NS_CBT_BEGIN
             cbtRenderAPI::SetStencilFunc(cbtCompareFunc::ALWAYS, CBT_STENCIL_OPAQUE);
             cbtRenderAPI::SetStencilOp(cbtStencilOp::KEEP, cbtStencilOp::KEEP, cbtStencilOp::REPLACE);
 
+            CullInstances(m_Forward, _viewMatrix, _viewProjectionMatrix);
+            m_IndirectDrawBuffer->Bind();
             cbtMaterial* previousMaterial = nullptr;
-            for (std::unordered_map<cbtMaterial*, std::vector<cbtU32>>::iterator iter = m_Forward.begin();
-                 iter != m_Forward.end(); ++iter)
+            for (cbtU32 n = 0; n < m_DrawBatches.size(); ++n)
             {
-                cbtMaterial* material = iter->first;
+                const DrawBatch& batch = m_DrawBatches[n];
+                if (batch.m_InstanceCount == 0)
+                { continue; }
+                cbtMaterial* material = batch.m_Material;
                 cbtShaderProgram* shader = material->GetShader();
 
                 if (previousMaterial != material)
@@ -577,34 +630,8 @@ NS_CBT_BEGIN
                     shader->SetUniform(CBT_U_ACTIVE_LIGHTS, activeLights);
                 }
 
-                // Bind the mesh.
-                cbtMesh* mesh = material->GetMesh();
-                mesh->Bind();
-
-                // Set the mesh instance data.
-                std::vector<cbtU32>& arrayIndices = iter->second;
-                cbtMeshInstance* meshInstances = cbtNew cbtMeshInstance[arrayIndices.size()];
-                cbtU32 numVisible = 0;
-                for (cbtU32 n = 0; n < (cbtU32)arrayIndices.size(); ++n)
-                {
-                    cbtTransform* transform = objectTransformArray[arrayIndices[n]];
-                    cbtMatrix4F modelMatrix = transform->GetGlobalModelMatrix();
-                    cbtMatrix4F modelViewMatrix = _viewMatrix * modelMatrix;
-                    cbtMatrix3F normalMatrix = cbtMatrixUtil::GetTransposeMatrix(
-                            cbtMatrixUtil::GetInverseMatrix(cbtMatrixUtil::GetMinorMatrix(modelViewMatrix, 3, 3)));
-
-                    if (InViewFrustum(_viewProjectionMatrix, modelMatrix, mesh->GetBoundingBox()))
-                    {
-                        meshInstances[numVisible].SetModelViewMatrix(modelViewMatrix);
-                        meshInstances[numVisible].SetNormalMatrix(normalMatrix);
-                        ++numVisible;
-                    }
-                }
-                mesh->SetInstanceData(numVisible, meshInstances);
-                delete[] meshInstances;
-
-                // Draw Mesh
-                cbtRenderAPI::DrawElementsInstanced(mesh->GetIndexCount(), numVisible);
+                // Draw the visible instances.
+                DrawInstances(batch);
             }
 
             cbtRenderAPI::SetStencilOp(cbtStencilOp::KEEP, cbtStencilOp::KEEP, cbtStencilOp::KEEP);
@@ -803,6 +830,10 @@ NS_CBT_BEGIN
 
     void cbtRenderer::Render()
     {
+        // Read back the GPU timings of an earlier frame before issuing this frame's queries.
+        cbtGPUProfiler::BeginFrame();
+        m_IndirectDrawBuffer->BeginFrame();
+
         SortRenderObjects();
 
         cbtCamera** cameraArray = m_Cameras.GetArray<cbtCamera>();
@@ -828,77 +859,106 @@ NS_CBT_BEGIN
             cbtS32 windowTopX = (cbtS32)(viewport.m_TopX * (cbtF32)m_WindowWidth);
             cbtS32 windowTopY = (cbtS32)(viewport.m_TopY * (cbtF32)m_WindowHeight);
 
-            cbtRenderAPI::SetScissorTest(true);
-            cbtRenderAPI::SetScissor(bufferBottomX, bufferBottomY, bufferTopX - bufferBottomX,
-                    bufferTopY - bufferBottomY);
-            cbtFrameBuffer::ClearAttachmentsAll(m_GBuffer);
-            cbtFrameBuffer::ClearAttachmentsAll(m_LBuffer);
-            cbtFrameBuffer::ClearAttachmentsAll(m_FBuffer);
-            cbtFrameBuffer::ClearAttachmentsAll(m_PBuffer);
-            cbtRenderAPI::SetScissorTest(false);
+            CBT_REGION(RENDER_CLEAR)
+                CBT_GPU_PROFILE_SCOPE("RENDER_CLEAR", i);
+                cbtRenderAPI::SetScissorTest(true);
+                cbtRenderAPI::SetScissor(bufferBottomX, bufferBottomY, bufferTopX - bufferBottomX,
+                        bufferTopY - bufferBottomY);
+                cbtFrameBuffer::ClearAttachmentsAll(m_GBuffer);
+                cbtFrameBuffer::ClearAttachmentsAll(m_LBuffer);
+                cbtFrameBuffer::ClearAttachmentsAll(m_FBuffer);
+                cbtFrameBuffer::ClearAttachmentsAll(m_PBuffer);
+                cbtRenderAPI::SetScissorTest(false);
+            CBT_END_REGION(RENDER_CLEAR)
 
             // Geometry Pass
-            cbtRenderAPI::SetViewPort(bufferBottomX, bufferBottomY, bufferTopX - bufferBottomX,
-                    bufferTopY - bufferBottomY);
-            m_GBuffer->SetDrawColorBuffersAll();
-            RenderGPass(viewMatrix, projectionMatrix, viewProjectionMatrix, camCamera);
+            CBT_REGION(RENDER_GPASS)
+                CBT_GPU_PROFILE_SCOPE("RENDER_GPASS", i);
+                cbtRenderAPI::SetViewPort(bufferBottomX, bufferBottomY, bufferTopX - bufferBottomX,
+                        bufferTopY - bufferBottomY);
+                m_GBuffer->SetDrawColorBuffersAll();
+                RenderGPass(viewMatrix, projectionMatrix, viewProjectionMatrix, camCamera);
+            CBT_END_REGION(RENDER_GPASS)
 
             // Light Pass
             cbtRenderAPI::SetViewPort(0, 0, m_BufferWidth, m_BufferHeight);
-            cbtFrameBuffer::Blit(m_GBuffer, m_LBuffer, false, true, true, bufferBottomX, bufferBottomY, bufferTopX,
-                    bufferTopY, bufferBottomX, bufferBottomY, bufferTopX,
-                    bufferTopY); // Copy GBuffer DEPTH_STENCIL
-            m_LBuffer->SetDrawColorBuffersAll();
-            RenderLPass(viewMatrix, projectionMatrix, camCamera, camTransform);
+            CBT_REGION(RENDER_LPASS_BLIT)
+                CBT_GPU_PROFILE_SCOPE("RENDER_LPASS_BLIT", i);
+                cbtFrameBuffer::Blit(m_GBuffer, m_LBuffer, false, true, true, bufferBottomX, bufferBottomY, bufferTopX,
+                        bufferTopY, bufferBottomX, bufferBottomY, bufferTopX,
+                        bufferTopY); // Copy GBuffer DEPTH_STENCIL
+            CBT_END_REGION(RENDER_LPASS_BLIT)
+
+            CBT_REGION(RENDER_LPASS)
+                CBT_GPU_PROFILE_SCOPE("RENDER_LPASS", i);
+                m_LBuffer->SetDrawColorBuffersAll();
+                RenderLPass(viewMatrix, projectionMatrix, camCamera, camTransform);
+            CBT_END_REGION(RENDER_LPASS)
 
             // Forward Pass
             cbtRenderAPI::SetViewPort(bufferBottomX, bufferBottomY, bufferTopX - bufferBottomX,
                     bufferTopY - bufferBottomY);
 
-            cbtFrameBuffer::Blit(m_GBuffer, m_FBuffer, false, true, true, bufferBottomX, bufferBottomY, bufferTopX,
-                    bufferTopY, bufferBottomX, bufferBottomY, bufferTopX,
-                    bufferTopY); // Copy GBuffer DEPTH_STENCIL
-
-            m_GBuffer->SetReadColorBuffer((cbtU32)cbtGBuffer::POSITION_CAMERA_SPACE);
-            m_FBuffer->SetDrawColorBuffer((cbtU32)cbtFBuffer::POSITION_CAMERA_SPACE);
-            cbtFrameBuffer::Blit(m_GBuffer, m_FBuffer, true, false, false, bufferBottomX, bufferBottomY, bufferTopX,
-                    bufferTopY, bufferBottomX, bufferBottomY, bufferTopX,
-                    bufferTopY); // Copy GBuffer POSITION_CAMERA_SPACE
-
-            m_GBuffer->SetReadColorBuffer((cbtU32)cbtGBuffer::NORMAL_CAMERA_SPACE);
-            m_FBuffer->SetDrawColorBuffer((cbtU32)cbtFBuffer::NORMAL_CAMERA_SPACE);
-            cbtFrameBuffer::Blit(m_GBuffer, m_FBuffer, true, false, false, bufferBottomX, bufferBottomY, bufferTopX,
-                    bufferTopY, bufferBottomX, bufferBottomY, bufferTopX,
-                    bufferTopY); // Copy GBuffer NORMAL_CAMERA_SPACE
-
-            m_LBuffer->SetReadColorBuffer((cbtU32)cbtLBuffer::COMPOSITE);
-            m_FBuffer->SetDrawColorBuffer((cbtU32)cbtFBuffer::COMPOSITE);
-            cbtFrameBuffer::Blit(m_LBuffer, m_FBuffer, true, false, false, bufferBottomX, bufferBottomY, bufferTopX,
-                    bufferTopY, bufferBottomX, bufferBottomY, bufferTopX,
-                    bufferTopY); // Copy LBuffer COMPOSITE
-
-            m_FBuffer->SetDrawColorBuffersAll();
-            RenderFPass(viewMatrix, projectionMatrix, viewProjectionMatrix, camCamera, camTransform);
+            CBT_REGION(RENDER_FPASS_BLIT)
+                CBT_GPU_PROFILE_SCOPE("RENDER_FPASS_BLIT", i);
+                cbtFrameBuffer::Blit(m_GBuffer, m_FBuffer, false, true, true, bufferBottomX, bufferBottomY, bufferTopX,
+                        bufferTopY, bufferBottomX, bufferBottomY, bufferTopX,
+                        bufferTopY); // Copy GBuffer DEPTH_STENCIL
+
+                m_GBuffer->SetReadColorBuffer((cbtU32)cbtGBuffer::POSITION_CAMERA_SPACE);
+                m_FBuffer->SetDrawColorBuffer((cbtU32)cbtFBuffer::POSITION_CAMERA_SPACE);
+                cbtFrameBuffer::Blit(m_GBuffer, m_FBuffer, true, false, false, bufferBottomX, bufferBottomY, bufferTopX,
+                        bufferTopY, bufferBottomX, bufferBottomY, bufferTopX,
+                        bufferTopY); // Copy GBuffer POSITION_CAMERA_SPACE
+
+                m_GBuffer->SetReadColorBuffer((cbtU32)cbtGBuffer::NORMAL_CAMERA_SPACE);
+                m_FBuffer->SetDrawColorBuffer((cbtU32)cbtFBuffer::NORMAL_CAMERA_SPACE);
+                cbtFrameBuffer::Blit(m_GBuffer, m_FBuffer, true, false, false, bufferBottomX, bufferBottomY, bufferTopX,
+                        bufferTopY, bufferBottomX, bufferBottomY, bufferTopX,
+                        bufferTopY); // Copy GBuffer NORMAL_CAMERA_SPACE
+
+                m_LBuffer->SetReadColorBuffer((cbtU32)cbtLBuffer::COMPOSITE);
+                m_FBuffer->SetDrawColorBuffer((cbtU32)cbtFBuffer::COMPOSITE);
+                cbtFrameBuffer::Blit(m_LBuffer, m_FBuffer, true, false, false, bufferBottomX, bufferBottomY, bufferTopX,
+                        bufferTopY, bufferBottomX, bufferBottomY, bufferTopX,
+                        bufferTopY); // Copy LBuffer COMPOSITE
+            CBT_END_REGION(RENDER_FPASS_BLIT)
+
+            CBT_REGION(RENDER_FPASS)
+                CBT_GPU_PROFILE_SCOPE("RENDER_FPASS", i);
+                m_FBuffer->SetDrawColorBuffersAll();
+                RenderFPass(viewMatrix, projectionMatrix, viewProjectionMatrix, camCamera, camTransform);
+            CBT_END_REGION(RENDER_FPASS)
 
             // Post Process Pass
             cbtRenderAPI::SetViewPort(0, 0, m_BufferWidth, m_BufferHeight);
 
-            m_FBuffer->SetReadColorBuffer((cbtU32)cbtFBuffer::COMPOSITE);
-            m_PBuffer->SetDrawColorBuffer((cbtU32)cbtPBuffer::COMPOSITE);
-            cbtFrameBuffer::Blit(m_FBuffer, m_PBuffer, true, false, false, bufferBottomX, bufferBottomY, bufferTopX,
-                    bufferTopY, bufferBottomX, bufferBottomY, bufferTopX,
-                    bufferTopY); // Copy LBuffer COMPOSITE
-
-            m_PBuffer->SetDrawColorBuffersAll();
-            RenderPPass(viewMatrix, projectionMatrix, viewProjectionMatrix, camCamera, camTransform);
+            CBT_REGION(RENDER_PPASS_BLIT)
+                CBT_GPU_PROFILE_SCOPE("RENDER_PPASS_BLIT", i);
+                m_FBuffer->SetReadColorBuffer((cbtU32)cbtFBuffer::COMPOSITE);
+                m_PBuffer->SetDrawColorBuffer((cbtU32)cbtPBuffer::COMPOSITE);
+                cbtFrameBuffer::Blit(m_FBuffer, m_PBuffer, true, false, false, bufferBottomX, bufferBottomY, bufferTopX,
+                        bufferTopY, bufferBottomX, bufferBottomY, bufferTopX,
+                        bufferTopY); // Copy LBuffer COMPOSITE
+            CBT_END_REGION(RENDER_PPASS_BLIT)
+
+            CBT_REGION(RENDER_PPASS)
+                CBT_GPU_PROFILE_SCOPE("RENDER_PPASS", i);
+                m_PBuffer->SetDrawColorBuffersAll();
+                RenderPPass(viewMatrix, projectionMatrix, viewProjectionMatrix, camCamera, camTransform);
+            CBT_END_REGION(RENDER_PPASS)
         }
 
         // Render To Screen
-        m_PBuffer->SetReadColorBuffer((cbtU32)cbtPBuffer::COMPOSITE);
-        cbtFrameBuffer::Blit(m_PBuffer, nullptr, true, false, false, 0, 0, m_BufferWidth, m_BufferHeight, 0, 0,
-                m_WindowWidth, m_WindowHeight);
+        CBT_REGION(RENDER_TO_SCREEN)
+            CBT_GPU_PROFILE_SCOPE("RENDER_TO_SCREEN");
+            m_PBuffer->SetReadColorBuffer((cbtU32)cbtPBuffer::COMPOSITE);
+            cbtFrameBuffer::Blit(m_PBuffer, nullptr, true, false, false, 0, 0, m_BufferWidth, m_BufferHeight, 0, 0,
+                    m_WindowWidth, m_WindowHeight);
+        CBT_END_REGION(RENDER_TO_SCREEN)
 
         ClearRenderObjects();
+        m_IndirectDrawBuffer->EndFrame();
 
         cbtRenderEngine::GetInstance()->GetWindow()->SwapBuffers();
 
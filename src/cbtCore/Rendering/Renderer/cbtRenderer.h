@@ -3,6 +3,7 @@
 // Include CBT
 #include "cbtMacros.h"
 #include "cbtRenderBuffer.h"
+#include "Rendering/Buffer/cbtIndirectDrawBuffer.h"
 #include "Core/Event/cbtEventListener.h"
 #include "Rendering/Shader/cbtShaderProgram.h"
 #include "Game/Component/Transform/cbtTransform.h"
@@ -18,9 +19,24 @@ NS_CBT_BEGIN
 // Stencil Value(s)
 #define CBT_STENCIL_OPAQUE 1
 
+// Indirect Draw Capacity, per frame. Draws which do not fit upload their instances to their own mesh instead.
+#define CBT_INDIRECT_DRAW_MAX_INSTANCES 16384
+#define CBT_INDIRECT_DRAW_MAX_COMMANDS 1024
+
     class cbtRenderer
     {
     private:
+        /// The visible instances of a material, culled by CullInstances and drawn by DrawInstances.
+        struct DrawBatch
+        {
+            cbtMaterial* m_Material;
+            cbtU32 m_InstanceCount;
+            /// True if the instances are in m_IndirectDrawBuffer, false if they are in m_OverflowInstances.
+            cbtBool m_Indirect;
+            /// The index of the draw command if m_Indirect is true, otherwise the index of the first instance in m_OverflowInstances.
+            cbtU32 m_First;
+        };
+
         cbtEventListener m_EventListener;
 
         cbtRef<cbtMesh> m_ScreenQuad;
@@ -42,21 +58,34 @@ NS_CBT_BEGIN
         std::unordered_map<cbtMaterial*, std::vector<cbtU32>> m_Forward;
         std::vector<cbtU32> m_Transparent;
 
-        static cbtBool InViewFrustum(const cbtMatrix4F& _viewProjectionMatrix, const cbtMatrix4F& _modelMatrix,
-                const cbtBoundingBox& _boundingBox);
-
-        static cbtF32
-        GetObjectDistanceToCamera(const cbtMatrix4F& _viewProjectionMatrix, const cbtMatrix4F& _modelMatrix,
-                const cbtBoundingBox& _boundingBox);
+        /// The instances and indirect draw commands of the opaque objects.
+        cbtIndirectDrawBuffer* m_IndirectDrawBuffer;
+        /// The draws of the pass being rendered, one per material.
+        std::vector<DrawBatch> m_DrawBatches;
+        /// The instances of the draws which did not fit in m_IndirectDrawBuffer.
+        std::vector<cbtMeshInstance> m_OverflowInstances;
 
         void SortRenderObjects();
 
         void ClearRenderObjects();
 
-        void DistanceMergeSort(cbtF32* _distanceArray, cbtU32* _indexArray, cbtU32 _numElements);
-
         std::vector<cbtU32> SortTransparentObjects(const cbtMatrix4F& _viewProjectionMatrix);
 
+        /**
+            \brief Cull the objects of each material, writing the visible instances and a draw command per material into m_IndirectDrawBuffer.
+
+            \param _buckets The indices of the objects to cull, grouped by material.
+            \param _viewMatrix The view matrix of the camera.
+            \param _viewProjectionMatrix The view projection matrix of the camera.
+        */
+        void CullInstances(const std::unordered_map<cbtMaterial*, std::vector<cbtU32>>& _buckets,
+                const cbtMatrix4F& _viewMatrix, const cbtMatrix4F& _viewProjectionMatrix);
+
+        /**
+            \brief Draw a batch culled by CullInstances. The batch's material must already be in use.
+        */
+        void DrawInstances(const DrawBatch& _batch);
+
         void RenderGPass(const cbtMatrix4F& _viewMatrix, const cbtMatrix4F& _projectionMatrix,
                 const cbtMatrix4F& _viewProjectionMatrix, cbtCamera* _camCamera);
 
@@ -72,6 +101,23 @@ NS_CBT_BEGIN
         void Render();
 
     public:
+        // These do not depend on any GPU state, so they are public for use by tools and benchmarks.
+        static cbtBool InViewFrustum(const cbtMatrix4F& _viewProjectionMatrix, const cbtMatrix4F& _modelMatrix,
+                const cbtBoundingBox& _boundingBox);
+
+        static cbtF32
+        GetObjectDistanceToCamera(const cbtMatrix4F& _viewProjectionMatrix, const cbtMatrix4F& _modelMatrix,
+                const cbtBoundingBox& _boundingBox);
+
+        /**
+            \brief Sort an array of distances from furthest to nearest, and an array of indices in the same order.
+
+            \param _distanceArray The distances to sort.
+            \param _indexArray The indices to sort along with the distances.
+            \param _numElements The number of elements in each array.
+        */
+        static void DistanceMergeSort(cbtF32* _distanceArray, cbtU32* _indexArray, cbtU32 _numElements);
+
         cbtRenderer();
 
         ~cbtRenderer();
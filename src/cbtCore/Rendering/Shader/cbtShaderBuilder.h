@@ -4,14 +4,20 @@
 #include "cbtShaderProgram.h"
 #include "Core/General/cbtLibrary.h"
 #include "Core/FileUtil/cbtFileUtil.h"
+#include "Rendering/Asset/cbtAssetLoader.h"
+#include "Rendering/RenderEngine/cbtRenderEngine.h"
 
 // Include STD
 #include <unordered_map>
+#include <vector>
+#include <functional>
 
 NS_CBT_BEGIN
 
     class cbtShaderBuilder
     {
+        friend class cbtShaderProgramRequest;
+
     private:
         cbtShaderBuilder()
         {
@@ -21,11 +27,112 @@ NS_CBT_BEGIN
         {
         }
 
+        /**
+            \brief
+                Get the key used to cache a shader program. Shader programs are cached by the contents of their sources, so identical programs loaded from different files are shared.
+                The key is the 64-bit FNV-1a hash of the sources which GL_cbtProgramBinaryCache also builds its keys from.
+
+            \param _vertexShaderSources The vertex shader sources.
+            \param _fragmentShaderSources The fragment shader sources.
+
+            \return The key used to cache a shader program.
+        */
+        static cbtU64 GetCacheKey(const std::vector<cbtStr>& _vertexShaderSources,
+                const std::vector<cbtStr>& _fragmentShaderSources)
+        {
+            return cbtShaderProgram::GetSourceKey(_vertexShaderSources, _fragmentShaderSources);
+        }
+
+        /**
+            \brief Get the key of a set of shader files. It is used to find a cached shader program without reading its files, and to share a shader program request while it is in flight.
+
+            \param _vertexShaderFiles The vertex shader file paths.
+            \param _fragmentShaderFiles The fragment shader file paths.
+
+            \return The key of the shader files.
+        */
+        static cbtStr GetRequestKey(const std::vector<cbtStr>& _vertexShaderFiles,
+                const std::vector<cbtStr>& _fragmentShaderFiles)
+        {
+            cbtStr filePaths = "Shader|";
+            for (cbtU32 i = 0; i < _vertexShaderFiles.size(); ++i)
+            { filePaths += _vertexShaderFiles[i] + ";"; }
+            filePaths += "|";
+            for (cbtU32 i = 0; i < _fragmentShaderFiles.size(); ++i)
+            { filePaths += _fragmentShaderFiles[i] + ";"; }
+            return filePaths;
+        }
+
+        /**
+            \brief Get a cached shader program, removing it from the cache instead if it has failed to link.
+
+            \param _cacheKey The cache key of the shader program.
+
+            \return The shader program, or nullptr if there is no usable shader program cached with key _cacheKey.
+        */
+        static cbtShaderProgram* GetCachedShaderProgram(cbtU64 _cacheKey)
+        {
+            cbtShaderProgram* shader = cbtRenderEngine::GetInstance()->GetCachedShader(_cacheKey);
+            if (shader && shader->HasLinkFailed())
+            {
+                cbtRenderEngine::GetInstance()->UncacheShader(_cacheKey);
+                return nullptr;
+            }
+            return shader;
+        }
+
+        /**
+            \brief Get the cached shader program which was loaded from a set of shader files, without reading them.
+
+            \param _requestKey The key of the shader files.
+
+            \return The shader program, or nullptr if there is no usable shader program cached for these files.
+        */
+        static cbtShaderProgram* GetCachedShaderProgramForFiles(const cbtStr& _requestKey)
+        {
+            const cbtU64* cacheKey = cbtRenderEngine::GetInstance()->GetShaderCacheKey(_requestKey);
+            return cacheKey ? GetCachedShaderProgram(*cacheKey) : nullptr;
+        }
+
+        /**
+            \brief
+                Find a cached shader program with the same sources, or compile and cache a new one.
+                The link status of a new shader program is not known till it has finished linking,
+                so if it fails to link it is removed from the cache by cbtRenderEngine once the failure is seen.
+
+            \return The shader program.
+        */
+        static cbtShaderProgram* GetOrCreateShaderProgram(const cbtStr& _name, cbtU64 _cacheKey,
+                const std::vector<cbtStr>& _vertexShaderSources, const std::vector<cbtStr>& _fragmentShaderSources)
+        {
+            cbtShaderProgram* shader = GetCachedShaderProgram(_cacheKey);
+            if (shader)
+            { return shader; }
+
+            shader = cbtShaderProgram::CreateShaderProgram(_name, _vertexShaderSources, _fragmentShaderSources);
+            cbtRenderEngine::GetInstance()->CacheShader(_cacheKey, shader);
+            return shader;
+        }
+
     public:
         // Shader Creation
+        /**
+            \brief
+                Create a shader program. If a shader program has already been created from the same files or with identical sources, the cached shader program is returned instead.
+                The files are only read if no shader program has been cached for them.
+                Only the compile and link are issued here, so creating every shader program for a scene up front lets the driver compile them in parallel.
+                The shader program blocks on first use if it has not finished linking. Use cbtShaderProgram::IsReady() to check without blocking.
+
+            \return The shader program.
+        */
         static cbtShaderProgram* CreateShaderProgram(const cbtStr& _name, std::vector<cbtStr> _vertexShaderFiles,
                 std::vector<cbtStr> _fragmentShaderFiles)
         {
+            cbtStr requestKey = GetRequestKey(_vertexShaderFiles, _fragmentShaderFiles);
+            cbtShaderProgram* shader = GetCachedShaderProgramForFiles(requestKey);
+            if (shader)
+            { return shader; }
+
             std::vector<cbtStr> vertexShaderSources, fragmentShaderSources;
             for (cbtU32 i = 0; i < _vertexShaderFiles.size(); ++i)
             {
@@ -35,8 +142,109 @@ NS_CBT_BEGIN
             {
                 fragmentShaderSources.push_back(cbtFileUtil::FileToString(_fragmentShaderFiles[i]));
             }
-            return cbtShaderProgram::CreateShaderProgram(_name, vertexShaderSources, fragmentShaderSources);
+            cbtU64 cacheKey = GetCacheKey(vertexShaderSources, fragmentShaderSources);
+            shader = GetOrCreateShaderProgram(_name, cacheKey, vertexShaderSources, fragmentShaderSources);
+            cbtRenderEngine::GetInstance()->SetShaderCacheKey(requestKey, cacheKey);
+            return shader;
         }
+
+        /**
+            \brief
+                Create a shader program asynchronously. The files are read on a worker thread, then the compile and link are issued on the main thread by cbtAssetLoader.
+                The request only becomes resident once the driver has finished linking, so loading continues while the driver compiles in the background.
+            If a shader program loaded from the same files or with identical sources is cached, or the same files are already being loaded, the existing shader program or request is shared.
+
+            \return A reference to a cbtAssetRequest, whose asset is nullptr till the shader program is resident.
+        */
+        static cbtRef<cbtAssetRequest<cbtShaderProgram>> CreateShaderProgramAsync(const cbtStr& _name,
+                std::vector<cbtStr> _vertexShaderFiles, std::vector<cbtStr> _fragmentShaderFiles);
     };
 
-NS_CBT_END 
\ No newline at end of file
+    class cbtShaderProgramRequest : public cbtAssetRequest<cbtShaderProgram>
+    {
+        friend class cbtShaderBuilder;
+
+    protected:
+        const cbtStr m_Name;
+        /// The key of the shader files.
+        const cbtStr m_RequestKey;
+        std::vector<cbtStr> m_VertexShaderFiles, m_FragmentShaderFiles;
+        std::vector<cbtStr> m_VertexShaderSources, m_FragmentShaderSources;
+        /// The cache key of the shader program.
+        cbtU64 m_CacheKey = 0;
+        /// The shader program while it is being linked.
+        cbtRef<cbtShaderProgram> m_ShaderProgram;
+
+        cbtShaderProgramRequest(const cbtStr& _name, const cbtStr& _requestKey,
+                const std::vector<cbtStr>& _vertexShaderFiles, const std::vector<cbtStr>& _fragmentShaderFiles)
+                :m_Name(_name), m_RequestKey(_requestKey), m_VertexShaderFiles(_vertexShaderFiles),
+                 m_FragmentShaderFiles(_fragmentShaderFiles)
+        {
+        }
+
+        virtual ~cbtShaderProgramRequest()
+        {
+        }
+
+        virtual void Decode()
+        {
+            for (cbtU32 i = 0; i < m_VertexShaderFiles.size(); ++i)
+            { m_VertexShaderSources.push_back(cbtFileUtil::FileToString(m_VertexShaderFiles[i])); }
+            for (cbtU32 i = 0; i < m_FragmentShaderFiles.size(); ++i)
+            { m_FragmentShaderSources.push_back(cbtFileUtil::FileToString(m_FragmentShaderFiles[i])); }
+        }
+
+        virtual void Upload()
+        {
+            // The shader program is only cached once it has linked, so that a shader program which failed to link is never shared.
+            m_CacheKey = cbtShaderBuilder::GetCacheKey(m_VertexShaderSources, m_FragmentShaderSources);
+            m_ShaderProgram = cbtShaderBuilder::GetCachedShaderProgram(m_CacheKey);
+            if (m_ShaderProgram.GetRawPointer() == nullptr)
+            {
+                m_ShaderProgram = cbtShaderProgram::CreateShaderProgram(m_Name, m_VertexShaderSources,
+                        m_FragmentShaderSources);
+            }
+            m_VertexShaderSources.clear();
+            m_FragmentShaderSources.clear();
+        }
+
+        virtual cbtBool Poll()
+        {
+            if (!m_ShaderProgram->IsReady())
+            { return false; }
+            if (m_ShaderProgram->HasLinkFailed())
+            {
+                CBT_LOG_WARN(CBT_LOG_CATEGORY_RENDER, "Shader program %s failed to link.", m_Name.c_str());
+                SetAsset(nullptr);
+            }
+            else
+            {
+                if (!cbtRenderEngine::GetInstance()->GetCachedShader(m_CacheKey))
+                { cbtRenderEngine::GetInstance()->CacheShader(m_CacheKey, m_ShaderProgram.GetRawPointer()); }
+                cbtRenderEngine::GetInstance()->SetShaderCacheKey(m_RequestKey, m_CacheKey);
+                SetAsset(m_ShaderProgram.GetRawPointer());
+            }
+            m_ShaderProgram = nullptr;
+            return true;
+        }
+    };
+
+    inline cbtRef<cbtAssetRequest<cbtShaderProgram>> cbtShaderBuilder::CreateShaderProgramAsync(const cbtStr& _name,
+            std::vector<cbtStr> _vertexShaderFiles, std::vector<cbtStr> _fragmentShaderFiles)
+    {
+        cbtStr requestKey = GetRequestKey(_vertexShaderFiles, _fragmentShaderFiles);
+        // A cached shader program which is still linking is left to a new request, which only becomes resident once it has linked.
+        cbtShaderProgram* shader = GetCachedShaderProgramForFiles(requestKey);
+        if (shader && shader->IsReady())
+        { return cbtNew cbtResidentAssetRequest<cbtShaderProgram>(shader); }
+        cbtAssetRequest<cbtShaderProgram>* inFlight = cbtAssetLoader::GetInstance()->FindInFlight<cbtShaderProgram>(requestKey);
+        if (inFlight)
+        { return inFlight; }
+
+        cbtShaderProgramRequest* request = cbtNew cbtShaderProgramRequest(_name, requestKey, _vertexShaderFiles,
+                _fragmentShaderFiles);
+        cbtAssetLoader::GetInstance()->Submit(request, requestKey);
+        return request;
+    }
+
+NS_CBT_END
\ No newline at end of file
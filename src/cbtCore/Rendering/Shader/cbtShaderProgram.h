@@ -7,6 +7,7 @@
 #include "Core/Math/cbtVector2.h"
 #include "Core/Math/cbtVector3.h"
 #include "Rendering/Color/cbtColor.h"
+#include "Core/General/cbtStringID.h"
 
 NS_CBT_BEGIN
 
@@ -94,6 +95,7 @@ NS_CBT_BEGIN
     {
     protected:
         const cbtStr m_Name;
+        const cbtStrID m_NameID;
 
         virtual ~cbtShaderProgram()
         {
@@ -101,16 +103,65 @@ NS_CBT_BEGIN
 
     public:
         cbtShaderProgram(const cbtStr& _name)
-                :m_Name(_name)
+                :m_Name(_name), m_NameID(cbtStringTable::Intern(_name))
         {
         }
 
+        /**
+            \brief Hash the sources of a shader program using 64-bit FNV-1a. Identical sources always have the same key, across runs and builds.
+
+            \param _vertexShaderSources The vertex shader sources.
+            \param _fragmentShaderSources The fragment shader sources.
+            \param _hash The hash to continue from. This allows other data to be hashed together with the sources.
+
+            \return The key of the sources.
+        */
+        static cbtU64 GetSourceKey(const std::vector<cbtStr>& _vertexShaderSources,
+                const std::vector<cbtStr>& _fragmentShaderSources, cbtU64 _hash = CBT_FNV_OFFSET_BASIS)
+        {
+            // Hash a separator after every source, and between the stages, so that {"ab", "c"} and {"a", "bc"} do not collide.
+            const cbtS8 separator = (cbtS8)0xFF;
+            for (cbtU32 i = 0; i < _vertexShaderSources.size(); ++i)
+            {
+                _hash = cbtHashFNV1a(_vertexShaderSources[i].data(), _vertexShaderSources[i].size(), _hash);
+                _hash = cbtHashFNV1a(&separator, 1, _hash);
+            }
+            _hash = cbtHashFNV1a(&separator, 1, _hash);
+            for (cbtU32 i = 0; i < _fragmentShaderSources.size(); ++i)
+            {
+                _hash = cbtHashFNV1a(_fragmentShaderSources[i].data(), _fragmentShaderSources[i].size(), _hash);
+                _hash = cbtHashFNV1a(&separator, 1, _hash);
+            }
+            return _hash;
+        }
+
         inline const cbtStr& GetName() const
         {
             return m_Name;
         }
 
-        /// Use Program
+        inline cbtStrID GetNameID() const
+        {
+            return m_NameID;
+        }
+
+        /**
+            \brief
+                Shader programs may be compiled and linked by the driver in the background after they are created.
+                Checks whether it has finished without blocking, if the driver supports doing so.
+
+            \return Returns true if the shader program has finished linking and is ready to use. Otherwise, returns false.
+        */
+        virtual cbtBool IsReady() = 0;
+
+        /**
+            \brief Checks whether the shader program has finished linking and failed to, without blocking. Shader programs which failed to link are not cached.
+
+            \return Returns true if the shader program has finished linking and failed to link. Otherwise, returns false.
+        */
+        virtual cbtBool HasLinkFailed() const = 0;
+
+        /// Use Program. If the shader program has not finished linking, this blocks till it has.
         virtual void UseProgram() = 0;
 
         // Texture
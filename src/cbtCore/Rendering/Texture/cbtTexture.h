@@ -4,6 +4,7 @@
 #include "cbtPixelFormat.h"
 #include "Debug/cbtDebug.h"
 #include "Core/General/cbtRef.h"
+#include "Core/General/cbtStringID.h"
 
 // Include STD
 #include <array>
@@ -47,6 +48,7 @@ NS_CBT_BEGIN
     protected:
         // Variable(s)
         const cbtStr m_Name;
+        const cbtStrID m_NameID;
         cbtTextureShape m_Shape;
         cbtS32 m_Width, m_Height;
         cbtPixelFormat m_PixelFormat;
@@ -54,7 +56,7 @@ NS_CBT_BEGIN
         // Constructor(s) & Destructor
         cbtTexture(const cbtStr& _name, cbtTextureShape _shape, cbtS32 _width, cbtS32 _height,
                 cbtPixelFormat _pixelFormat)
-                :m_Name(_name), m_Shape(_shape), m_Width(_width), m_Height(_height), m_PixelFormat(_pixelFormat)
+                :m_Name(_name), m_NameID(cbtStringTable::Intern(_name)), m_Shape(_shape), m_Width(_width), m_Height(_height), m_PixelFormat(_pixelFormat)
         {
         }
 
@@ -69,6 +71,11 @@ NS_CBT_BEGIN
             return m_Name;
         }
 
+        inline cbtStrID GetNameID() const
+        {
+            return m_NameID;
+        }
+
         inline cbtTextureShape GetShape() const
         {
             return m_Shape;
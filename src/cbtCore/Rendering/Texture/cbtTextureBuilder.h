@@ -2,11 +2,13 @@
 
 // Include CBT
 #include "Core/General/cbtLibrary.h"
+#include "Rendering/Asset/cbtAssetLoader.h"
 #include "cbtTexture.h"
 
 // Include STD
 #include <unordered_map>
 #include <array>
+#include <vector>
 #include <cstring>
 
 NS_CBT_BEGIN
@@ -94,6 +96,38 @@ NS_CBT_BEGIN
             delete[] rightPixel;
         }
 
+        /**
+            \brief Get the key used to cache a 2D texture.
+
+            \param _filePath The file path of the image.
+            \param _flipVertical Is the image flipped vertically.
+            \param _flipHorizontal Is the image flipped horizontally.
+
+            \return The key used to cache a 2D texture.
+        */
+        static cbtStr GetCacheKey(const cbtStr& _filePath, cbtBool _flipVertical, cbtBool _flipHorizontal)
+        {
+            return _filePath + (_flipVertical ? "|V" : "|") + (_flipHorizontal ? "H" : "");
+        }
+
+        /**
+            \brief Get the key used to cache a cube map.
+
+            \param _filePath The file paths of the images.
+            \param _flipVertical Are the images flipped vertically.
+            \param _flipHorizontal Are the images flipped horizontally.
+
+            \return The key used to cache a cube map.
+        */
+        static cbtStr GetCacheKey(const std::array<cbtStr, CBT_CUBEMAP_MAX_SIDES>& _filePath, cbtBool _flipVertical,
+                cbtBool _flipHorizontal)
+        {
+            cbtStr filePaths;
+            for (cbtU32 i = 0; i < CBT_CUBEMAP_MAX_SIDES; ++i)
+            { filePaths += _filePath[i] + ";"; }
+            return GetCacheKey(filePaths, _flipVertical, _flipHorizontal);
+        }
+
         /**
             \brief Private Constructor. All functions should be static. No objects of this class should be created.
         */
@@ -109,11 +143,55 @@ NS_CBT_BEGIN
         }
 
     public:
+        /**
+            \brief Load an image file into RGBA8 pixel data. This does not touch any GPU state and is safe to call on a worker thread.
+
+            \param _filePath The file path of the image.
+            \param _flipVertical Should the image be flipped vertically.
+            \param _flipHorizontal Should the image be flipped horizontally.
+            \param _pixels The decoded pixel data.
+            \param _width The horizontal resolution of the decoded image.
+            \param _height The vertical resolution of the decoded image.
+
+            \return Returns true if the image was successfully decoded. Otherwise, returns false.
+        */
+        static cbtBool DecodeImage(const cbtStr& _filePath, cbtBool _flipVertical, cbtBool _flipHorizontal,
+                std::vector<cbtU8>& _pixels, cbtS32& _width, cbtS32& _height);
+
+        /**
+            \brief Load a 2D texture. If the same file has already been loaded with the same options, the cached texture is returned instead.
+
+            \return The texture, or nullptr if the image could not be loaded.
+        */
         static cbtTexture* Create2DTexture(const cbtStr& _name, const cbtStr& _filePath, cbtBool _flipVertical = true,
                 cbtBool _flipHorizontal = false);
 
+        /**
+            \brief Load a cube map. If the same files have already been loaded with the same options, the cached cube map is returned instead.
+
+            \return The cube map, or nullptr if any of the images could not be loaded.
+        */
         static cbtTexture* CreateCubeMap(const cbtStr& _name, std::array<cbtStr, CBT_CUBEMAP_MAX_SIDES> _filePath,
                 cbtBool _flipVertical = false, cbtBool _flipHorizontal = true);
+
+        /**
+            \brief Load a 2D texture asynchronously. The image is decoded on a worker thread and uploaded on the main thread by cbtAssetLoader.
+            If the texture is cached, or already being loaded, the existing texture or request is shared.
+
+            \return A reference to a cbtAssetRequest, whose asset is nullptr till the texture is resident.
+        */
+        static cbtRef<cbtAssetRequest<cbtTexture>> Create2DTextureAsync(const cbtStr& _name, const cbtStr& _filePath,
+                cbtBool _flipVertical = true, cbtBool _flipHorizontal = false);
+
+        /**
+            \brief Load a cube map asynchronously. The images are decoded on a worker thread and uploaded on the main thread by cbtAssetLoader.
+            If the cube map is cached, or already being loaded, the existing cube map or request is shared.
+
+            \return A reference to a cbtAssetRequest, whose asset is nullptr till the cube map is resident.
+        */
+        static cbtRef<cbtAssetRequest<cbtTexture>> CreateCubeMapAsync(const cbtStr& _name,
+                std::array<cbtStr, CBT_CUBEMAP_MAX_SIDES> _filePath, cbtBool _flipVertical = false,
+                cbtBool _flipHorizontal = true);
     };
 
 NS_CBT_END
\ No newline at end of file
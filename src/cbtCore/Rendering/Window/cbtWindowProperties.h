@@ -10,6 +10,8 @@ NS_CBT_BEGIN
         CBT_WINDOW_NONE = 0,
         CBT_WINDOW_FULLSCREEN = 1,
         CBT_WINDOW_BORDERLESS = 2,
+        /// Render offscreen without creating a window or needing a display. Requires CBT_EGL.
+        CBT_WINDOW_HEADLESS = 4,
     };
 
     struct cbtWindowProperties
@@ -37,6 +39,11 @@ NS_CBT_BEGIN
         {
             return (m_Flags & CBT_WINDOW_BORDERLESS);
         }
+
+        inline cbtBool IsHeadless() const
+        {
+            return (m_Flags & CBT_WINDOW_HEADLESS);
+        }
     };
 
 NS_CBT_END
\ No newline at end of file
@@ -40,13 +40,38 @@ typedef std::string cbtStr;
 /// \brief Equivalent to writing using namespace NS_CBT
 #define USING_NS_CBT using namespace NS_CBT
 
-/// \brief Equivalent to writing {
-#define CBT_REGION(__REGION_NAME__) {
+/// \brief Equivalent to writing {, and times the region as a cbtProfiler zone named __REGION_NAME__ if the profiler is enabled.
+#define CBT_REGION(__REGION_NAME__) { CBT_PROFILE_SCOPE(#__REGION_NAME__);
 /// \brief Equivalent to writing }
 #define CBT_END_REGION(__REGION_NAME__) }
 
-/// \brief Keyword used when instantiating new objects. For now it is the same as typing the new keyword. But it is there just incase it changes in the future.
+#ifdef CBT_MEMORY_TRACKING
+NS_CBT_BEGIN
+    /// The call site of an allocation made using cbtNew, recorded by cbtMemoryTracker.
+    struct cbtAllocationSite
+    {
+        const cbtS8* m_File;
+        cbtS32 m_Line;
+    };
+NS_CBT_END
+
+void* operator new(size_t _size, const NS_CBT::cbtAllocationSite& _site);
+void* operator new[](size_t _size, const NS_CBT::cbtAllocationSite& _site);
+void operator delete(void* _block, const NS_CBT::cbtAllocationSite& _site) noexcept;
+void operator delete[](void* _block, const NS_CBT::cbtAllocationSite& _site) noexcept;
+#endif // CBT_MEMORY_TRACKING
+
+/**
+    \brief
+        Keyword used when instantiating new objects.
+        Classes which declare CBT_SLAB_ALLOCATED are allocated from a per-type cbtSlabAllocator through their class operator new.
+        If CBT_MEMORY_TRACKING is defined, the call site is passed to cbtMemoryTracker. Otherwise, it is the same as typing the new keyword.
+*/
+#ifdef CBT_MEMORY_TRACKING
+#define cbtNew new (NS_CBT::cbtAllocationSite{ __FILE__, __LINE__ })
+#else
 #define cbtNew new
+#endif
 
 /**
     \brief Converts a non cbtStr to a cbtStr.
@@ -271,4 +296,8 @@ cbtU32 CBTTemplateIndex()
 #define CBT_OPENGL
 // #define CBT_VULKAN
 #define CBT_SDL
-#define CBT_IRRKLANG
\ No newline at end of file
+#define CBT_IRRKLANG
+
+// Include CBT
+// Included last, as it depends on the definitions above. CBT_REGION expands to a cbtProfileScope.
+#include "Debug/cbtProfiler.h"
\ No newline at end of file
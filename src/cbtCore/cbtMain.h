@@ -35,6 +35,7 @@ int main(int argc, char** argv)
     // _CrtSetDbgFlag(_CRTDBG_LEAK_CHECK_DF);
 
     NS_CBT::cbtApplication* app = NS_CBT::cbtApplication::GetInstance();
+    app->ParseArguments(argc, argv);
     app->Run();
     NS_CBT::cbtApplication::Destroy();
 
@@ -15,50 +15,63 @@
 // Constructor(s) & Destructor
 GameScene::GameScene()
 {
-    cbtMaterial* floorMaterial = cbtNew cbtMaterial("Floor");
+    // Textures and meshes are loaded asynchronously. Materials render without them until they are resident.
+    cbtRef<cbtMaterial> floorMaterial = cbtNew cbtMaterial("Floor");
     floorMaterial->SetMesh(cbtMeshBuilder::CreateQuad("Floor"));
     floorMaterial->SetShader(
             cbtShaderBuilder::CreateShaderProgram("GPass", { "./../assets/shaders/GL/cbtGeometry.vert" },
                     { "./../assets/shaders/GL/cbtGPass.frag" }));
-    floorMaterial->SetTextureAlbedo(cbtTextureBuilder::Create2DTexture("Pavement Brick Albedo",
-            "./../assets/textures/Materials/Pavement/Pavement_Brick_001_Albedo_2048x2048.png"));
-    floorMaterial->SetTextureNormal(cbtTextureBuilder::Create2DTexture("Pavement Brick Normal",
-            "./../assets/textures/Materials/Pavement/Pavement_Brick_001_Normal_2048x2048.png"));
-    floorMaterial->SetTextureSpecular(cbtTextureBuilder::Create2DTexture("Pavement Brick Specular",
-            "./../assets/textures/Materials/Pavement/Pavement_Brick_001_Specular_2048x2048.png"));
-    floorMaterial->SetTextureGloss(cbtTextureBuilder::Create2DTexture("Pavement Brick Gloss",
-            "./../assets/textures/Materials/Pavement/Pavement_Brick_001_Gloss_2048x2048.png"));
-    floorMaterial->SetTextureDisplacement(cbtTextureBuilder::Create2DTexture("Pavement Brick Displacement",
-            "./../assets/textures/Materials/Pavement/Pavement_Brick_001_Displacement_2048x2048.png"));
+    cbtTextureBuilder::Create2DTextureAsync("Pavement Brick Albedo",
+            "./../assets/textures/Materials/Pavement/Pavement_Brick_001_Albedo_2048x2048.png")->OnResident(
+            [floorMaterial](cbtTexture* _texture) mutable { floorMaterial->SetTextureAlbedo(_texture); });
+    cbtTextureBuilder::Create2DTextureAsync("Pavement Brick Normal",
+            "./../assets/textures/Materials/Pavement/Pavement_Brick_001_Normal_2048x2048.png")->OnResident(
+            [floorMaterial](cbtTexture* _texture) mutable { floorMaterial->SetTextureNormal(_texture); });
+    cbtTextureBuilder::Create2DTextureAsync("Pavement Brick Specular",
+            "./../assets/textures/Materials/Pavement/Pavement_Brick_001_Specular_2048x2048.png")->OnResident(
+            [floorMaterial](cbtTexture* _texture) mutable { floorMaterial->SetTextureSpecular(_texture); });
+    cbtTextureBuilder::Create2DTextureAsync("Pavement Brick Gloss",
+            "./../assets/textures/Materials/Pavement/Pavement_Brick_001_Gloss_2048x2048.png")->OnResident(
+            [floorMaterial](cbtTexture* _texture) mutable { floorMaterial->SetTextureGloss(_texture); });
+    cbtTextureBuilder::Create2DTextureAsync("Pavement Brick Displacement",
+            "./../assets/textures/Materials/Pavement/Pavement_Brick_001_Displacement_2048x2048.png")->OnResident(
+            [floorMaterial](cbtTexture* _texture) mutable { floorMaterial->SetTextureDisplacement(_texture); });
     floorMaterial->SetTextureScale(cbtVector2F(100.0f, 100.0f));
 
-    cbtMaterial* cubeMaterial = cbtNew cbtMaterial("Cube");
-    cubeMaterial->SetMesh(cbtMeshBuilder::LoadAsset("Cube", "./../assets/models/OBJ/Cube.obj"));
+    cbtRef<cbtMaterial> cubeMaterial = cbtNew cbtMaterial("Cube");
+    cbtMeshBuilder::LoadAssetAsync("Cube", "./../assets/models/OBJ/Cube.obj")->OnResident(
+            [cubeMaterial](cbtMesh* _mesh) mutable { cubeMaterial->SetMesh(_mesh); });
     // cubeMaterial->SetRenderMode(NS_CBT::CBT_RENDER_MODE_FORWARD);
     // cubeMaterial->SetShader(cbtShaderBuilder::CreateShaderProgram("FPass", { "./../assets/shaders/GL/cbtGeometry.vert" }, { "./../assets/shaders/GL/cbtFPass.frag"}));
     cubeMaterial->SetShader(
             cbtShaderBuilder::CreateShaderProgram("GPass", { "./../assets/shaders/GL/cbtGeometry.vert" },
                     { "./../assets/shaders/GL/cbtGPass.frag" }));
-    cubeMaterial->SetTextureAlbedo(cbtTextureBuilder::Create2DTexture("Tiles Albedo",
-            "./../assets/textures/Materials/Tiles/Tiles_001_Albedo_2048x2048.png"));
-    cubeMaterial->SetTextureNormal(cbtTextureBuilder::Create2DTexture("Tiles Normal",
-            "./../assets/textures/Materials/Tiles/Tiles_001_Normal_2048x2048.png"));
-    cubeMaterial->SetTextureSpecular(cbtTextureBuilder::Create2DTexture("Tiles Specular",
-            "./../assets/textures/Materials/Tiles/Tiles_001_Specular_2048x2048.png"));
-    cubeMaterial->SetTextureGloss(cbtTextureBuilder::Create2DTexture("Tiles Gloss",
-            "./../assets/textures/Materials/Tiles/Tiles_001_Gloss_2048x2048.png"));
-    cubeMaterial->SetTextureDisplacement(cbtTextureBuilder::Create2DTexture("Tiles Displacement",
-            "./../assets/textures/Materials/Tiles/Tiles_001_Displacement_2048x2048.png"));
+    cbtTextureBuilder::Create2DTextureAsync("Tiles Albedo",
+            "./../assets/textures/Materials/Tiles/Tiles_001_Albedo_2048x2048.png")->OnResident(
+            [cubeMaterial](cbtTexture* _texture) mutable { cubeMaterial->SetTextureAlbedo(_texture); });
+    cbtTextureBuilder::Create2DTextureAsync("Tiles Normal",
+            "./../assets/textures/Materials/Tiles/Tiles_001_Normal_2048x2048.png")->OnResident(
+            [cubeMaterial](cbtTexture* _texture) mutable { cubeMaterial->SetTextureNormal(_texture); });
+    cbtTextureBuilder::Create2DTextureAsync("Tiles Specular",
+            "./../assets/textures/Materials/Tiles/Tiles_001_Specular_2048x2048.png")->OnResident(
+            [cubeMaterial](cbtTexture* _texture) mutable { cubeMaterial->SetTextureSpecular(_texture); });
+    cbtTextureBuilder::Create2DTextureAsync("Tiles Gloss",
+            "./../assets/textures/Materials/Tiles/Tiles_001_Gloss_2048x2048.png")->OnResident(
+            [cubeMaterial](cbtTexture* _texture) mutable { cubeMaterial->SetTextureGloss(_texture); });
+    cbtTextureBuilder::Create2DTextureAsync("Tiles Displacement",
+            "./../assets/textures/Materials/Tiles/Tiles_001_Displacement_2048x2048.png")->OnResident(
+            [cubeMaterial](cbtTexture* _texture) mutable { cubeMaterial->SetTextureDisplacement(_texture); });
     cubeMaterial->SetTextureScale(cbtVector2F(3.0f, 3.0f));
 
-    cbtMaterial* windowMaterial = cbtNew cbtMaterial("Window");
+    cbtRef<cbtMaterial> windowMaterial = cbtNew cbtMaterial("Window");
     windowMaterial->SetMesh(cbtMeshBuilder::CreateQuad("Window"));
     windowMaterial->SetRenderMode(NS_CBT::CBT_RENDER_MODE_FORWARD_TRANSPARENT);
     windowMaterial->SetShader(
             cbtShaderBuilder::CreateShaderProgram("FPass", { "./../assets/shaders/GL/cbtGeometry.vert" },
                     { "./../assets/shaders/GL/cbtFPass.frag" }));
-    windowMaterial->SetTextureAlbedo(
-            cbtTextureBuilder::Create2DTexture("Window Albedo", "./../assets/textures/Test/Alpha/Window.png"));
+    cbtTextureBuilder::Create2DTextureAsync("Window Albedo",
+            "./../assets/textures/Test/Alpha/Window.png")->OnResident(
+            [windowMaterial](cbtTexture* _texture) mutable { windowMaterial->SetTextureAlbedo(_texture); });
 
     m_Light = AddEntity();
     cbtLight* lightLight = AddComponent<cbtLight>(m_Light);
@@ -69,35 +82,35 @@ GameScene::GameScene()
     lightTransform->SetLocalRotation(80.0f, cbtVector3F::LEFT);
 
     m_Floor = AddEntity();
-    AddComponent<cbtGraphics>(m_Floor)->SetMaterial(floorMaterial);
+    AddComponent<cbtGraphics>(m_Floor)->SetMaterial(floorMaterial.GetRawPointer());
     cbtTransform* floorTransform = AddComponent<cbtTransform>(m_Floor);
     floorTransform->SetLocalScale(cbtVector3F(100.0f, 100.0f, 100.0f));
     floorTransform->SetLocalRotation(-90.0f, cbtVector3F::LEFT);
     floorTransform->SetLocalPosition(cbtVector3F(0.0f, 0.0f, 0.0f));
 
-    for (cbtU32 i = 0; i < 500; ++i)
+    cbtECS cubes[500];
+    AddEntities(500, cubes);
+    AddComponents<cbtGraphics>(cubes, 500, [&cubeMaterial](cbtGraphics* _graphics, cbtU32) { _graphics->SetMaterial(cubeMaterial.GetRawPointer()); });
+    AddComponents<cbtTransform>(cubes, 500, [](cbtTransform* _transform, cbtU32)
     {
-        cbtECS cube = AddEntity();
-        AddComponent<cbtGraphics>(cube)->SetMaterial(cubeMaterial);
-        cbtTransform* cubeTransform = AddComponent<cbtTransform>(cube);
-        cubeTransform->SetLocalRotation((cbtF32)cbtMathUtil::RandomInt(0, 360), cbtVector3F::LEFT);
-        cubeTransform->SetLocalRotation((cbtF32)cbtMathUtil::RandomInt(0, 360), cbtVector3F::UP);
-        cubeTransform->SetLocalRotation((cbtF32)cbtMathUtil::RandomInt(0, 360), cbtVector3F::FORWARDS);
-        cubeTransform->SetLocalPosition(
+        _transform->SetLocalRotation((cbtF32)cbtMathUtil::RandomInt(0, 360), cbtVector3F::LEFT);
+        _transform->SetLocalRotation((cbtF32)cbtMathUtil::RandomInt(0, 360), cbtVector3F::UP);
+        _transform->SetLocalRotation((cbtF32)cbtMathUtil::RandomInt(0, 360), cbtVector3F::FORWARDS);
+        _transform->SetLocalPosition(
                 cbtVector3F((cbtF32)cbtMathUtil::RandomInt(-20, 20), (cbtF32)cbtMathUtil::RandomInt(-20, 20),
                         (cbtF32)cbtMathUtil::RandomInt(5, 20)));
-    }
+    });
 
-    for (cbtU32 i = 0; i < 50; ++i)
+    cbtECS windows[50];
+    AddEntities(50, windows);
+    AddComponents<cbtGraphics>(windows, 50, [&windowMaterial](cbtGraphics* _graphics, cbtU32) { _graphics->SetMaterial(windowMaterial.GetRawPointer()); });
+    AddComponents<cbtTransform>(windows, 50, [](cbtTransform* _transform, cbtU32)
     {
-        cbtECS window = AddEntity();
-        AddComponent<cbtGraphics>(window)->SetMaterial(windowMaterial);
-        cbtTransform* windowTransform = AddComponent<cbtTransform>(window);
-        windowTransform->SetLocalRotation(180.0f, cbtVector3F::UP);
-        windowTransform->SetLocalPosition(
+        _transform->SetLocalRotation(180.0f, cbtVector3F::UP);
+        _transform->SetLocalPosition(
                 cbtVector3F((cbtF32)cbtMathUtil::RandomInt(-20, 20), (cbtF32)cbtMathUtil::RandomInt(0, 20),
                         (cbtF32)cbtMathUtil::RandomInt(5, 20)));
-    }
+    });
 
     {
         cbtECS player = AddEntity();
@@ -111,14 +124,16 @@ GameScene::GameScene()
         playerCamera->SetSkyboxShader(
                 cbtShaderBuilder::CreateShaderProgram("Skybox", { "./../assets/shaders/GL/cbtSkybox.vert" },
                         { "./../assets/shaders/GL/cbtSkybox.frag" }));
-        playerCamera->SetSkyboxTexture(cbtTextureBuilder::CreateCubeMap("Skybox", {
+        cbtRef<cbtCamera> skyboxCamera = playerCamera;
+        cbtTextureBuilder::CreateCubeMapAsync("Skybox", {
                 "./../assets/textures/Skybox/Nebula/Skybox_Nebula_001_Left_2048x2048.png",
                 "./../assets/textures/Skybox/Nebula/Skybox_Nebula_001_Right_2048x2048.png",
                 "./../assets/textures/Skybox/Nebula/Skybox_Nebula_001_Top_2048x2048.png",
                 "./../assets/textures/Skybox/Nebula/Skybox_Nebula_001_Bottom_2048x2048.png",
                 "./../assets/textures/Skybox/Nebula/Skybox_Nebula_001_Front_2048x2048.png",
                 "./../assets/textures/Skybox/Nebula/Skybox_Nebula_001_Back_2048x2048.png"
-        }));
+        })->OnResident(
+                [skyboxCamera](cbtTexture* _texture) mutable { skyboxCamera->SetSkyboxTexture(_texture); });
         playerCamera->SetPostProcessShaders({
                 cbtShaderBuilder::CreateShaderProgram("Greyscale",
                         { "./../assets/shaders/GL/cbtScreenQuad.vert" },
@@ -149,14 +164,16 @@ GameScene::GameScene()
         playerCamera->SetSkyboxShader(
                 cbtShaderBuilder::CreateShaderProgram("Skybox", { "./../assets/shaders/GL/cbtSkybox.vert" },
                         { "./../assets/shaders/GL/cbtSkybox.frag" }));
-        playerCamera->SetSkyboxTexture(cbtTextureBuilder::CreateCubeMap("Skybox", {
+        cbtRef<cbtCamera> skyboxCamera = playerCamera;
+        cbtTextureBuilder::CreateCubeMapAsync("Skybox", {
                 "./../assets/textures/Skybox/Nebula/Skybox_Nebula_001_Left_2048x2048.png",
                 "./../assets/textures/Skybox/Nebula/Skybox_Nebula_001_Right_2048x2048.png",
                 "./../assets/textures/Skybox/Nebula/Skybox_Nebula_001_Top_2048x2048.png",
                 "./../assets/textures/Skybox/Nebula/Skybox_Nebula_001_Bottom_2048x2048.png",
                 "./../assets/textures/Skybox/Nebula/Skybox_Nebula_001_Front_2048x2048.png",
                 "./../assets/textures/Skybox/Nebula/Skybox_Nebula_001_Back_2048x2048.png"
-        }));
+        })->OnResident(
+                [skyboxCamera](cbtTexture* _texture) mutable { skyboxCamera->SetSkyboxTexture(_texture); });
     }
 }
 